@@ -21,6 +21,14 @@ Communication protocols supported:
   --protocol modbus   Simulated Modbus holding-register layout via TCP
   --protocol can      Simulated CAN frame stream via TCP wrapper
 
+Wire formats:
+  --format json       Line-delimited JSON (default)
+  --format binary     Compact binary health frames (health_frame.py); APCU
+                      telemetry is still sent as a small JSON message
+  --tcp-framing length
+                      Prefix every TCP frame with a u32 little-endian length
+                      (matches protocol_config "framing": "length_prefixed")
+
 Message formats sent to UnifiedApp MessageServer:
   1. Component-level health:  { component_id, color, size }
   2. Subsystem health map:    { ..., subsystem_health: {...} }
@@ -47,6 +55,8 @@ import math
 import struct
 import threading
 
+from health_frame import BinaryHealthEncoder, ThroughputMeter
+
 # ──────────────────────────────────────────────────────────────────────────────
 #  Configuration constants
 # ──────────────────────────────────────────────────────────────────────────────
@@ -441,21 +451,22 @@ class AntennaSubsystem:
 #  Protocol transport helpers
 # ──────────────────────────────────────────────────────────────────────────────
 
-def _send_tcp(sock, data: dict) -> bool:
-    """Send a JSON dict over a TCP socket (line-delimited)."""
+def _send_tcp(sock, frames: list[bytes]) -> bool:
+    """Send pre-encoded frames over a TCP socket (JSON lines / binary frames)."""
     try:
-        sock.sendall((json.dumps(data) + '\n').encode('utf-8'))
+        for frame in frames:
+            sock.sendall(frame)
         return True
     except Exception as e:
         print(f"  [TCP] Send error: {e}")
         return False
 
 
-def _send_udp(sock, host: str, port: int, data: dict) -> bool:
-    """Send a JSON dict as a UDP datagram."""
+def _send_udp(sock, host: str, port: int, frames: list[bytes]) -> bool:
+    """Send pre-encoded frames, one UDP datagram each."""
     try:
-        payload = (json.dumps(data) + '\n').encode('utf-8')
-        sock.sendto(payload, (host, port))
+        for frame in frames:
+            sock.sendto(frame, (host, port))
         return True
     except Exception as e:
         print(f"  [UDP] Send error: {e}")
@@ -517,7 +528,8 @@ class AntennaSimulator:
                  protocol: str = 'tcp', trm_count: int = DEFAULT_TRM_COUNT,
                  trm_columns: int = DEFAULT_TRM_COLUMNS, mode: str = 'nominal',
                  interval: float = 2.0, verbose: bool = True,
-                 full_trm_interval: int = 5):
+                 full_trm_interval: int = 5, wire_format: str = 'json',
+                 tcp_framing: str = 'line', channel_id: int = None):
         self.component_id = component_id
         self.host = host
         self.port = port
@@ -528,6 +540,11 @@ class AntennaSimulator:
 
         self.antenna = AntennaSubsystem(component_id, trm_count, mode)
 
+        self.wire_format = wire_format
+        self.tcp_framing = tcp_framing
+        self.encoder = BinaryHealthEncoder(component_id, channel=channel_id)
+        self.meter = ThroughputMeter()
+
         self.sock = None
         self.connected = False
 
@@ -557,11 +574,31 @@ class AntennaSimulator:
             except Exception: pass
         self.connected = False
 
+    def encode(self, data: dict) -> list[bytes]:
+        """Serialise one payload dict in the selected wire format."""
+        if self.wire_format != 'binary':
+            frames = [(json.dumps(data) + '\n').encode('utf-8')]
+        else:
+            frames = [self.encoder.encode(health=data.get('size'),
+                                          subsystem_health=data.get('subsystem_health'),
+                                          trms=data.get('trm_data'))]
+            # Telemetry has no binary section – ship it as a slim JSON message
+            if 'apcu_telemetry' in data:
+                telemetry = {"component_id": data["component_id"],
+                             "apcu_telemetry": data["apcu_telemetry"]}
+                frames.append((json.dumps(telemetry) + '\n').encode('utf-8'))
+        if self.tcp_framing == 'length' and self.protocol != 'udp':
+            frames = [struct.pack('<I', len(f)) + f for f in frames]
+        for f in frames:
+            self.meter.add(f)
+        return frames
+
     def send(self, data: dict) -> bool:
         if not self.connected:
             return False
 
         proto = self.protocol
+        data = self.encode(data)
         if proto == 'udp':
             return _send_udp(self.sock, self.host, self.port, data)
 
@@ -597,6 +634,8 @@ class AntennaSimulator:
         print(f"  Mode         : {self.antenna.mode}")
         print(f"  Interval     : {self.interval}s")
         print(f"  TRM full msg : every {self.full_trm_interval} ticks")
+        print(f"  Wire format  : {self.wire_format.upper()}")
+        print(f"  TCP framing  : {self.tcp_framing}")
         print(f"{'='*60}\n")
 
         if not self.connect():
@@ -633,7 +672,8 @@ class AntennaSimulator:
                     status = self.antenna.health_status(health)
                     print(f"  [{tick:04d}] {label}  "
                           f"Health={health:.1f}%  [{status.upper()}]  "
-                          f"Proto={self.protocol.upper()}")
+                          f"Proto={self.protocol.upper()}  "
+                          f"Bytes={self.meter.bytes}")
                     if tick % 10 == 0:
                         self.antenna.print_status()
 
@@ -643,6 +683,7 @@ class AntennaSimulator:
         except KeyboardInterrupt:
             print("\n  Shutting down...")
         finally:
+            print(f"  Sent ({self.wire_format}): {self.meter.summary()}")
             self.disconnect()
 
 
@@ -673,6 +714,9 @@ Examples:
 
   # Fast updates, quiet
   python3 antenna_subsystem_simulator.py component_1 --interval 0.5 --quiet
+
+  # Compact binary frames (compare the byte totals printed on exit with JSON)
+  python3 antenna_subsystem_simulator.py component_1 --format binary
         """
     )
     parser.add_argument('component_id',
@@ -698,6 +742,16 @@ Examples:
                         help='Update interval in seconds (default: 2.0)')
     parser.add_argument('--trm-full-interval', type=int, default=5,
                         help='Send full TRM grid every N ticks (default: 5)')
+    parser.add_argument('--format', dest='wire_format', choices=['json', 'binary'],
+                        default='json',
+                        help='Wire format: line-delimited JSON or compact binary frames '
+                             '(default: json)')
+    parser.add_argument('--tcp-framing', choices=['line', 'length'], default='line',
+                        help='TCP framing: newline-delimited or u32 length prefix '
+                             '(default: line)')
+    parser.add_argument('--channel-id', type=int, default=None,
+                        help='Binary format only: address frames by this u16 channel '
+                             'ID instead of component_id (shared listener mode)')
     parser.add_argument('--quiet', action='store_true',
                         help='Suppress verbose console output')
 
@@ -720,6 +774,9 @@ Examples:
         interval=args.interval,
         verbose=not args.quiet,
         full_trm_interval=args.trm_full_interval,
+        wire_format=args.wire_format,
+        tcp_framing=args.tcp_framing,
+        channel_id=args.channel_id,
     )
     sim.run()
 
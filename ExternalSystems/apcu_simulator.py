@@ -20,6 +20,9 @@ all subsystems visible in the APCU control interface:
 Protocol:
   Sends JSON messages over TCP (default port 12345) with both
   component-level health and detailed subsystem telemetry.
+  With --format binary, health and subsystem updates are sent as compact
+  binary health frames (see health_frame.py); the nested APCU telemetry
+  block is still sent as JSON.
 
 Usage:
   python3 apcu_simulator.py [component_id] [options]
@@ -38,6 +41,8 @@ import argparse
 import sys
 import math
 
+from health_frame import BinaryHealthEncoder, ThroughputMeter
+
 # ────────────────────────────────────────────────────────────────
 #  APCU Configuration Constants (from APCU 4 Left V1.0.0 spec)
 # ────────────────────────────────────────────────────────────────
@@ -200,7 +205,8 @@ class APCUSimulator:
     Models all subsystems shown in the APCU 4 Left display.
     """
 
-    def __init__(self, component_id, host='localhost', port=12345, mode='nominal'):
+    def __init__(self, component_id, host='localhost', port=12345, mode='nominal',
+                 wire_format='json'):
         self.component_id = component_id
         self.host = host
         self.port = port
@@ -208,6 +214,11 @@ class APCUSimulator:
         self.socket = None
         self.connected = False
 
+        # Wire format ('json' or 'binary') and byte accounting
+        self.wire_format = wire_format
+        self.encoder = BinaryHealthEncoder(component_id)
+        self.meter = ThroughputMeter()
+
         # APCU Controller state
         self.link_status = [True, True, True, True]  # Q0, Q1, Q2, Q3
         self.sequence_on = True
@@ -538,6 +549,9 @@ class APCUSimulator:
         status = self.health_status(health)
         color = self.health_colors[status]
 
+        if self.wire_format == 'binary':
+            return self._send_bytes(self.encoder.encode(health=health), "Health")
+
         message = {
             "component_id": self.component_id,
             "color": color,
@@ -548,6 +562,10 @@ class APCUSimulator:
     def send_subsystem_update(self):
         """Send per-subsystem health updates."""
         sub_map = self.subsystem_health_map()
+        if self.wire_format == 'binary':
+            # One interned frame replaces a JSON message per subsystem
+            return self._send_bytes(self.encoder.encode(subsystem_health=sub_map),
+                                    "Subsystems")
         for sub_name, sub_health in sub_map.items():
             status = self.health_status(sub_health)
             color = self.health_colors[status]
@@ -564,14 +582,24 @@ class APCUSimulator:
     def send_full_telemetry(self):
         """Send the complete APCU telemetry payload."""
         payload = self.full_telemetry()
+        if self.wire_format == 'binary':
+            frame = self.encoder.encode(health=payload["size"],
+                                        subsystem_health=payload["subsystem_health"])
+            if not self._send_bytes(frame, "Full Telemetry"):
+                return False
+            payload = {"component_id": self.component_id,
+                       "apcu_telemetry": payload["apcu_telemetry"]}
         return self._send_json(payload, "Full Telemetry")
 
     def _send_json(self, obj, label=""):
+        return self._send_bytes((json.dumps(obj) + '\n').encode('utf-8'), label)
+
+    def _send_bytes(self, data, label=""):
         if not self.connected:
             return False
         try:
-            data = json.dumps(obj) + '\n'
-            self.socket.sendall(data.encode('utf-8'))
+            self.socket.sendall(data)
+            self.meter.add(data)
             return True
         except Exception as e:
             print(f"[APCU {self.component_id}] Send failed ({label}): {e}")
@@ -641,6 +669,7 @@ class APCUSimulator:
         print(f"  Mode         : {self.mode}")
         print(f"  Interval     : {interval}s")
         print(f"  Telemetry    : {'Full' if send_telemetry else 'Basic'}")
+        print(f"  Wire format  : {self.wire_format.upper()}")
         print(f"{'='*60}\n")
 
         if not self.connect():
@@ -679,6 +708,7 @@ class APCUSimulator:
         except KeyboardInterrupt:
             print(f"\n  Shutting down APCU simulator...")
         finally:
+            print(f"  Sent ({self.wire_format}): {self.meter.summary()}")
             self.disconnect()
 
 
@@ -703,6 +733,9 @@ Examples:
 
   # Full telemetry mode
   python3 apcu_simulator.py antenna_1 --telemetry
+
+  # Compact binary health frames
+  python3 apcu_simulator.py antenna_1 --format binary
         """
     )
     parser.add_argument('component_id',
@@ -722,12 +755,16 @@ Examples:
                         help='Send full APCU telemetry (default: enabled)')
     parser.add_argument('--no-telemetry', action='store_true',
                         help='Disable full telemetry, send basic health only')
+    parser.add_argument('--format', dest='wire_format', choices=['json', 'binary'],
+                        default='json',
+                        help='Wire format: JSON lines or compact binary frames (default: json)')
 
     args = parser.parse_args()
 
     send_telem = not args.no_telemetry
 
-    sim = APCUSimulator(args.component_id, args.host, args.port, args.mode)
+    sim = APCUSimulator(args.component_id, args.host, args.port, args.mode,
+                        wire_format=args.wire_format)
     sim.run(interval=args.interval, verbose=not args.quiet, send_telemetry=send_telem)
 
 
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""
+Binary Health Frame Encoder (version 1)
+========================================
+
+Encodes health updates in the compact binary format understood by the
+UnifiedApp MessageServer alongside the JSON protocol (see
+UnifiedApp/binaryhealthframe.h for the authoritative layout).
+
+  Header (8 bytes, little-endian)
+    u8  magic   0xB5
+    u8  version 0x01
+    u8  flags   bit0 DICT | bit1 COMPONENT | bit2 SUBSYSTEMS | bit3 TRM
+                | bit4 CHANNEL
+    u8  reserved
+    u32 total frame length (header included)
+
+  Body
+    address      : component_id as u8 len + UTF-8, or, with CHANNEL,
+                   a u16 channel ID the receiver maps to a component
+                   (MessageServer shared listener mode, "channel_id" config)
+    DICT         : u8 n, n x (u8 idx, u8 len, UTF-8 name)
+    COMPONENT    : u16 health*10, u8 status code
+    SUBSYSTEMS   : u8 n, n x (u8 idx, u16 health*10)
+    TRM          : u16 n, n x 12-byte records
+                   (u16 id, u16 health*10, u16 volts*100, u16 amps*1000,
+                    u8 quadrant, u8 channel, u8 flags, u8 reserved)
+
+Subsystem names are interned: each name gets a one-byte index the first
+time it is seen, and the dictionary is re-sent every `dict_interval` frames
+so a restarted receiver can re-learn it.
+
+Frames are self-delimiting, so they can be written straight onto the same
+TCP stream as line-delimited JSON, or sent as one UDP datagram each.
+"""
+
+import struct
+
+MAGIC = 0xB5
+VERSION = 0x01
+
+FLAG_DICT = 0x01
+FLAG_COMPONENT = 0x02
+FLAG_SUBSYSTEMS = 0x04
+FLAG_TRM = 0x08
+FLAG_CHANNEL = 0x10
+
+STATUS_CODES = {
+    'operational': 0,
+    'warning':     1,
+    'degraded':    2,
+    'critical':    3,
+    'offline':     4,
+}
+
+_TRM_RECORD = struct.Struct('<HHHHBBBB')
+
+
+def _u16(value: float, scale: float) -> int:
+    return max(0, min(0xFFFF, int(round(value * scale))))
+
+
+def status_for_health(health: float) -> str:
+    if health >= 90: return 'operational'
+    if health >= 70: return 'warning'
+    if health >= 40: return 'degraded'
+    if health >= 10: return 'critical'
+    return 'offline'
+
+
+class BinaryHealthEncoder:
+    """Stateful encoder for one component (owns its subsystem dictionary)."""
+
+    def __init__(self, component_id: str, dict_interval: int = 20,
+                 channel: int = None):
+        if channel is not None:
+            if not 0 <= channel <= 0xFFFF:
+                raise ValueError("channel must fit in a u16")
+            self._address = struct.pack('<H', channel)
+            self._address_flag = FLAG_CHANNEL
+        else:
+            cid = component_id.encode('utf-8')
+            if len(cid) > 255:
+                raise ValueError("component_id longer than 255 bytes")
+            self._address = bytes([len(cid)]) + cid
+            self._address_flag = 0
+        self._dict_interval = max(1, dict_interval)
+        self._indices: dict[str, int] = {}
+        self._frames = 0
+        self._dict_dirty = True
+
+    def _intern(self, name: str) -> int:
+        idx = self._indices.get(name)
+        if idx is None:
+            if len(self._indices) >= 256:
+                raise ValueError("more than 256 subsystem names")
+            idx = len(self._indices)
+            self._indices[name] = idx
+            self._dict_dirty = True
+        return idx
+
+    def encode(self, health: float = None, subsystem_health: dict = None,
+               trms: list = None) -> bytes:
+        """
+        Build one frame.
+
+        health           : overall component health 0-100 (None to omit)
+        subsystem_health : {name: health} (None to omit)
+        trms             : list of TRM dicts with the same keys as the JSON
+                           trm_data entries (None to omit)
+        """
+        flags = self._address_flag
+        sections = []
+
+        sub_items = []
+        if subsystem_health:
+            sub_items = [(self._intern(n), v) for n, v in subsystem_health.items()]
+
+        send_dict = self._dict_dirty or self._frames % self._dict_interval == 0
+        if send_dict and self._indices:
+            flags |= FLAG_DICT
+            parts = [bytes([len(self._indices)])]
+            for name, idx in self._indices.items():
+                raw = name.encode('utf-8')[:255]
+                parts.append(bytes([idx, len(raw)]) + raw)
+            sections.append(b''.join(parts))
+            self._dict_dirty = False
+
+        if health is not None:
+            flags |= FLAG_COMPONENT
+            code = STATUS_CODES[status_for_health(health)]
+            sections.append(struct.pack('<HB', _u16(health, 10), code))
+
+        if sub_items:
+            flags |= FLAG_SUBSYSTEMS
+            parts = [bytes([len(sub_items)])]
+            for idx, v in sub_items:
+                parts.append(struct.pack('<BH', idx, _u16(v, 10)))
+            sections.append(b''.join(parts))
+
+        if trms:
+            flags |= FLAG_TRM
+            parts = [struct.pack('<H', len(trms))]
+            for t in trms:
+                tf = (0x01 if t.get('on', True) else 0) \
+                   | (0x02 if t.get('trip', 'Normal') != 'Normal' else 0) \
+                   | (0x04 if t.get('bit', 'Normal') != 'Normal' else 0)
+                q = t.get('quadrant', -1)
+                ch = t.get('channel', -1)
+                parts.append(_TRM_RECORD.pack(
+                    t['id'] & 0xFFFF,
+                    _u16(t.get('health', 0.0), 10),
+                    _u16(t.get('voltage', 0.0), 100),
+                    _u16(t.get('current', 0.0), 1000),
+                    0xFF if q < 0 else q & 0xFF,
+                    0xFF if ch < 0 else ch & 0xFF,
+                    tf, 0))
+            sections.append(b''.join(parts))
+
+        body = self._address + b''.join(sections)
+        self._frames += 1
+        header = struct.pack('<BBBBI', MAGIC, VERSION, flags, 0, 8 + len(body))
+        return header + body
+
+
+class ThroughputMeter:
+    """Tracks bytes/frames sent so JSON vs binary runs can be compared."""
+
+    def __init__(self):
+        self.frames = 0
+        self.bytes = 0
+
+    def add(self, payload: bytes):
+        self.frames += 1
+        self.bytes += len(payload)
+
+    def summary(self) -> str:
+        avg = self.bytes / self.frames if self.frames else 0
+        return f"{self.frames} frames, {self.bytes} bytes, {avg:.0f} B/frame avg"
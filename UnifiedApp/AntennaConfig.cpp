@@ -0,0 +1,158 @@
+#include "AntennaConfig.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCoreApplication>
+#include <QThread>
+#include <QSet>
+#include <QDebug>
+
+// ── AntennaConfig ────────────────────────────────────────────────────────────
+static float readFloat(const QJsonObject &o, const char *key, float def)
+{
+    return float(o.value(QLatin1String(key)).toDouble(def));
+}
+
+static ElementThresholds thresholdsFromJson(const QJsonObject &o, const ElementThresholds &def)
+{
+    ElementThresholds th;
+    th.powerWarn   = readFloat(o, "power_warn",   def.powerWarn);
+    th.powerCrit   = readFloat(o, "power_crit",   def.powerCrit);
+    th.tempWarn    = readFloat(o, "temp_warn",    def.tempWarn);
+    th.tempCrit    = readFloat(o, "temp_crit",    def.tempCrit);
+    th.currentWarn = readFloat(o, "current_warn", def.currentWarn);
+    th.currentCrit = readFloat(o, "current_crit", def.currentCrit);
+    return th;
+}
+
+AntennaConfig AntennaConfig::fromJson(const QJsonObject &o, const AntennaConfig &defaults)
+{
+    AntennaConfig cfg = defaults;
+    cfg.name                = o["name"].toString(defaults.name);
+    cfg.quadrants           = o["quadrants"].toInt(defaults.quadrants);
+    cfg.elementsPerQuadrant = o["elements_per_quadrant"].toInt(defaults.elementsPerQuadrant);
+    cfg.elementsPerCluster  = o["elements_per_cluster"].toInt(defaults.elementsPerCluster);
+    cfg.udpPort             = o["udp_port"].toInt(defaults.udpPort);
+    cfg.udpRcvBufBytes      = o["udp_rcvbuf_bytes"].toInt(defaults.udpRcvBufBytes);
+    cfg.maxDatagramBytes    = o["max_datagram_bytes"].toInt(defaults.maxDatagramBytes);
+    cfg.staleAfterMs        = o["stale_after_ms"].toInt(defaults.staleAfterMs);
+    cfg.historySampleMs     = o["history_sample_ms"].toInt(defaults.historySampleMs);
+    cfg.historyDepth        = o["history_depth"].toInt(defaults.historyDepth);
+    cfg.notifyIntervalMs    = o["notify_interval_ms"].toInt(defaults.notifyIntervalMs);
+    cfg.ingestThread        = o["ingest_thread"].toBool(defaults.ingestThread);
+    cfg.cmdHost             = o["cmd_host"].toString(defaults.cmdHost);
+    cfg.cmdPort             = o["cmd_port"].toInt(defaults.cmdPort);
+    if (o.contains("thresholds"))
+        cfg.thresholds = thresholdsFromJson(o["thresholds"].toObject(), defaults.thresholds);
+    return cfg;
+}
+
+// ── AntennaSiteConfig ────────────────────────────────────────────────────────
+// The monitor view lays quadrants out as a fixed 2 × 2 (NW, NE, SW, SE);
+// element indices are 16-bit on the wire
+static QString shapeError(const AntennaConfig &cfg)
+{
+    if (cfg.quadrants != 4)
+        return "quadrants must be 4 (the monitor view is a 2 x 2 quadrant layout)";
+    if (cfg.elementsPerQuadrant < 1 || cfg.elementsPerQuadrant > 65535)
+        return "elements_per_quadrant must be 1-65535";
+    if (cfg.elementsPerCluster < 1 || cfg.elementsPerQuadrant % cfg.elementsPerCluster != 0)
+        return "elements_per_cluster must divide elements_per_quadrant";
+    if (cfg.udpPort < 1 || cfg.udpPort > 65535 || cfg.ackPort() > 65535)
+        return "udp_port / cmd_port out of range";
+    const ElementThresholds &th = cfg.thresholds;
+    if (th.powerCrit > th.powerWarn || th.tempWarn > th.tempCrit || th.currentWarn > th.currentCrit)
+        return "warning thresholds must lie on the healthy side of the critical ones";
+    return QString();
+}
+
+AntennaSiteConfig AntennaSiteConfig::fromJson(const QJsonObject &root)
+{
+    AntennaSiteConfig site;
+    site.ingestThreads = qMax(0, root["ingest_threads"].toInt(0));
+
+    const AntennaConfig defaults = AntennaConfig::fromJson(root["defaults"].toObject());
+    const QJsonArray arr = root["antennas"].toArray();
+    QSet<int> ports;
+    for (int i = 0; i < arr.size(); ++i) {
+        AntennaConfig cfg = AntennaConfig::fromJson(arr[i].toObject(), defaults);
+        if (cfg.name.isEmpty()) cfg.name = QString("Antenna %1").arg(i + 1);
+
+        const QString err = shapeError(cfg);
+        if (!err.isEmpty()) {
+            qWarning() << "[AntennaConfig] Skipping" << cfg.name << "-" << err;
+            continue;
+        }
+        // Data and ACK ports are bound by this process, so they must be unique
+        if (ports.contains(cfg.udpPort) || ports.contains(cfg.ackPort()) || cfg.udpPort == cfg.ackPort()) {
+            qWarning() << "[AntennaConfig] Skipping" << cfg.name << "- port" << cfg.udpPort
+                       << "or ACK port" << cfg.ackPort() << "already in use";
+            continue;
+        }
+        ports.insert(cfg.udpPort);
+        ports.insert(cfg.ackPort());
+        site.antennas.append(cfg);
+    }
+    return site;
+}
+
+QString AntennaSiteConfig::findConfigFile()
+{
+    // Same search order as ComponentRegistry::findConfigFile
+    QStringList searchPaths;
+    searchPaths << "antennas.json";
+    searchPaths << "../antennas.json";
+    searchPaths << "UnifiedApp/antennas.json";
+    searchPaths << "../UnifiedApp/antennas.json";
+    searchPaths << "/workspace/UnifiedApp/antennas.json";
+
+    if (!QCoreApplication::applicationDirPath().isEmpty())
+        searchPaths << QCoreApplication::applicationDirPath() + "/antennas.json";
+
+    for (const QString &path : searchPaths) {
+        if (QFileInfo::exists(path))
+            return path;
+    }
+    return ":/config/antennas.json";   // built-in copy
+}
+
+AntennaSiteConfig AntennaSiteConfig::load(const QString &filePath)
+{
+    const QString path = filePath.isEmpty() ? findConfigFile() : filePath;
+
+    AntennaSiteConfig site;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "[AntennaConfig] Could not open config file:" << path;
+    } else {
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+        if (doc.isObject())
+            site = fromJson(doc.object());
+        else
+            qWarning() << "[AntennaConfig] Invalid JSON in config file:" << path;
+    }
+    site.sourcePath = path;
+
+    // Never come up without an antenna: one with the built-in defaults
+    if (site.antennas.isEmpty()) {
+        qWarning() << "[AntennaConfig] No usable antenna definitions; using a single default antenna";
+        AntennaConfig cfg;
+        cfg.name = "Antenna A";
+        site.antennas.append(cfg);
+    }
+
+    qDebug() << "[AntennaConfig] Loaded" << site.antennas.size() << "antennas from" << path;
+    return site;
+}
+
+int AntennaSiteConfig::ingestThreadCount() const
+{
+    int threaded = 0;
+    for (const AntennaConfig &cfg : antennas)
+        if (cfg.ingestThread) ++threaded;
+    if (threaded == 0) return 0;
+    const int wanted = ingestThreads > 0 ? ingestThreads : qMax(1, QThread::idealThreadCount());
+    return qMin(wanted, threaded);
+}
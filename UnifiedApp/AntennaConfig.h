@@ -1,5 +1,18 @@
 #pragma once
 #include <QString>
+#include <QVector>
+
+class QJsonObject;
+
+// Status limits per parameter (see ElementHealth)
+struct ElementThresholds {
+    float powerWarn   = 43.0f;    // dBm — WARNING below
+    float powerCrit   = 40.0f;    // dBm — CRITICAL below
+    float tempWarn    = 45.0f;    // °C  — WARNING above
+    float tempCrit    = 50.0f;    // °C  — CRITICAL above
+    float currentWarn = 1.8f;     // A   — WARNING above
+    float currentCrit = 2.0f;     // A   — CRITICAL above
+};
 
 struct AntennaConfig {
     QString name;
@@ -7,7 +20,52 @@ struct AntennaConfig {
     int     elementsPerQuadrant  = 256;
     int     elementsPerCluster   = 16;
     int     udpPort              = 5005;
+    int     udpRcvBufBytes       = 4 * 1024 * 1024;   // requested SO_RCVBUF for the receiver
+    int     maxDatagramBytes     = 1472;              // sender limit; larger frames go out as 0x15 chunks
+    int     staleAfterMs         = 5000;              // demote elements not refreshed for this long to NoData (0 = never)
+    int     historySampleMs      = 1000;              // per-element history sample period
+    int     historyDepth         = 600;               // samples kept per element (10 min at 1 Hz)
+    int     notifyIntervalMs     = 16;                // change signals coalesced per frame (0 = on every write)
+    bool    ingestThread         = true;              // decode and model writes off the GUI thread
+    QString cmdHost              = "127.0.0.1";       // command destination
+    int     cmdPort              = 0;                 // 0 = udpPort; ACKs come back on cmdPort + 1
+    ElementThresholds thresholds;
 
     int clustersPerQuadrant() const { return elementsPerQuadrant / elementsPerCluster; }
     int totalElements()       const { return quadrants * elementsPerQuadrant; }
+    int commandPort()         const { return cmdPort > 0 ? cmdPort : udpPort; }
+    int ackPort()             const { return commandPort() + 1; }
+
+    // Keys missing from o keep the value in defaults
+    static AntennaConfig fromJson(const QJsonObject &o, const AntennaConfig &defaults = AntennaConfig());
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// AntennaSiteConfig — the antennas monitored by RadarAntennaWidget
+//
+// Loaded from antennas.json (searched next to the executable and the usual
+// source locations, like components.json), falling back to the copy built
+// into the resources:
+//
+//   { "ingest_threads": 0,
+//     "defaults": { ...AntennaConfig keys... },
+//     "antennas": [ { "name": "Antenna A", "quadrants": 4, "elements_per_quadrant": 256,
+//                     "udp_port": 5005, "thresholds": { "power_warn": 43, ... } }, ... ] }
+//
+// "defaults" applies to every antenna before its own keys. Arrays may differ
+// in elements per quadrant, but "quadrants" must be 4: RadarAntennaView.qml
+// draws a fixed 2 × 2 quadrant layout. Antennas with an invalid shape or a
+// port already taken by an earlier antenna are skipped with a warning.
+// ─────────────────────────────────────────────────────────────────────────────
+struct AntennaSiteConfig {
+    QVector<AntennaConfig> antennas;
+    int     ingestThreads = 0;    // shared ingest threads (0 = one per antenna up to the core count)
+    QString sourcePath;           // file the definitions came from
+
+    static AntennaSiteConfig load(const QString &filePath = QString());
+    static AntennaSiteConfig fromJson(const QJsonObject &root);
+    static QString findConfigFile();
+
+    // Threads to start for ingestThreads and the antennas that use one
+    int ingestThreadCount() const;
 };
@@ -3,14 +3,14 @@
 #include <QNetworkDatagram>
 
 CommandSender::CommandSender(const AntennaConfig &cfg, QObject *parent)
-    : QObject(parent), m_cfg(cfg)
+    : QObject(parent), m_cfg(cfg), m_cmdHost(cfg.cmdHost)
 {
     m_txSocket  = new QUdpSocket(this);
     m_ackSocket = new QUdpSocket(this);
 
-    // Listen for ACKs on udpPort + 1
+    // Listen for ACKs on cmdPort + 1
     m_ackSocket->bind(QHostAddress::AnyIPv4,
-                      static_cast<quint16>(m_cfg.udpPort + 1),
+                      static_cast<quint16>(m_cfg.ackPort()),
                       QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint);
     connect(m_ackSocket, &QUdpSocket::readyRead, this, &CommandSender::onAckReceived);
 }
@@ -35,8 +35,8 @@ bool CommandSender::sendCommand(int command, int quadrant, int elementId)
     for (int i = 0; i < 5; ++i) cs ^= static_cast<quint8>(pkt[i]);
     pkt[5] = static_cast<char>(cs);
 
-    qint64 sent = m_txSocket->writeDatagram(pkt, QHostAddress::LocalHost,
-                                             static_cast<quint16>(m_cfg.udpPort));
+    qint64 sent = m_txSocket->writeDatagram(pkt, m_cmdHost,
+                                             static_cast<quint16>(m_cfg.commandPort()));
     if (sent != pkt.size()) return false;
 
     ++m_pending;
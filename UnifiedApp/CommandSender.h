@@ -1,6 +1,7 @@
 #pragma once
 #include <QObject>
 #include <QUdpSocket>
+#include <QHostAddress>
 #include <QDateTime>
 #include <QVariantList>
 #include <QVariantMap>
@@ -20,6 +21,7 @@
  *   elem_lo / elem_hi = element index (little-endian uint16)
  *   checksum = XOR of bytes 0-4
  *
+ * Commands go to AntennaConfig cmdHost:cmdPort (udpPort if unset).
  * Response (ACK) comes back on ackPort = cmdPort + 1:
  *   [0xCA][cmd][quad][elem_lo][elem_hi][status]
  *   status: 0x00=OK, 0x01=BUSY, 0x02=ERROR
@@ -62,6 +64,7 @@ private:
     void appendLog(int cmd, int quad, int elem, int status, const QString &ts);
 
     AntennaConfig  m_cfg;
+    QHostAddress   m_cmdHost;
     QUdpSocket    *m_txSocket  = nullptr;
     QUdpSocket    *m_ackSocket = nullptr;
     QVariantList   m_log;
@@ -0,0 +1,288 @@
+#include "ElementGridItem.h"
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGVertexColorMaterial>
+#include <QSGRendererInterface>
+
+// Two triangles per cell: (x0,y0) (x1,y0) (x0,y1) / (x0,y1) (x1,y0) (x1,y1)
+static const int kCellVertices = 6;
+
+static void setCellColor(QSGGeometry::ColoredPoint2D *v, QRgb c)
+{
+    for (int k = 0; k < kCellVertices; ++k) {
+        v[k].r = uchar(qRed(c));
+        v[k].g = uchar(qGreen(c));
+        v[k].b = uchar(qBlue(c));
+        v[k].a = uchar(qAlpha(c));
+    }
+}
+
+// ── Construction ─────────────────────────────────────────────────────────────
+ElementGridItem::ElementGridItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    // Dark theme defaults (RadarAntennaView.qml binds its own palette)
+    setColor(0, QColor("#2a3e58"));
+    setColor(1, QColor("#00e87a"));
+    setColor(2, QColor("#ffb700"));
+    setColor(3, QColor("#ff3a3a"));
+}
+
+// ── Properties ───────────────────────────────────────────────────────────────
+void ElementGridItem::setModel(RadarModel *model)
+{
+    if (m_model == model) return;
+    if (m_model) disconnect(m_model, nullptr, this, nullptr);
+    m_model = model;
+    if (m_model)
+        connect(m_model, &RadarModel::quadrantUpdated, this, &ElementGridItem::onQuadrantUpdated);
+    invalidate(true);
+    emit modelChanged();
+}
+
+void ElementGridItem::setQuadrant(int q)
+{
+    if (m_quadrant == q) return;
+    m_quadrant = q;
+    invalidate(true);
+    emit layoutChanged();
+}
+
+void ElementGridItem::setColumns(int columns)
+{
+    columns = qMax(1, columns);
+    if (m_columns == columns) return;
+    m_columns = columns;
+    invalidate(true);
+    emit layoutChanged();
+}
+
+void ElementGridItem::setMetric(Metric metric)
+{
+    if (m_metric == metric) return;
+    m_metric = metric;
+    invalidate(false);
+    emit metricChanged();
+}
+
+void ElementGridItem::setColor(int status, const QColor &c)
+{
+    if (m_colors[status] == c) return;
+    m_colors[status] = c;
+    m_rgba[status]   = qPremultiply(c.rgba());
+    invalidate(false);
+    emit paletteChanged();
+}
+
+// Colours only: forget what was drawn so every shown cell is rewritten
+void ElementGridItem::invalidate(bool positions)
+{
+    if (positions) m_rebuild = true;
+    m_class.fill(0xFF);
+    m_dirtyQuads.fill(1);
+    update();
+}
+
+void ElementGridItem::onQuadrantUpdated(int q)
+{
+    if (q < 0 || q >= m_dirtyQuads.size()) return;
+    m_dirtyQuads[q] = 1;
+    if (showsQuadrant(q)) update();
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+void ElementGridItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+#else
+void ElementGridItem::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+#endif
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_rebuild = true;
+        update();
+    }
+}
+
+// ── Layout ───────────────────────────────────────────────────────────────────
+ElementGridItem::Layout ElementGridItem::layout() const
+{
+    Layout l;
+    if (!m_model) return l;
+    const int Q = m_model->quadrantCount();
+    l.tilesX = m_quadrant < 0 ? qMin(2, Q) : 1;
+    l.tilesY = m_quadrant < 0 ? (Q + 1) / 2 : 1;
+    l.rows   = (m_model->elementsPerQuadrant() + m_columns - 1) / m_columns;
+    if (l.tilesX > 0 && l.rows > 0) {
+        l.cellW = float(width())  / (l.tilesX * m_columns);
+        l.cellH = float(height()) / (l.tilesY * l.rows);
+    }
+    return l;
+}
+
+QRectF ElementGridItem::cellRect(int gid) const
+{
+    if (!m_model || gid < 0 || gid >= m_model->totalElements()) return QRectF();
+    const int epq = m_model->elementsPerQuadrant();
+    const int q = gid / epq, e = gid % epq;
+    if (!showsQuadrant(q)) return QRectF();
+    const Layout l = layout();
+    const int t = tileOf(q);
+    return QRectF(((t % 2) * m_columns + e % m_columns) * l.cellW,
+                  ((t / 2) * l.rows    + e / m_columns) * l.cellH,
+                  l.cellW, l.cellH);
+}
+
+int ElementGridItem::elementAt(qreal x, qreal y) const
+{
+    const Layout l = layout();
+    if (!m_model || l.cellW <= 0 || l.cellH <= 0 || x < 0 || y < 0) return -1;
+    const int col = int(x / l.cellW), row = int(y / l.cellH);
+    if (col >= l.tilesX * m_columns || row >= l.tilesY * l.rows) return -1;
+    const int q = m_quadrant < 0 ? (row / l.rows) * 2 + col / m_columns : m_quadrant;
+    const int e = (row % l.rows) * m_columns + col % m_columns;
+    const int epq = m_model->elementsPerQuadrant();
+    if (q >= m_model->quadrantCount() || e >= epq) return -1;
+    return q * epq + e;
+}
+
+// ── Scene graph ──────────────────────────────────────────────────────────────
+template <typename F>
+void ElementGridItem::classifyQuadrant(int q, F changed)
+{
+    const int epq  = m_model->elementsPerQuadrant();
+    const int base = q * epq;
+    const quint8 *S = m_model->statusData()  + base;
+    const float  *P = m_model->powerData()   + base;
+    const float  *T = m_model->tempData()    + base;
+    const float  *C = m_model->currentData() + base;
+    quint8 *drawn   = m_class.data() + base;
+    const ElementThresholds &th = m_model->thresholds();
+
+    for (int e = 0; e < epq; ++e) {
+        quint8 c;
+        switch (m_metric) {
+            case Power:       c = quint8(ElementHealth::powerStatus(P[e], th));   break;
+            case Temperature: c = quint8(ElementHealth::tempStatus(T[e], th));    break;
+            case Current:     c = quint8(ElementHealth::currentStatus(C[e], th)); break;
+            default:          c = S[e];                                       break;
+        }
+        if (c == drawn[e]) continue;
+        drawn[e] = c;
+        changed(e, c);
+    }
+}
+
+// Positions for every cell of quadrant q; colours are filled in by the caller
+QSGGeometryNode *ElementGridItem::buildTile(int q, const Layout &l) const
+{
+    const int epq = m_model->elementsPerQuadrant();
+    auto *geo = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), epq * kCellVertices);
+    geo->setDrawingMode(QSGGeometry::DrawTriangles);
+    geo->setVertexDataPattern(QSGGeometry::DynamicPattern);
+
+    // Same gap as the old Canvas grid; none once cells are a few pixels wide
+    const float minSide = qMin(l.cellW, l.cellH);
+    const float gap     = minSide >= 4.0f ? qMax(0.5f, minSide * 0.08f) : 0.0f;
+    const int   t       = tileOf(q);
+    const int   col0    = (t % 2) * m_columns;
+    const int   row0    = (t / 2) * l.rows;
+
+    QSGGeometry::ColoredPoint2D *v = geo->vertexDataAsColoredPoint2D();
+    for (int e = 0; e < epq; ++e, v += kCellVertices) {
+        const float x0 = (col0 + e % m_columns) * l.cellW + gap;
+        const float y0 = (row0 + e / m_columns) * l.cellH + gap;
+        const float x1 = x0 + l.cellW - 2 * gap;
+        const float y1 = y0 + l.cellH - 2 * gap;
+        v[0].set(x0, y0, 0, 0, 0, 0);
+        v[1].set(x1, y0, 0, 0, 0, 0);
+        v[2].set(x0, y1, 0, 0, 0, 0);
+        v[3].set(x0, y1, 0, 0, 0, 0);
+        v[4].set(x1, y0, 0, 0, 0, 0);
+        v[5].set(x1, y1, 0, 0, 0, 0);
+    }
+
+    auto *node = new QSGGeometryNode;
+    node->setGeometry(geo);
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+QSGNode *ElementGridItem::updatePaintNode(QSGNode *old, UpdatePaintNodeData *)
+{
+    const Layout l = layout();
+    if (!m_model || l.cellW <= 0 || l.cellH <= 0) {
+        delete old;
+        m_rebuild = true;
+        return nullptr;
+    }
+    const int Q = m_model->quadrantCount();
+    const bool software =
+        window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software;
+
+    QSGNode *root = old ? old : new QSGNode;
+    if (m_rebuild || !old) {
+        while (QSGNode *n = root->firstChild()) {
+            root->removeChildNode(n);
+            delete n;
+        }
+        m_class.fill(0xFF, m_model->totalElements());
+        m_dirtyQuads.fill(1, Q);
+        if (software) {
+            m_image = QImage(l.tilesX * m_columns, l.tilesY * l.rows,
+                             QImage::Format_ARGB32_Premultiplied);
+            m_image.fill(Qt::transparent);
+            QSGImageNode *img = window()->createImageNode();
+            img->setFiltering(QSGTexture::Nearest);
+            img->setOwnsTexture(true);
+            root->appendChildNode(img);
+        } else {
+            for (int q = 0; q < Q; ++q)
+                if (showsQuadrant(q)) root->appendChildNode(buildTile(q, l));
+        }
+        m_rebuild = false;
+    }
+
+    if (software) {
+        auto *img = static_cast<QSGImageNode*>(root->firstChild());
+        bool changed = false;
+        for (int q = 0; q < Q; ++q) {
+            if (!showsQuadrant(q) || !m_dirtyQuads[q]) continue;
+            m_dirtyQuads[q] = 0;
+            const int t = tileOf(q);
+            const int col0 = (t % 2) * m_columns, row0 = (t / 2) * l.rows;
+            classifyQuadrant(q, [&](int e, quint8 c) {
+                auto *line = reinterpret_cast<QRgb*>(m_image.scanLine(row0 + e / m_columns));
+                line[col0 + e % m_columns] = m_rgba[c];
+                changed = true;
+            });
+        }
+        if (changed || !img->texture()) {
+            img->setTexture(window()->createTextureFromImage(m_image));
+            img->setSourceRect(m_image.rect());
+        }
+        img->setRect(boundingRect());
+        return root;
+    }
+
+    QSGNode *n = root->firstChild();
+    for (int q = 0; q < Q; ++q) {
+        if (!showsQuadrant(q)) continue;
+        auto *tile = static_cast<QSGGeometryNode*>(n);
+        n = n->nextSibling();
+        if (!m_dirtyQuads[q]) continue;
+        m_dirtyQuads[q] = 0;
+        QSGGeometry::ColoredPoint2D *v = tile->geometry()->vertexDataAsColoredPoint2D();
+        bool changed = false;
+        classifyQuadrant(q, [&](int e, quint8 c) {
+            setCellColor(v + e * kCellVertices, m_rgba[c]);
+            changed = true;
+        });
+        if (changed) tile->markDirty(QSGNode::DirtyGeometry);
+    }
+    return root;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <QQuickItem>
+#include <QPointer>
+#include <QColor>
+#include <QImage>
+#include <QVector>
+#include "RadarModel.h"
+
+class QSGGeometryNode;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ElementGridItem — scene-graph element grid (QML: ElementGrid)
+//
+// One coloured cell per element, read straight from the packed arrays of
+// RadarModel's current snapshot. The layout is the full-view one: quadrant
+// tiles two to a row, `columns` elements per tile row; quadrant ≥ 0 shows
+// that tile alone. Cells are coloured by overall status or by one
+// parameter's status.
+//
+// Each tile is its own QSGGeometryNode of vertex-coloured triangles. The
+// model's quadrantUpdated(q) only flags tile q; at the next sync that tile's
+// cells are re-classified, only cells whose colour class changed get their
+// vertices rewritten, and only that tile's geometry is re-uploaded. Cell
+// positions are rebuilt on resize / layout changes only.
+//
+// The software backend does not draw custom geometry: there the grid is a
+// QImage with one pixel per cell (same per-cell updates) shown through a
+// nearest-filtered image node, without the gaps between cells.
+// ─────────────────────────────────────────────────────────────────────────────
+class ElementGridItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(RadarModel *model READ model    WRITE setModel    NOTIFY modelChanged)
+    Q_PROPERTY(int    quadrant   READ quadrant WRITE setQuadrant NOTIFY layoutChanged)   // -1 = all
+    Q_PROPERTY(int    columns    READ columns  WRITE setColumns  NOTIFY layoutChanged)
+    Q_PROPERTY(Metric metric     READ metric   WRITE setMetric   NOTIFY metricChanged)
+
+    Q_PROPERTY(QColor noDataColor   READ noDataColor   WRITE setNoDataColor   NOTIFY paletteChanged)
+    Q_PROPERTY(QColor healthyColor  READ healthyColor  WRITE setHealthyColor  NOTIFY paletteChanged)
+    Q_PROPERTY(QColor warningColor  READ warningColor  WRITE setWarningColor  NOTIFY paletteChanged)
+    Q_PROPERTY(QColor criticalColor READ criticalColor WRITE setCriticalColor NOTIFY paletteChanged)
+
+public:
+    enum Metric { Status, Power, Temperature, Current };
+    Q_ENUM(Metric)
+
+    explicit ElementGridItem(QQuickItem *parent = nullptr);
+
+    RadarModel *model()    const { return m_model; }
+    int         quadrant() const { return m_quadrant; }
+    int         columns()  const { return m_columns; }
+    Metric      metric()   const { return m_metric; }
+    void setModel(RadarModel *model);
+    void setQuadrant(int q);
+    void setColumns(int columns);
+    void setMetric(Metric metric);
+
+    QColor noDataColor()   const { return m_colors[0]; }
+    QColor healthyColor()  const { return m_colors[1]; }
+    QColor warningColor()  const { return m_colors[2]; }
+    QColor criticalColor() const { return m_colors[3]; }
+    void setNoDataColor(const QColor &c)   { setColor(0, c); }
+    void setHealthyColor(const QColor &c)  { setColor(1, c); }
+    void setWarningColor(const QColor &c)  { setColor(2, c); }
+    void setCriticalColor(const QColor &c) { setColor(3, c); }
+
+    // Cell of element gid in item coordinates (gap included); empty if not shown
+    Q_INVOKABLE QRectF cellRect(int gid) const;
+    // Global id of the element under (x, y) in item coordinates, -1 if none
+    Q_INVOKABLE int    elementAt(qreal x, qreal y) const;
+
+signals:
+    void modelChanged();
+    void layoutChanged();
+    void metricChanged();
+    void paletteChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *old, UpdatePaintNodeData *) override;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+#else
+    void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+#endif
+
+private slots:
+    void onQuadrantUpdated(int q);
+
+private:
+    // Grid shape for the current model / quadrant / columns
+    struct Layout {
+        int   tilesX = 0, tilesY = 0;
+        int   rows   = 0;            // element rows per tile
+        float cellW  = 0, cellH = 0;
+    };
+    Layout layout() const;
+    bool   showsQuadrant(int q) const { return m_quadrant < 0 || m_quadrant == q; }
+    int    tileOf(int q) const        { return m_quadrant < 0 ? q : 0; }
+    void   setColor(int status, const QColor &c);
+    void   invalidate(bool positions);
+    QSGGeometryNode *buildTile(int q, const Layout &l) const;
+    // Re-classify quadrant q into m_class; calls changed(localElem, cls) per changed cell
+    template <typename F> void classifyQuadrant(int q, F changed);
+
+    QPointer<RadarModel> m_model;
+    int     m_quadrant = -1;
+    int     m_columns  = 16;
+    Metric  m_metric   = Status;
+    QColor  m_colors[4];
+    QRgb    m_rgba[4];                // premultiplied m_colors
+
+    // Sync state (touched in updatePaintNode while the GUI thread is blocked)
+    QVector<quint8> m_dirtyQuads;     // [q] set by quadrantUpdated
+    QVector<quint8> m_class;          // [gid] colour class last drawn; 0xFF = redraw
+    bool            m_rebuild = true; // positions / node structure out of date
+    QImage          m_image;          // software backend: one pixel per cell
+};
@@ -0,0 +1,48 @@
+#include "ElementHistory.h"
+#include "RadarModel.h"
+
+const quint16 ElementHistory::kNoData;
+
+void ElementHistory::configure(int elements, int depth)
+{
+    m_elements = qMax(0, elements);
+    m_depth    = qMax(1, depth);
+    m_head     = 0;
+    m_size     = 0;
+    m_samples.fill(kNoData, m_depth * 3 * m_elements);
+    m_times.fill(0, m_depth);
+}
+
+// Wire scaling, rounded rather than truncated; 0xFFFF is reserved for NO_DATA
+quint16 ElementHistory::quantize(Param p, float v)
+{
+    if (v == ElementHealth::NO_DATA_VAL) return kNoData;
+    static const float scale[3]  = { 100.0f, 10.0f, 1000.0f };
+    static const float offset[3] = { 10.0f, 0.0f, 0.0f };
+    return quint16(qBound(0, qRound((v + offset[p]) * scale[p]), int(kNoData) - 1));
+}
+
+float ElementHistory::dequantize(Param p, quint16 raw)
+{
+    if (raw == kNoData) return ElementHealth::NO_DATA_VAL;
+    switch (p) {
+        case Power: return RadarModel::decodePower(raw);
+        case Temp:  return RadarModel::decodeTemp(raw);
+        default:    return RadarModel::decodeCurrent(raw);
+    }
+}
+
+void ElementHistory::record(qint64 timeMs, const float *power, const float *temp, const float *current)
+{
+    if (m_elements == 0) return;
+    quint16 *dst = m_samples.data() + qint64(m_head) * 3 * m_elements;
+    const float *src[3] = { power, temp, current };
+    for (int k = 0; k < 3; ++k, dst += m_elements) {
+        const Param p = Param(k);
+        for (int i = 0; i < m_elements; ++i)
+            dst[i] = quantize(p, src[k][i]);
+    }
+    m_times[m_head] = timeMs;
+    m_head = (m_head + 1) % m_depth;
+    m_size = qMin(m_size + 1, m_depth);
+}
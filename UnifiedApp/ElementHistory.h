@@ -0,0 +1,51 @@
+#pragma once
+#include <QVector>
+#include <QtGlobal>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ElementHistory — fixed-memory sample ring for every element of an antenna
+//
+// One row per sample, parameter-planar: [power × N][temp × N][current × N]
+// quantized to u16 with the wire scaling (see UdpReceiver.h), 0xFFFF for
+// NO_DATA. Recording a sample is one sequential pass over the model's
+// arrays; reading one element's series strides across rows.
+//
+// Memory: depth × elements × 6 bytes, e.g. 600 samples (10 min at 1 Hz)
+// × 2048 elements = 7.4 MB.
+// ─────────────────────────────────────────────────────────────────────────────
+class ElementHistory
+{
+public:
+    enum Param { Power = 0, Temp = 1, Current = 2 };
+    static const quint16 kNoData = 0xFFFF;
+
+    // Drops all samples
+    void configure(int elements, int depth);
+
+    void record(qint64 timeMs, const float *power, const float *temp, const float *current);
+
+    int    depth()    const { return m_depth; }
+    int    size()     const { return m_size; }        // samples held, ≤ depth
+    int    elements() const { return m_elements; }
+    qint64 bytes()    const { return qint64(m_samples.size()) * 2 + qint64(m_times.size()) * 8; }
+
+    // i = 0 is the oldest sample held, size() - 1 the newest
+    qint64         time(int i) const { return m_times[slot(i)]; }
+    const quint16 *row(int i, Param p) const
+    {
+        return m_samples.constData() + (qint64(slot(i)) * 3 + p) * m_elements;
+    }
+
+    static quint16 quantize(Param p, float v);
+    static float   dequantize(Param p, quint16 raw);   // NO_DATA_VAL for kNoData
+
+private:
+    int slot(int i) const { return (m_head - m_size + i + m_depth) % m_depth; }
+
+    int              m_elements = 0;
+    int              m_depth    = 0;
+    int              m_head     = 0;      // next slot to write
+    int              m_size     = 0;
+    QVector<quint16> m_samples;           // [slot][param][element]
+    QVector<qint64>  m_times;             // [slot] ms since epoch
+};
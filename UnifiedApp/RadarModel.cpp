@@ -1,225 +1,741 @@
 #include "RadarModel.h"
 #include <algorithm>
 #include <numeric>
+#include <tuple>
+#include <limits>
+#include <cstring>
+#include <QtAlgorithms>
+#include <QThread>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 RadarModel::RadarModel(const AntennaConfig &cfg, QObject *parent)
-    : QObject(parent), m_cfg(cfg)
+    : QObject(parent), m_cfg(cfg), m_writer(new QObject)
 {
-    m_data.resize(cfg.quadrants);
-    for (auto &q : m_data)
-        q.resize(cfg.elementsPerQuadrant);  // default-constructed → all NO_DATA
+    const int total = cfg.totalElements();
+    m_power.fill(ElementHealth::NO_DATA_VAL, total);
+    m_temp.fill(ElementHealth::NO_DATA_VAL, total);
+    m_current.fill(ElementHealth::NO_DATA_VAL, total);
+    m_status.fill(quint8(ElementHealth::NoData), total);
+    m_scratch.resize(cfg.elementsPerQuadrant);
+    m_decoded.resize(3 * cfg.elementsPerQuadrant);
+    m_refreshGen.fill(0, total);
+    m_worstStatus.fill(quint8(ElementHealth::NoData), total);
+    m_worstPower.fill(0.0f, total);
+    m_quadUpdateMs.fill(0, cfg.quadrants);
+    m_quadFresh.fill(0, cfg.quadrants);
+    m_counts[ElementHealth::NoData] = total;
+
+    // Everything starts as NoData with no valid values
+    const int epc = qMax(1, cfg.elementsPerCluster);
+    m_clusterSlots = (cfg.elementsPerQuadrant + epc - 1) / epc;
+    m_quadAgg.resize(cfg.quadrants);
+    m_clusterAgg.resize(cfg.quadrants * m_clusterSlots);
+    m_quadNodes.resize(cfg.quadrants);
+    m_clusterNodes.resize(cfg.quadrants * m_clusterSlots);
+    m_frameClusters.fill(1, cfg.quadrants * m_clusterSlots);   // first frame computes every node
+    for (int q = 0; q < cfg.quadrants; ++q) {
+        m_quadAgg[q].counts[ElementHealth::NoData] = cfg.elementsPerQuadrant;
+        for (int c = 0; c < m_clusterSlots; ++c)
+            m_clusterAgg[clusterSlot(q, c)].counts[ElementHealth::NoData] =
+                qMin(epc, cfg.elementsPerQuadrant - c * epc);
+    }
+    m_front = buildSnapshot();
 
     m_histTimer = new QTimer(this);
     m_histTimer->setInterval(2000);
     connect(m_histTimer, &QTimer::timeout, this, &RadarModel::snapshotHistory);
     m_histTimer->start();
 
-    m_lastUpdate = "No data";
+    // Write-side timers follow m_writer to the write thread
+    m_staleTimer = new QTimer(m_writer);
+    connect(m_staleTimer, &QTimer::timeout, m_writer, [this]() { sweepStale(); });
+    setStaleAfterMs(cfg.staleAfterMs);
+
+    m_sampleTimer = new QTimer(this);
+    connect(m_sampleTimer, &QTimer::timeout, this, &RadarModel::sampleElementHistory);
+    setHistoryFormat(cfg.historySampleMs, cfg.historyDepth);
+
+    m_frameTimer = new QTimer(m_writer);
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_frameTimer, &QTimer::timeout, m_writer, [this]() { publishFrame(); });
+    setNotifyIntervalMs(cfg.notifyIntervalMs);
 }
 
-// ── Aggregate health helper ───────────────────────────────────────────────────
-int RadarModel::calcHealth(const QVector<ElementHealth> &elems, int start, int count)
+RadarModel::~RadarModel()
 {
-    int total = 0, scored = 0;
-    for (int i = start; i < start + count && i < elems.size(); ++i) {
-        int s = elems[i].healthScore();
-        if (s >= 0) { total += s; scored++; }
+    // The write-side timers have to be stopped on their own thread
+    QThread *t = m_writer->thread();
+    if (t != QThread::currentThread() && t->isRunning())
+        QMetaObject::invokeMethod(m_writer, [this]() { delete m_writer; }, Qt::BlockingQueuedConnection);
+    else
+        delete m_writer;
+}
+
+// ── Write thread ─────────────────────────────────────────────────────────────
+void RadarModel::setWriteThread(QThread *thread)
+{
+    QThread *target = thread ? thread : this->thread();
+    if (m_writer->thread() == target) return;
+    if (m_writer->thread() == QThread::currentThread())
+        m_writer->moveToThread(target);
+    else
+        QMetaObject::invokeMethod(m_writer, [this, target]() { m_writer->moveToThread(target); },
+                                  Qt::BlockingQueuedConnection);
+}
+
+bool RadarModel::writeThreaded() const
+{
+    return m_writer->thread() != thread();
+}
+
+// ── Vectorised classification ────────────────────────────────────────────────
+// Same result as ElementHealth::classify per element. With SSE2 the
+// comparisons produce all-ones lanes (-1), so "3 - (p>=crit) - (p>=warn)"
+// becomes 3 + maskCrit + maskWarn; the three int32 results are narrowed to
+// int16 for the max (SSE2 has no 32-bit max) and packed to bytes, 8 elements
+// per step.
+void RadarModel::classify(const float *power, const float *temp, const float *current,
+                          quint8 *out, int n, const ElementThresholds &th)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128  noData = _mm_set1_ps(ElementHealth::NO_DATA_VAL);
+    const __m128  p40 = _mm_set1_ps(th.powerCrit),   p43 = _mm_set1_ps(th.powerWarn);
+    const __m128  t45 = _mm_set1_ps(th.tempWarn),    t50 = _mm_set1_ps(th.tempCrit);
+    const __m128  c18 = _mm_set1_ps(th.currentWarn), c20 = _mm_set1_ps(th.currentCrit);
+    const __m128i one = _mm_set1_epi32(1),  three = _mm_set1_epi32(3);
+
+    auto status4 = [&](int k) {
+        const __m128 p = _mm_loadu_ps(power + k);
+        const __m128 t = _mm_loadu_ps(temp + k);
+        const __m128 c = _mm_loadu_ps(current + k);
+        __m128i ps = _mm_add_epi32(three, _mm_add_epi32(_mm_castps_si128(_mm_cmpge_ps(p, p40)),
+                                                        _mm_castps_si128(_mm_cmpge_ps(p, p43))));
+        __m128i ts = _mm_sub_epi32(one, _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(t, t45)),
+                                                      _mm_castps_si128(_mm_cmpgt_ps(t, t50))));
+        __m128i cs = _mm_sub_epi32(one, _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(c, c18)),
+                                                      _mm_castps_si128(_mm_cmpgt_ps(c, c20))));
+        ps = _mm_andnot_si128(_mm_castps_si128(_mm_cmpeq_ps(p, noData)), ps);
+        ts = _mm_andnot_si128(_mm_castps_si128(_mm_cmpeq_ps(t, noData)), ts);
+        cs = _mm_andnot_si128(_mm_castps_si128(_mm_cmpeq_ps(c, noData)), cs);
+        return std::make_tuple(ps, ts, cs);
+    };
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i pa, ta, ca, pb, tb, cb;
+        std::tie(pa, ta, ca) = status4(i);
+        std::tie(pb, tb, cb) = status4(i + 4);
+        __m128i s = _mm_max_epi16(_mm_packs_epi32(pa, pb),
+                                  _mm_max_epi16(_mm_packs_epi32(ta, tb), _mm_packs_epi32(ca, cb)));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(s, s));
     }
-    return (scored > 0) ? (total / scored) : -1;
+#endif
+    for (; i < n; ++i)
+        out[i] = quint8(ElementHealth::classify(power[i], temp[i], current[i], th));
 }
 
-// ── Global stats rebuild ─────────────────────────────────────────────────────
-void RadarModel::rebuildStats()
+// ── Incremental aggregates ───────────────────────────────────────────────────
+int RadarModel::calcHealth(const Aggregate &a)
 {
-    m_healthy = m_warning = m_critical = m_noData = 0;
-    for (auto &quad : m_data) {
-        for (auto &e : quad) {
-            switch (e.overall()) {
-                case ElementHealth::Healthy:  ++m_healthy;  break;
-                case ElementHealth::Warning:  ++m_warning;  break;
-                case ElementHealth::Critical: ++m_critical; break;
-                default:                      ++m_noData;   break;
+    const int *c = a.counts;
+    int scored = c[ElementHealth::Healthy] + c[ElementHealth::Warning] + c[ElementHealth::Critical];
+    return (scored > 0) ? ((c[ElementHealth::Healthy] * 100 + c[ElementHealth::Warning] * 50) / scored) : -1;
+}
+
+void RadarModel::applyValue(Aggregate &a, int param, float oldV, float newV)
+{
+    const bool wasValid = oldV != ElementHealth::NO_DATA_VAL;
+    const bool isValid  = newV != ElementHealth::NO_DATA_VAL;
+    a.sum[param]   += (isValid ? double(newV) : 0.0) - (wasValid ? double(oldV) : 0.0);
+    a.valid[param] += int(isValid) - int(wasValid);
+}
+
+void RadarModel::applyStatus(int g, quint8 status)
+{
+    const quint8 old = m_status[g];
+    if (old == status) return;
+    m_status[g] = status;
+
+    const int epq = m_cfg.elementsPerQuadrant;
+    const int q   = g / epq;
+    Aggregate &qa = m_quadAgg[q];
+    Aggregate &ca = m_clusterAgg[clusterSlot(q, (g - q * epq) / qMax(1, m_cfg.elementsPerCluster))];
+    --qa.counts[old];        ++qa.counts[status];
+    --ca.counts[old];        ++ca.counts[status];
+    --m_counts[old];         ++m_counts[status];
+}
+
+bool RadarModel::writeQuadrant(int q, const float *P, const float *T, const float *C)
+{
+    const int epq  = m_cfg.elementsPerQuadrant;
+    const int epc  = qMax(1, m_cfg.elementsPerCluster);
+    const int base = quadBase(q);
+    float *dst[3]       = { m_power.data() + base, m_temp.data() + base, m_current.data() + base };
+    const float *src[3] = { P, T, C };
+    Aggregate &qa = m_quadAgg[q];
+    std::fill(m_refreshGen.begin() + base, m_refreshGen.begin() + base + epq, m_generation);
+    m_quadFresh[q] = 1;
+
+    // Values: per cluster, apply sum deltas for the elements that differ
+    bool changed = false;
+    for (int c = 0; c < m_clusterSlots; ++c) {
+        Aggregate &ca = m_clusterAgg[clusterSlot(q, c)];
+        const int end = qMin(epq, (c + 1) * epc);
+        bool clusterChanged = false;
+        for (int k = 0; k < 3; ++k) {
+            float *d = dst[k];
+            const float *v = src[k];
+            for (int i = c * epc; i < end; ++i) {
+                if (d[i] == v[i]) continue;
+                applyValue(ca, k, d[i], v[i]);
+                applyValue(qa, k, d[i], v[i]);
+                d[i] = v[i];
+                clusterChanged = true;
             }
         }
+        if (clusterChanged) markDirty(q, c);
+        changed |= clusterChanged;
+    }
+    if (!changed) return false;
+
+    // Statuses: reclassify the quadrant, count only the transitions
+    // (data() detaches from the last snapshot up front, so cur stays valid)
+    classify(dst[0], dst[1], dst[2], m_scratch.data(), epq, m_cfg.thresholds);
+    const quint8 *fresh = m_scratch.constData();
+    const quint8 *cur   = m_status.data() + base;
+    for (int i = 0; i < epq; ++i) {
+        if (fresh[i] != cur[i]) applyStatus(base + i, fresh[i]);
+    }
+
+    // Re-key indexed / newly bad elements (no-op unless status or power moved)
+    const quint8 *indexed = m_worstStatus.constData() + base;
+    for (int i = 0; i < epq; ++i) {
+        if (cur[i] >= ElementHealth::Warning || indexed[i] >= ElementHealth::Warning)
+            reindexWorst(base + i);
     }
-    m_lastUpdate = QDateTime::currentDateTime().toString("hh:mm:ss.zzz");
+    return true;
+}
+
+void RadarModel::reindexWorst(int g)
+{
+    const quint8 s   = m_status[g];
+    const float  key = m_power[g] == ElementHealth::NO_DATA_VAL ? 999.0f : m_power[g];
+    const quint8 was = m_worstStatus[g];
+    if (s == was && (s < ElementHealth::Warning || key == m_worstPower[g])) return;
+
+    if (was >= ElementHealth::Warning) m_worst.erase(WorstKey{was, m_worstPower[g], g});
+    if (s >= ElementHealth::Warning)   m_worst.insert(WorstKey{s, key, g});
+    m_worstStatus[g] = s;
+    m_worstPower[g]  = key;
+    m_worstChanged   = true;
+}
+
+void RadarModel::clusterRange(int q, int c, int &begin, int &count) const
+{
+    const int epc   = m_cfg.elementsPerCluster;
+    const int epq   = m_cfg.elementsPerQuadrant;
+    const int start = qMax(0, c * epc);
+    const int end   = qMin(epq, (c + 1) * epc);
+    begin = quadBase(q) + start;
+    count = (validQuad(q) && c >= 0) ? qMax(0, end - start) : 0;
+}
+
+// ── Aggregate cache tree ─────────────────────────────────────────────────────
+void RadarModel::markDirty(int q, int cluster)
+{
+    m_frameClusters[clusterSlot(q, cluster)] = 1;
+}
+
+void RadarModel::finishNode(Node &n, const Aggregate &a)
+{
+    const int *c = a.counts;
+    n.health = calcHealth(a);
+    n.stats  = {c[ElementHealth::Healthy], c[ElementHealth::Warning],
+                c[ElementHealth::Critical], c[ElementHealth::NoData]};
+
+    static const char *const avgKey[3] = { "avgPower", "avgTemp", "avgCurrent" };
+    static const char *const minKey[3] = { "minPower", "minTemp", "minCurrent" };
+    static const char *const maxKey[3] = { "maxPower", "maxTemp", "maxCurrent" };
+    n.metrics.clear();
+    for (int k = 0; k < 3; ++k) {
+        const int cnt = a.valid[k];
+        n.metrics[avgKey[k]] = cnt ? a.sum[k] / cnt : -999.0;
+        n.metrics[minKey[k]] = cnt ? double(n.min[k]) : -999.0;
+        n.metrics[maxKey[k]] = cnt ? double(n.max[k]) : -999.0;
+    }
+}
+
+static void resetExtremes(float *mn, float *mx)
+{
+    for (int k = 0; k < 3; ++k) {
+        mn[k] =  std::numeric_limits<float>::max();
+        mx[k] = -std::numeric_limits<float>::max();
+    }
+}
+
+void RadarModel::refreshCluster(int q, int c)
+{
+    const int slot = clusterSlot(q, c);
+    Node &n = m_clusterNodes[slot];
+    int begin, count;
+    clusterRange(q, c, begin, count);
+    const float *src[3] = { m_power.constData() + begin, m_temp.constData() + begin,
+                            m_current.constData() + begin };
+    resetExtremes(n.min, n.max);
+    for (int k = 0; k < 3; ++k) {
+        for (int i = 0; i < count; ++i) {
+            const float v = src[k][i];
+            if (v == ElementHealth::NO_DATA_VAL) continue;
+            n.min[k] = qMin(n.min[k], v);
+            n.max[k] = qMax(n.max[k], v);
+        }
+    }
+    finishNode(n, m_clusterAgg[slot]);
+}
+
+// Flagged clusters from their elements, then their quadrants and the antenna
+// from their children
+void RadarModel::refreshNodes()
+{
+    const quint8 *flagged = m_frameClusters.constData();
+    bool antennaDirty = false;
+    for (int q = 0; q < m_cfg.quadrants; ++q) {
+        bool quadDirty = false;
+        for (int c = 0; c < m_clusterSlots; ++c) {
+            if (!flagged[clusterSlot(q, c)]) continue;
+            refreshCluster(q, c);
+            quadDirty = true;
+        }
+        if (!quadDirty) continue;
+
+        Node &n = m_quadNodes[q];
+        resetExtremes(n.min, n.max);
+        for (int c = 0; c < m_clusterSlots; ++c) {
+            const Node &cn = m_clusterNodes[clusterSlot(q, c)];
+            for (int k = 0; k < 3; ++k) {
+                n.min[k] = qMin(n.min[k], cn.min[k]);
+                n.max[k] = qMax(n.max[k], cn.max[k]);
+            }
+        }
+        finishNode(n, m_quadAgg[q]);
+        antennaDirty = true;
+    }
+    if (!antennaDirty) return;
+
+    Aggregate total;
+    Node &n = m_antennaNode;
+    resetExtremes(n.min, n.max);
+    for (int q = 0; q < m_cfg.quadrants; ++q) {
+        const Node &qn = m_quadNodes[q];
+        const Aggregate &qa = m_quadAgg[q];
+        for (int s = 0; s < 4; ++s)
+            total.counts[s] += qa.counts[s];
+        for (int k = 0; k < 3; ++k) {
+            total.sum[k]   += qa.sum[k];
+            total.valid[k] += qa.valid[k];
+            n.min[k] = qMin(n.min[k], qn.min[k]);
+            n.max[k] = qMax(n.max[k], qn.max[k]);
+        }
+    }
+    finishNode(n, total);
+}
+
+// ── Global stats ─────────────────────────────────────────────────────────────
+void RadarModel::touched(quint32 quadMask)
+{
+    m_lastUpdateMs = QDateTime::currentMSecsSinceEpoch();
+    ++m_dataVersion;
+    for (int q = 0; q < m_cfg.quadrants; ++q) {
+        if (!m_quadFresh[q]) continue;
+        m_quadUpdateMs[q] = m_lastUpdateMs;
+        m_quadFresh[q] = 0;
+    }
+    scheduleFrame(quadMask);
+}
+
+quint32 RadarModel::allQuadsMask() const
+{
+    return m_cfg.quadrants >= 32 ? ~0u : (1u << m_cfg.quadrants) - 1;
+}
+
+// ── Frame coalescing ─────────────────────────────────────────────────────────
+void RadarModel::setNotifyIntervalMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (ms == m_notifyIntervalMs) return;
+    m_notifyIntervalMs = ms;
+    QMetaObject::invokeMethod(m_writer, [this, ms]() {
+        m_frameTimer->setInterval(ms);
+        if (ms == 0 && m_frameTimer->isActive()) publishFrame();
+    });
+    emit notifyIntervalMsChanged();
+}
+
+// Every write path used to emit statsChanged plus one quadrantUpdated per
+// quadrant it wrote; those are counted here and compared with what the frame
+// actually emits.
+void RadarModel::scheduleFrame(quint32 quadMask)
+{
+    m_frameQuads      |= quadMask;
+    m_pendingNotifies += 1 + qPopulationCount(quadMask);
+    if (m_frameTimer->interval() <= 0)
+        publishFrame();
+    else if (!m_frameTimer->isActive())
+        m_frameTimer->start();
+}
+
+void RadarModel::publishFrame()
+{
+    m_frameTimer->stop();
+    const RadarSnapshotPtr frame = buildSnapshot();
+    // Direct on the model's thread, queued from an ingest thread
+    QMetaObject::invokeMethod(this, [this, frame]() { adoptFrame(frame); });
+}
+
+RadarSnapshotPtr RadarModel::buildSnapshot()
+{
+    refreshNodes();
+    if (m_worstChanged) {
+        QVector<int> order;
+        order.reserve(int(m_worst.size()));
+        for (const WorstKey &k : m_worst)
+            order.append(k.gid);
+        m_worstOrder   = order;
+        m_worstChanged = false;
+    }
+
+    RadarSnapshot *s = new RadarSnapshot;
+    s->status       = m_status;
+    s->power        = m_power;
+    s->temp         = m_temp;
+    s->current      = m_current;
+    s->antenna      = m_antennaNode;
+    s->quadrants    = m_quadNodes;
+    s->clusters     = m_clusterNodes;
+    s->worst        = m_worstOrder;
+    s->quadUpdateMs = m_quadUpdateMs;
+    s->clusterMask  = QByteArray(reinterpret_cast<const char *>(m_frameClusters.constData()),
+                                 m_frameClusters.size());
+    std::fill(m_frameClusters.begin(), m_frameClusters.end(), quint8(0));
+    std::copy(m_counts, m_counts + 4, s->counts);
+    s->lastUpdateMs   = m_lastUpdateMs;
+    s->dataVersion    = m_dataVersion;
+    s->staleDemotions = m_staleDemotions;
+    s->quadMask       = m_frameQuads;
+    s->notifications  = m_pendingNotifies;
+    m_frameQuads      = 0;
+    m_pendingNotifies = 0;
+    return RadarSnapshotPtr(s);
+}
+
+// Model thread: make the frame current, then signal it
+void RadarModel::adoptFrame(const RadarSnapshotPtr &frame)
+{
+    m_front = frame;
+    const quint32 mask = frame->quadMask;
+
+    int emitted = 1;
     emit statsChanged();
+    for (int q = 0; q < m_cfg.quadrants; ++q) {
+        if (!(mask & quadBit(q))) continue;
+        emit quadrantUpdated(q);
+        ++emitted;
+    }
+    m_suppressed += qMax(0, frame->notifications - emitted);
+    ++m_framesPublished;
+    emit frameUpdated(int(mask));
+}
+
+QVariantMap RadarModel::thresholdMap() const
+{
+    const ElementThresholds &th = m_cfg.thresholds;
+    QVariantMap m;
+    m["powerWarn"]   = th.powerWarn;
+    m["powerCrit"]   = th.powerCrit;
+    m["tempWarn"]    = th.tempWarn;
+    m["tempCrit"]    = th.tempCrit;
+    m["currentWarn"] = th.currentWarn;
+    m["currentCrit"] = th.currentCrit;
+    return m;
+}
+
+QVariantList RadarModel::quadrantUpdateTimes() const
+{
+    QVariantList out;
+    out.reserve(m_front->quadUpdateMs.size());
+    for (qint64 ms : m_front->quadUpdateMs)
+        out.append(double(ms));
+    return out;
+}
+
+QString RadarModel::lastUpdateTime() const
+{
+    const qint64 ms = m_front->lastUpdateMs;
+    if (ms == 0) return QStringLiteral("No data");
+    return QDateTime::fromMSecsSinceEpoch(ms).toString("hh:mm:ss.zzz");
+}
+
+// ── LOD0 ─────────────────────────────────────────────────────────────────────
+int RadarModel::antennaHealth() const
+{
+    return m_front->antenna.health;
+}
+
+QVariantMap RadarModel::antennaMetrics() const
+{
+    return m_front->antenna.metrics;
 }
 
 // ── LOD1 ─────────────────────────────────────────────────────────────────────
 int RadarModel::quadrantHealth(int q) const
 {
-    if (q < 0 || q >= m_data.size()) return -1;
-    return calcHealth(m_data[q], 0, m_data[q].size());
+    if (!validQuad(q)) return -1;
+    return m_front->quadrants[q].health;
 }
 
 QVariantList RadarModel::quadrantStats(int q) const
 {
-    if (q < 0 || q >= m_data.size()) return {0,0,0,0};
-    int h=0, w=0, c=0, n=0;
-    for (auto &e : m_data[q]) {
-        switch (e.overall()) {
-            case ElementHealth::Healthy:  ++h; break;
-            case ElementHealth::Warning:  ++w; break;
-            case ElementHealth::Critical: ++c; break;
-            default:                      ++n; break;
-        }
-    }
-    return {h, w, c, n};
+    if (!validQuad(q)) return {0,0,0,0};
+    return m_front->quadrants[q].stats;
 }
 
 QVariantMap RadarModel::quadrantMetrics(int q) const
 {
-    QVariantMap m;
-    if (q < 0 || q >= m_data.size()) return m;
-    double sp=0, st=0, sc=0;
-    float  minP=999, maxT=-999, maxC=-999;
-    int    np=0, nt=0, nc=0;
-    for (auto &e : m_data[q]) {
-        if (e.power       != ElementHealth::NO_DATA_VAL) { sp+=e.power;       minP=qMin(minP,e.power);       ++np; }
-        if (e.temperature != ElementHealth::NO_DATA_VAL) { st+=e.temperature; maxT=qMax(maxT,e.temperature); ++nt; }
-        if (e.current     != ElementHealth::NO_DATA_VAL) { sc+=e.current;     maxC=qMax(maxC,e.current);     ++nc; }
-    }
-    m["avgPower"]   = np ? sp/np : -999.0;
-    m["avgTemp"]    = nt ? st/nt : -999.0;
-    m["avgCurrent"] = nc ? sc/nc : -999.0;
-    m["minPower"]   = np ? minP  : -999.0;
-    m["maxTemp"]    = nt ? maxT  : -999.0;
-    m["maxCurrent"] = nc ? maxC  : -999.0;
-    return m;
+    if (!validQuad(q)) return QVariantMap();
+    return m_front->quadrants[q].metrics;
 }
 
 // ── LOD2 ─────────────────────────────────────────────────────────────────────
 int RadarModel::clusterHealth(int q, int c) const
 {
-    if (q < 0 || q >= m_data.size()) return -1;
-    int epc = m_cfg.elementsPerCluster;
-    return calcHealth(m_data[q], c * epc, epc);
+    if (!validQuad(q) || c < 0 || c >= m_clusterSlots) return -1;
+    return m_front->clusters[clusterSlot(q, c)].health;
 }
 
 QVariantList RadarModel::clusterStats(int q, int c) const
 {
-    if (q < 0 || q >= m_data.size()) return {0,0,0,0};
-    int epc   = m_cfg.elementsPerCluster;
-    int start = c * epc;
-    int h=0, w=0, cc=0, n=0;
-    for (int i = start; i < start + epc && i < m_data[q].size(); ++i) {
-        switch (m_data[q][i].overall()) {
-            case ElementHealth::Healthy:  ++h;  break;
-            case ElementHealth::Warning:  ++w;  break;
-            case ElementHealth::Critical: ++cc; break;
-            default:                      ++n;  break;
-        }
-    }
-    return {h, w, cc, n};
+    if (!validQuad(q) || c < 0 || c >= m_clusterSlots) return {0,0,0,0};
+    return m_front->clusters[clusterSlot(q, c)].stats;
 }
 
 QVariantMap RadarModel::clusterMetrics(int q, int c) const
 {
-    QVariantMap m;
-    if (q < 0 || q >= m_data.size()) return m;
-    int epc   = m_cfg.elementsPerCluster;
-    int start = c * epc;
-    double sp=0, st=0, sc=0;
-    int np=0, nt=0, nc=0;
-    for (int i = start; i < start+epc && i < m_data[q].size(); ++i) {
-        auto &e = m_data[q][i];
-        if (e.power       != ElementHealth::NO_DATA_VAL) { sp+=e.power;       ++np; }
-        if (e.temperature != ElementHealth::NO_DATA_VAL) { st+=e.temperature; ++nt; }
-        if (e.current     != ElementHealth::NO_DATA_VAL) { sc+=e.current;     ++nc; }
+    if (!validQuad(q)) return QVariantMap();
+    if (c < 0 || c >= m_clusterSlots) {
+        QVariantMap m;
+        m["avgPower"] = m["avgTemp"] = m["avgCurrent"] = -999.0;
+        return m;
     }
-    m["avgPower"]   = np ? sp/np : -999.0;
-    m["avgTemp"]    = nt ? st/nt : -999.0;
-    m["avgCurrent"] = nc ? sc/nc : -999.0;
-    return m;
+    return m_front->clusters[clusterSlot(q, c)].metrics;
 }
 
 // ── LOD3 / Full ───────────────────────────────────────────────────────────────
 QVariantList RadarModel::quadrantData(int q) const
 {
-    if (q < 0 || q >= m_data.size()) return {};
+    if (!validQuad(q)) return {};
+    const quint8 *s = m_front->status.constData() + quadBase(q);
+    const int n = m_cfg.elementsPerQuadrant;
     QVariantList out;
-    out.reserve(m_data[q].size());
-    for (auto &e : m_data[q])
-        out.append(static_cast<int>(e.overall()));
+    out.reserve(n);
+    for (int i = 0; i < n; ++i)
+        out.append(static_cast<int>(s[i]));
     return out;
 }
 
 QVariantList RadarModel::clusterData(int q, int c) const
 {
-    if (q < 0 || q >= m_data.size()) return {};
-    int epc = m_cfg.elementsPerCluster;
-    int start = c * epc;
+    if (!validQuad(q)) return {};
+    int begin, count;
+    clusterRange(q, c, begin, count);
+    const quint8 *s = m_front->status.constData();
     QVariantList out;
-    for (int i = start; i < start+epc && i < m_data[q].size(); ++i)
-        out.append(static_cast<int>(m_data[q][i].overall()));
+    out.reserve(count);
+    for (int i = begin; i < begin + count; ++i)
+        out.append(static_cast<int>(s[i]));
     return out;
 }
 
 QVariantMap RadarModel::elementDetail(int q, int localElem) const
 {
     QVariantMap m;
-    if (q < 0 || q >= m_data.size()) return m;
-    if (localElem < 0 || localElem >= m_data[q].size()) return m;
-    auto &e = m_data[q][localElem];
-    m["power"]       = e.power;
-    m["temperature"] = e.temperature;
-    m["current"]     = e.current;
-    m["status"]      = static_cast<int>(e.overall());
-    m["powerStatus"] = static_cast<int>(ElementHealth::powerStatus(e.power));
-    m["tempStatus"]  = static_cast<int>(ElementHealth::tempStatus(e.temperature));
-    m["currStatus"]  = static_cast<int>(ElementHealth::currentStatus(e.current));
+    if (!validQuad(q)) return m;
+    if (localElem < 0 || localElem >= m_cfg.elementsPerQuadrant) return m;
+    const RadarSnapshot &f = *m_front;
+    const int g = quadBase(q) + localElem;
+    m["power"]       = f.power[g];
+    m["temperature"] = f.temp[g];
+    m["current"]     = f.current[g];
+    m["status"]      = static_cast<int>(f.status[g]);
+    m["powerStatus"] = static_cast<int>(ElementHealth::powerStatus(f.power[g], m_cfg.thresholds));
+    m["tempStatus"]  = static_cast<int>(ElementHealth::tempStatus(f.temp[g], m_cfg.thresholds));
+    m["currStatus"]  = static_cast<int>(ElementHealth::currentStatus(f.current[g], m_cfg.thresholds));
     return m;
 }
 
+int RadarModel::elementStatus(int gid) const
+{
+    const RadarSnapshot &f = *m_front;
+    if (gid < 0 || gid >= f.status.size()) return ElementHealth::NoData;
+    return f.status[gid];
+}
+
+double RadarModel::elementValue(int gid, int param) const
+{
+    const RadarSnapshot &f = *m_front;
+    if (gid < 0 || gid >= f.status.size()) return ElementHealth::NO_DATA_VAL;
+    switch (param) {
+        case 0:  return f.power[gid];
+        case 1:  return f.temp[gid];
+        case 2:  return f.current[gid];
+        default: return ElementHealth::NO_DATA_VAL;
+    }
+}
+
+// ── QML export ───────────────────────────────────────────────────────────────
+// The copy is refreshed in place; if QML still holds the previous snapshot
+// the write detaches, so a snapshot never changes under its reader.
+QByteArray RadarModel::exportBuffer(int which) const
+{
+    const RadarSnapshot &f = *m_front;
+    ExportBuffer &b = m_export[which];
+    if (b.version == f.dataVersion) return b.bytes;
+
+    const void *src;
+    int bytes;
+    switch (which) {
+        case 0:  src = f.status.constData();  bytes = f.status.size();                         break;
+        case 1:  src = f.power.constData();   bytes = f.power.size()   * int(sizeof(float)); break;
+        case 2:  src = f.temp.constData();    bytes = f.temp.size()    * int(sizeof(float)); break;
+        default: src = f.current.constData(); bytes = f.current.size() * int(sizeof(float)); break;
+    }
+    b.bytes.resize(bytes);
+    memcpy(b.bytes.data(), src, size_t(bytes));
+    b.version = f.dataVersion;
+    return b.bytes;
+}
+
 // ── Analytics ────────────────────────────────────────────────────────────────
+QVariantMap RadarModel::elementEntry(int g) const
+{
+    const RadarSnapshot &f = *m_front;
+    const int epq = m_cfg.elementsPerQuadrant;
+    QVariantMap m;
+    m["gid"]     = g;
+    m["quad"]    = g / epq;
+    m["local"]   = g % epq;
+    m["status"]  = static_cast<int>(f.status[g]);
+    m["power"]   = f.power[g];
+    m["temp"]    = f.temp[g];
+    m["current"] = f.current[g];
+    return m;
+}
+
 QVariantList RadarModel::worstElements(int n) const
 {
-    struct Candidate { int gid, q, local; int status; float power, temp, current; };
-    QVector<Candidate> cands;
+    const QVector<int> &worst = m_front->worst;
+    QVariantList out;
+    for (int i = 0; i < worst.size() && out.size() < n; ++i)
+        out.append(elementEntry(worst[i]));
+    return out;
+}
+
+QVariantList RadarModel::worstElementsBy(const QString &metric, int n) const
+{
+    const int k = metric == QLatin1String("power") ? 0
+                : (metric == QLatin1String("temp") || metric == QLatin1String("temperature")) ? 1
+                : metric == QLatin1String("current") ? 2 : -1;
+    if (k < 0) return worstElements(n);
+    if (n <= 0) return {};
+
+    // Score: lower is worse (power as is, temperature / current negated)
+    const RadarSnapshot &f = *m_front;
+    const bool lowIsWorst = k == 0;
+    const float *values = k == 0 ? f.power.constData() : k == 1 ? f.temp.constData() : f.current.constData();
+
+    // Clusters by their worst value, from the snapshot's cluster nodes
+    struct Cand { float score; int slot; };
+    QVector<Cand> clusters;
+    clusters.reserve(f.clusters.size());
+    for (int slot = 0; slot < f.clusters.size(); ++slot) {
+        const Node &node = f.clusters[slot];
+        if (node.min[k] > node.max[k]) continue;          // no valid value
+        clusters.append({ lowIsWorst ? node.min[k] : -node.max[k], slot });
+    }
+    const auto byScore = [](const Cand &a, const Cand &b) {
+        return a.score != b.score ? a.score < b.score : a.slot < b.slot;
+    };
+    std::sort(clusters.begin(), clusters.end(), byScore);
 
-    for (int q = 0; q < m_data.size(); ++q) {
-        for (int i = 0; i < m_data[q].size(); ++i) {
-            auto &e = m_data[q][i];
-            int s = e.overall();
-            if (s >= ElementHealth::Warning)
-                cands.append({q * m_cfg.elementsPerQuadrant + i, q, i,
-                              s, e.power, e.temperature, e.current});
+    // Max-heap of the n worst so far; stop once no cluster can improve on it
+    QVector<Cand> heap;          // slot field holds the gid here
+    heap.reserve(n + 1);
+    for (const Cand &cl : clusters) {
+        if (heap.size() == n && cl.score >= heap.front().score) break;
+        int begin, count;
+        clusterRange(cl.slot / m_clusterSlots, cl.slot % m_clusterSlots, begin, count);
+        for (int g = begin; g < begin + count; ++g) {
+            if (values[g] == ElementHealth::NO_DATA_VAL) continue;
+            const Cand e = { lowIsWorst ? values[g] : -values[g], g };
+            if (heap.size() < n) {
+                heap.append(e);
+                std::push_heap(heap.begin(), heap.end(), byScore);
+            } else if (byScore(e, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), byScore);
+                heap.back() = e;
+                std::push_heap(heap.begin(), heap.end(), byScore);
+            }
         }
     }
-    std::sort(cands.begin(), cands.end(), [](const Candidate &a, const Candidate &b){
-        if (a.status != b.status) return a.status > b.status;
-        // Among same status, sort by power (lowest first)
-        float ap = a.power == ElementHealth::NO_DATA_VAL ? 999.0f : a.power;
-        float bp = b.power == ElementHealth::NO_DATA_VAL ? 999.0f : b.power;
-        return ap < bp;
-    });
+    std::sort_heap(heap.begin(), heap.end(), byScore);
 
     QVariantList out;
-    for (int i = 0; i < qMin(n, cands.size()); ++i) {
-        QVariantMap m;
-        m["gid"]     = cands[i].gid;
-        m["quad"]    = cands[i].q;
-        m["local"]   = cands[i].local;
-        m["status"]  = cands[i].status;
-        m["power"]   = cands[i].power;
-        m["temp"]    = cands[i].temp;
-        m["current"] = cands[i].current;
-        out.append(m);
-    }
+    out.reserve(heap.size());
+    for (const Cand &e : heap)
+        out.append(elementEntry(e.slot));
     return out;
 }
 
 // ── Ingestion ────────────────────────────────────────────────────────────────
 void RadarModel::setElement(int q, int le, float power, float temp, float current)
 {
-    if (q < 0 || q >= m_data.size()) return;
-    if (le < 0 || le >= m_data[q].size()) return;
-    m_data[q][le].power       = power;
-    m_data[q][le].temperature = temp;
-    m_data[q][le].current     = current;
-    rebuildStats();
-    emit quadrantUpdated(q);
+    if (!validQuad(q)) return;
+    if (le < 0 || le >= m_cfg.elementsPerQuadrant) return;
+    writeElement(quadBase(q) + le, power, temp, current);
+    m_quadFresh[q] = 1;
+    touched(quadBit(q));
+}
+
+void RadarModel::writeElement(int g, float power, float temp, float current)
+{
+    const int epq = m_cfg.elementsPerQuadrant;
+    const int q   = g / epq;
+    const int c   = (g - q * epq) / qMax(1, m_cfg.elementsPerCluster);
+    Aggregate &qa = m_quadAgg[q];
+    Aggregate &ca = m_clusterAgg[clusterSlot(q, c)];
+    float *dst[3] = { &m_power[g], &m_temp[g], &m_current[g] };
+    const float v[3] = { power, temp, current };
+    for (int k = 0; k < 3; ++k) {
+        applyValue(qa, k, *dst[k], v[k]);
+        applyValue(ca, k, *dst[k], v[k]);
+        *dst[k] = v[k];
+    }
+    applyStatus(g, quint8(ElementHealth::classify(power, temp, current, m_cfg.thresholds)));
+    reindexWorst(g);
+    markDirty(q, c);
+    m_refreshGen[g] = m_generation;
+}
+
+// Short input vectors are padded with NO_DATA, as before
+static const float *padded(const QVector<float> &v, int n, QVector<float> &scratch)
+{
+    if (v.size() >= n) return v.constData();
+    scratch = v;
+    scratch.resize(n);
+    std::fill(scratch.begin() + v.size(), scratch.end(), ElementHealth::NO_DATA_VAL);
+    return scratch.constData();
 }
 
 void RadarModel::setQuadrant(int q,
@@ -227,40 +743,296 @@ void RadarModel::setQuadrant(int q,
                              const QVector<float> &temps,
                              const QVector<float> &currents)
 {
-    if (q < 0 || q >= m_data.size()) return;
-    int n = m_data[q].size();
-    for (int i = 0; i < n; ++i) {
-        m_data[q][i].power       = (i < powers.size())   ? powers[i]   : ElementHealth::NO_DATA_VAL;
-        m_data[q][i].temperature = (i < temps.size())    ? temps[i]    : ElementHealth::NO_DATA_VAL;
-        m_data[q][i].current     = (i < currents.size()) ? currents[i] : ElementHealth::NO_DATA_VAL;
-    }
-    rebuildStats();
-    emit quadrantUpdated(q);
+    if (!validQuad(q)) return;
+    const int n = m_cfg.elementsPerQuadrant;
+    QVector<float> sp, st, sc;
+    writeQuadrant(q, padded(powers, n, sp), padded(temps, n, st), padded(currents, n, sc));
+    touched(quadBit(q));
 }
 
 void RadarModel::setAllQuadrants(const QVector<QVector<float>> &powers,
                                  const QVector<QVector<float>> &temps,
                                  const QVector<QVector<float>> &currents)
 {
-    for (int q = 0; q < m_data.size(); ++q) {
-        int n = m_data[q].size();
-        for (int i = 0; i < n; ++i) {
-            m_data[q][i].power       = (q < powers.size()   && i < powers[q].size())   ? powers[q][i]   : ElementHealth::NO_DATA_VAL;
-            m_data[q][i].temperature = (q < temps.size()    && i < temps[q].size())    ? temps[q][i]    : ElementHealth::NO_DATA_VAL;
-            m_data[q][i].current     = (q < currents.size() && i < currents[q].size()) ? currents[q][i] : ElementHealth::NO_DATA_VAL;
+    const int n = m_cfg.elementsPerQuadrant;
+    const QVector<float> none;
+    QVector<float> sp, st, sc;
+    for (int q = 0; q < m_cfg.quadrants; ++q) {
+        writeQuadrant(q, padded(q < powers.size()   ? powers[q]   : none, n, sp),
+                         padded(q < temps.size()    ? temps[q]    : none, n, st),
+                         padded(q < currents.size() ? currents[q] : none, n, sc));
+    }
+    touched(allQuadsMask());
+}
+
+// ── Raw ingestion ────────────────────────────────────────────────────────────
+// The triplets are 6-byte strided u16s, which SSE2 cannot gather cheaply;
+// the loop is branch-free so the compiler vectorises the convert/divide.
+// Division (not multiplication by 0.01f) keeps results bit-identical to
+// decodePower() and therefore to the threshold boundaries.
+static void decodeTriplets(const uchar *src, int n, float *P, float *T, float *C)
+{
+    for (int i = 0; i < n; ++i, src += 6) {
+        P[i] = RadarModel::decodePower  (quint16(src[0] | (src[1] << 8)));
+        T[i] = RadarModel::decodeTemp   (quint16(src[2] | (src[3] << 8)));
+        C[i] = RadarModel::decodeCurrent(quint16(src[4] | (src[5] << 8)));
+    }
+}
+
+static quint32 readU32(const uchar *p)
+{
+    return quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24);
+}
+
+void RadarModel::setElementRaw(int q, int le, const uchar *t)
+{
+    setElement(q, le, decodePower  (quint16(t[0] | (t[1] << 8))),
+                      decodeTemp   (quint16(t[2] | (t[3] << 8))),
+                      decodeCurrent(quint16(t[4] | (t[5] << 8))));
+}
+
+bool RadarModel::setQuadrantRaw(int q, const uchar *triplets, int len)
+{
+    const int epq = m_cfg.elementsPerQuadrant;
+    if (len < epq * 6) return false;
+    if (!validQuad(q)) return true;      // well-formed, addressed elsewhere
+
+    float *P = m_decoded.data(), *T = P + epq, *C = T + epq;
+    decodeTriplets(triplets, epq, P, T, C);
+    writeQuadrant(q, P, T, C);
+    touched(quadBit(q));
+    return true;
+}
+
+bool RadarModel::setAllQuadrantsRaw(const uchar *triplets, int len)
+{
+    const int epq = m_cfg.elementsPerQuadrant;
+    if (len < m_cfg.quadrants * epq * 6) return false;
+
+    float *P = m_decoded.data(), *T = P + epq, *C = T + epq;
+    for (int q = 0; q < m_cfg.quadrants; ++q) {
+        decodeTriplets(triplets + q * epq * 6, epq, P, T, C);
+        writeQuadrant(q, P, T, C);
+    }
+    touched(allQuadsMask());
+    return true;
+}
+
+// Run list: runCount × [start gid:u32][count:u16][count × triplet]. The
+// whole list is validated before anything is written so a truncated or
+// out-of-range packet leaves the model untouched.
+bool RadarModel::setElementRunsRaw(const uchar *runs, int len, int runCount)
+{
+    const int total = m_cfg.totalElements();
+    int off = 0;
+    for (int r = 0; r < runCount; ++r) {
+        if (len - off < 6) return false;
+        const uchar *h = runs + off;
+        const quint32 start = readU32(h);
+        const int     count = h[4] | (h[5] << 8);
+        if (start > quint32(total) || count > total - int(start)) return false;
+        if (len - off - 6 < count * 6) return false;
+        off += 6 + count * 6;
+    }
+
+    const int epq = m_cfg.elementsPerQuadrant;
+    quint32 quadMask = 0;
+    off = 0;
+    for (int r = 0; r < runCount; ++r) {
+        const uchar *h = runs + off;
+        const int start = int(readU32(h));
+        const int count = h[4] | (h[5] << 8);
+        const uchar *t = h + 6;
+        for (int g = start; g < start + count; ++g, t += 6) {
+            writeElement(g, decodePower  (quint16(t[0] | (t[1] << 8))),
+                            decodeTemp   (quint16(t[2] | (t[3] << 8))),
+                            decodeCurrent(quint16(t[4] | (t[5] << 8))));
+        }
+        if (count > 0) {
+            for (int q = start / epq; q <= (start + count - 1) / epq; ++q) {
+                quadMask |= quadBit(q);
+                m_quadFresh[q] = 1;
+            }
         }
+        off += 6 + count * 6;
     }
-    rebuildStats();
-    for (int q = 0; q < m_data.size(); ++q)
-        emit quadrantUpdated(q);
+    touched(quadMask);
+    return true;
+}
+
+// ── Freshness ────────────────────────────────────────────────────────────────
+void RadarModel::setStaleAfterMs(int ms)
+{
+    ms = qMax(0, ms);
+    if (ms == m_staleAfterMs) return;
+    m_staleAfterMs = ms;
+    QMetaObject::invokeMethod(m_writer, [this, ms]() {
+        if (ms > 0) {
+            m_staleTimer->start(qMax(50, ms / int(kStaleGenerations)));
+        } else {
+            m_staleTimer->stop();
+        }
+    });
+    emit staleAfterMsChanged();
+}
+
+void RadarModel::sweepStale()
+{
+    ++m_generation;
+    const int total = m_status.size();
+    const quint32 *gen = m_refreshGen.constData();
+    quint32 quadMask = 0;
+    int demoted = 0;
+    for (int g = 0; g < total; ++g) {
+        // at(): the first demotion detaches m_status from the last snapshot
+        if (m_status.at(g) == ElementHealth::NoData || m_generation - gen[g] <= kStaleGenerations) continue;
+        writeElement(g, ElementHealth::NO_DATA_VAL, ElementHealth::NO_DATA_VAL, ElementHealth::NO_DATA_VAL);
+        quadMask |= quadBit(g / m_cfg.elementsPerQuadrant);
+        ++demoted;
+    }
+    if (!demoted) return;
+
+    // Not an update: the quadrant timestamps keep showing when data last came in
+    m_staleDemotions += demoted;
+    ++m_dataVersion;
+    scheduleFrame(quadMask);
+}
+
+// ── Per-element history ──────────────────────────────────────────────────────
+void RadarModel::setHistoryFormat(int sampleMs, int depth)
+{
+    m_historySampleMs = qMax(10, sampleMs);
+    m_elemHistory.configure(m_cfg.totalElements(), qMax(1, depth));
+    m_sampleTimer->start(m_historySampleMs);
+    emit historyFormatChanged();
+    emit elementHistoryChanged();
+}
+
+void RadarModel::sampleElementHistory()
+{
+    const RadarSnapshot &f = *m_front;
+    if (f.lastUpdateMs == 0) return;      // nothing received yet
+    m_elemHistory.record(QDateTime::currentMSecsSinceEpoch(),
+                         f.power.constData(), f.temp.constData(), f.current.constData());
+    emit elementHistoryChanged();
+}
+
+// First sample index of the last `samples` held (all if samples ≤ 0)
+static int windowStart(const ElementHistory &h, int samples)
+{
+    return (samples > 0 && samples < h.size()) ? h.size() - samples : 0;
+}
+
+static QVariantList timesList(const ElementHistory &h, int first)
+{
+    QVariantList t;
+    t.reserve(h.size() - first);
+    for (int i = first; i < h.size(); ++i)
+        t.append(double(h.time(i)));
+    return t;
+}
+
+QVariantMap RadarModel::elementHistory(int q, int le, int samples) const
+{
+    QVariantMap m;
+    if (!validQuad(q) || le < 0 || le >= m_cfg.elementsPerQuadrant) return m;
+    const int g = quadBase(q) + le;
+    const ElementHistory &h = m_elemHistory;
+    const int first = windowStart(h, samples);
+
+    static const char *const key[3] = { "power", "temp", "current" };
+    for (int k = 0; k < 3; ++k) {
+        const auto p = ElementHistory::Param(k);
+        QVariantList v;
+        v.reserve(h.size() - first);
+        for (int i = first; i < h.size(); ++i)
+            v.append(double(ElementHistory::dequantize(p, h.row(i, p)[g])));
+        m[key[k]] = v;
+    }
+    m["times"] = timesList(h, first);
+    return m;
+}
+
+QVariantMap RadarModel::elementEnvelope(int q, int le, int samples) const
+{
+    QVariantMap m;
+    if (!validQuad(q) || le < 0 || le >= m_cfg.elementsPerQuadrant) return m;
+    const int g = quadBase(q) + le;
+    const ElementHistory &h = m_elemHistory;
+    const int first = windowStart(h, samples);
+
+    static const char *const minKey[3] = { "minPower", "minTemp", "minCurrent" };
+    static const char *const maxKey[3] = { "maxPower", "maxTemp", "maxCurrent" };
+    for (int k = 0; k < 3; ++k) {
+        const auto p = ElementHistory::Param(k);
+        quint16 lo = ElementHistory::kNoData, hi = 0;
+        bool any = false;
+        for (int i = first; i < h.size(); ++i) {
+            const quint16 raw = h.row(i, p)[g];
+            if (raw == ElementHistory::kNoData) continue;
+            lo = qMin(lo, raw);
+            hi = qMax(hi, raw);
+            any = true;
+        }
+        // Quantization is monotonic, so the raw extremes decode to the value extremes
+        m[minKey[k]] = any ? double(ElementHistory::dequantize(p, lo)) : -999.0;
+        m[maxKey[k]] = any ? double(ElementHistory::dequantize(p, hi)) : -999.0;
+    }
+    return m;
+}
+
+QVariantMap RadarModel::clusterHistory(int q, int c, int samples) const
+{
+    QVariantMap m;
+    int begin, count;
+    clusterRange(q, c, begin, count);
+    if (count == 0) return m;
+    const ElementHistory &h = m_elemHistory;
+    const int first = windowStart(h, samples);
+
+    static const char *const avgKey[3] = { "avgPower", "avgTemp", "avgCurrent" };
+    static const char *const minKey[3] = { "minPower", "minTemp", "minCurrent" };
+    static const char *const maxKey[3] = { "maxPower", "maxTemp", "maxCurrent" };
+    for (int k = 0; k < 3; ++k) {
+        const auto p = ElementHistory::Param(k);
+        QVariantList avg, mn, mx;
+        avg.reserve(h.size() - first);
+        mn.reserve(h.size() - first);
+        mx.reserve(h.size() - first);
+        for (int i = first; i < h.size(); ++i) {
+            const quint16 *r = h.row(i, p) + begin;
+            quint32 sum = 0;
+            int valid = 0;
+            quint16 lo = ElementHistory::kNoData, hi = 0;
+            for (int e = 0; e < count; ++e) {
+                const quint16 raw = r[e];
+                if (raw == ElementHistory::kNoData) continue;
+                sum += raw;
+                ++valid;
+                lo = qMin(lo, raw);
+                hi = qMax(hi, raw);
+            }
+            // The scaling is affine, so decoding the mean raw value matches
+            // the mean of the decoded values to within one quantization step
+            avg.append(valid ? double(ElementHistory::dequantize(p, quint16(qRound(double(sum) / valid)))) : -999.0);
+            mn.append(valid ? double(ElementHistory::dequantize(p, lo)) : -999.0);
+            mx.append(valid ? double(ElementHistory::dequantize(p, hi)) : -999.0);
+        }
+        m[avgKey[k]] = avg;
+        m[minKey[k]] = mn;
+        m[maxKey[k]] = mx;
+    }
+    m["times"] = timesList(h, first);
+    return m;
 }
 
 // ── History snapshot ─────────────────────────────────────────────────────────
 void RadarModel::snapshotHistory()
 {
-    int total = m_healthy + m_warning + m_critical + m_noData;
-    int pct   = (total > 0 && (total - m_noData) > 0)
-                ? (m_healthy * 100) / (total - m_noData)
+    const int *c = m_front->counts;
+    int total = c[ElementHealth::Healthy] + c[ElementHealth::Warning] + c[ElementHealth::Critical] + c[ElementHealth::NoData];
+    int pct   = (total > 0 && (total - c[ElementHealth::NoData]) > 0)
+                ? (c[ElementHealth::Healthy] * 100) / (total - c[ElementHealth::NoData])
                 : -1;
     m_history.append(pct);
     if (m_history.size() > 60)
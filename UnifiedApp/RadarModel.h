@@ -5,7 +5,13 @@
 #include <QVariantMap>
 #include <QTimer>
 #include <QDateTime>
+#include <QByteArray>
+#include <QSharedPointer>
+#include <set>
 #include "AntennaConfig.h"
+#include "ElementHistory.h"
+
+class QThread;
 
 // ─────────────────────────────────────────────────────────────────────────────
 // ElementHealth — three physical parameters per antenna element
@@ -19,36 +25,36 @@ struct ElementHealth {
     float temperature = NO_DATA_VAL;   // °C   — element temperature
     float current     = NO_DATA_VAL;   // A    — supply current draw
 
-    // ── Thresholds ────────────────────────────────────────────────
+    // ── Thresholds (per antenna, ElementThresholds defaults) ──────
     // Power  : HEALTHY ≥ 43 dBm | WARNING 40–43 | CRITICAL < 40
     // Temp   : HEALTHY ≤ 45 °C  | WARNING 45–50 | CRITICAL > 50
     // Current: HEALTHY ≤ 1.8 A  | WARNING 1.8–2 | CRITICAL > 2
     enum Status { NoData = 0, Healthy = 1, Warning = 2, Critical = 3 };
 
-    static Status powerStatus(float p) {
-        if (p == NO_DATA_VAL) return NoData;
-        if (p >= 43.0f)       return Healthy;
-        if (p >= 40.0f)       return Warning;
+    static Status powerStatus(float p, const ElementThresholds &th = ElementThresholds()) {
+        if (p == NO_DATA_VAL)   return NoData;
+        if (p >= th.powerWarn)  return Healthy;
+        if (p >= th.powerCrit)  return Warning;
         return Critical;
     }
-    static Status tempStatus(float t) {
-        if (t == NO_DATA_VAL) return NoData;
-        if (t <= 45.0f)       return Healthy;
-        if (t <= 50.0f)       return Warning;
+    static Status tempStatus(float t, const ElementThresholds &th = ElementThresholds()) {
+        if (t == NO_DATA_VAL)   return NoData;
+        if (t <= th.tempWarn)   return Healthy;
+        if (t <= th.tempCrit)   return Warning;
         return Critical;
     }
-    static Status currentStatus(float c) {
-        if (c == NO_DATA_VAL) return NoData;
-        if (c <= 1.8f)        return Healthy;
-        if (c <= 2.0f)        return Warning;
+    static Status currentStatus(float c, const ElementThresholds &th = ElementThresholds()) {
+        if (c == NO_DATA_VAL)    return NoData;
+        if (c <= th.currentWarn) return Healthy;
+        if (c <= th.currentCrit) return Warning;
         return Critical;
     }
 
     // Overall status = worst of the three
-    Status overall() const {
-        Status ps = powerStatus(power);
-        Status ts = tempStatus(temperature);
-        Status cs = currentStatus(current);
+    Status overall(const ElementThresholds &th = ElementThresholds()) const {
+        Status ps = powerStatus(power, th);
+        Status ts = tempStatus(temperature, th);
+        Status cs = currentStatus(current, th);
         return static_cast<Status>(qMax(int(ps), qMax(int(ts), int(cs))));
     }
 
@@ -56,6 +62,16 @@ struct ElementHealth {
         return power != NO_DATA_VAL || temperature != NO_DATA_VAL || current != NO_DATA_VAL;
     }
 
+    // Same thresholds as a single branch-free expression (see
+    // RadarModel::classify for the vectorised form): NO_DATA contributes 0,
+    // every other value 1..3, and the element status is the max of the three.
+    static Status classify(float p, float t, float c, const ElementThresholds &th = ElementThresholds()) {
+        int ps = (p == NO_DATA_VAL) ? 0 : 3 - int(p >= th.powerCrit) - int(p >= th.powerWarn);
+        int ts = (t == NO_DATA_VAL) ? 0 : 1 + int(t > th.tempWarn)    + int(t > th.tempCrit);
+        int cs = (c == NO_DATA_VAL) ? 0 : 1 + int(c > th.currentWarn) + int(c > th.currentCrit);
+        return static_cast<Status>(qMax(ps, qMax(ts, cs)));
+    }
+
     // Health score 0-100 used for aggregate %
     int healthScore() const {
         switch (overall()) {
@@ -67,8 +83,108 @@ struct ElementHealth {
     }
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+// RadarSnapshot — one published frame of a RadarModel
+//
+// Everything the model's read API answers from: the element arrays, the
+// antenna / quadrant / cluster query results and the worst-element order.
+// Built by the write side when a frame is published and never modified
+// afterwards, so it can be read from any thread while a reference is held.
+// The arrays are implicitly shared with the writer's working copies; the
+// first write after publishing detaches them (one copy per frame).
+// ─────────────────────────────────────────────────────────────────────────────
+struct RadarSnapshot {
+    // Query results for one node of the antenna → quadrant → cluster tree
+    struct Node {
+        float        min[3];         // power, temperature, current over valid values
+        float        max[3];         // (min > max if there is none)
+        int          health = -1;
+        QVariantList stats;
+        QVariantMap  metrics;
+    };
+
+    QVector<quint8> status;          // [gid] ElementHealth::Status
+    QVector<float>  power;           // [gid] dBm
+    QVector<float>  temp;            // [gid] °C
+    QVector<float>  current;         // [gid] A
+    Node            antenna;
+    QVector<Node>   quadrants;       // [q]
+    QVector<Node>   clusters;        // [q * cluster slots + c]
+    QVector<int>    worst;           // warning / critical gids, worst first
+    QVector<qint64> quadUpdateMs;    // [q] ms since epoch (0 = never)
+    QByteArray      clusterMask;     // [cluster slot] written during this frame
+
+    int     counts[4]      = {0, 0, 0, 0};   // by ElementHealth::Status
+    qint64  lastUpdateMs   = 0;              // 0 = no data yet
+    quint32 dataVersion    = 0;
+    int     staleDemotions = 0;
+    quint32 quadMask       = 0;              // quadrants written during this frame
+    int     notifications  = 0;              // signals the per-write path would have sent
+};
+typedef QSharedPointer<const RadarSnapshot> RadarSnapshotPtr;
+
 // ─────────────────────────────────────────────────────────────────────────────
 // RadarModel
+//
+// Element storage is structure-of-arrays: one contiguous float array per
+// parameter plus a packed status byte per element, all indexed by global
+// element id (quad * elementsPerQuadrant + local). Statuses are classified
+// once when values are written (8 elements per step with SSE2).
+//
+// Counts and metric sums are maintained incrementally: every write applies
+// the difference between the element's old and new values / status to the
+// global counters and to its quadrant and cluster Aggregate. A 0x10 single
+// element update is O(1), bulk updates only touch elements whose values
+// changed, and the count / health / average queries read the aggregates.
+//
+// On top of that sits a cache tree (antenna → quadrant → cluster): a write
+// flags its cluster, and publishing a frame refreshes just the flagged
+// clusters (min/max from their elements), their quadrants and the antenna
+// (from their children), storing ready-made QVariant results so QML calls
+// per repaint / hover return cached values.
+//
+// Freshness: every write stamps the element with the current stale-sweep
+// generation and the quadrant with the wall-clock time (quadrantUpdateTimes).
+// The sweep runs every staleAfterMs / 4 and demotes elements not refreshed
+// for more than four generations (staleAfterMs .. 1.25 × staleAfterMs) to
+// NoData, so a silent sender shows up as missing data rather than frozen
+// values.
+//
+// Worst elements: warning / critical elements are kept in an ordered index
+// (status, then lowest power) updated whenever an element's status or power
+// changes, so worstElements(n) walks the first n entries. worstElementsBy()
+// ranks by one metric using the cluster min/max cache to skip clusters that
+// cannot contain a candidate.
+//
+// Per-element history: every historySampleMs the element arrays are
+// quantized into an ElementHistory ring of historyDepth samples, queried
+// with elementHistory / elementEnvelope / clusterHistory.
+//
+// Change notification: writes do not signal directly. They accumulate a
+// dirty quadrant mask and per-cluster flags, and one frame is published per
+// notifyIntervalMs (default 16 ms, about one 60 Hz display frame): a single
+// statsChanged, one quadrantUpdated per dirty quadrant, then
+// frameUpdated(quadrantMask). suppressedNotifications counts the
+// statsChanged / quadrantUpdated emissions folded away; 0 ms publishes on
+// every write as before.
+//
+// Write side / read side: the write side (ingestion, the stale sweep and
+// frame publishing) works on private arrays and publishes each frame as an
+// immutable RadarSnapshot. Every read (properties, LOD queries, element
+// access, history sampling) answers from the current snapshot, so QML sees
+// one consistent frame and never a half-applied packet. By default both
+// sides run on the model's thread. setWriteThread() moves the write side to
+// an ingest thread (UdpReceiver::setIngestThread does this): frames are then
+// built there and handed over by a queued call that swaps the snapshot
+// pointer and emits the signals on the model's thread, so neither side
+// takes a lock. Writes must then come from the write thread only.
+//
+// QML export: dataVersion counts element writes (ingest batches and stale
+// sweeps). statusBuffer / powerBuffer / tempBuffer / currentBuffer are
+// packed snapshots indexed by global id (one status byte or float32 per
+// element), refreshed with one memcpy on the first read after a version
+// change; QML sees them as ArrayBuffers sharing that copy. elementStatus /
+// elementValue read one element without building a list.
 // ─────────────────────────────────────────────────────────────────────────────
 class RadarModel : public QObject
 {
@@ -81,6 +197,7 @@ class RadarModel : public QObject
     Q_PROPERTY(int      clustersPerQuadrant   READ clustersPerQuadrant   CONSTANT)
     Q_PROPERTY(int      totalElements         READ totalElements         CONSTANT)
     Q_PROPERTY(int      udpPort               READ udpPort               CONSTANT)
+    Q_PROPERTY(QVariantMap thresholds         READ thresholdMap          CONSTANT)   // powerWarn, powerCrit, ...
 
     Q_PROPERTY(int      healthyCount  READ healthyCount  NOTIFY statsChanged)
     Q_PROPERTY(int      warningCount  READ warningCount  NOTIFY statsChanged)
@@ -88,9 +205,35 @@ class RadarModel : public QObject
     Q_PROPERTY(int      noDataCount   READ noDataCount   NOTIFY statsChanged)
     Q_PROPERTY(QString  lastUpdateTime READ lastUpdateTime NOTIFY statsChanged)
     Q_PROPERTY(QVariantList healthHistory READ healthHistory NOTIFY historyChanged)
+    // ms since epoch of the last update per quadrant (0 = never)
+    Q_PROPERTY(QVariantList quadrantUpdateTimes READ quadrantUpdateTimes NOTIFY statsChanged)
+    Q_PROPERTY(int      staleAfterMs   READ staleAfterMs   WRITE setStaleAfterMs NOTIFY staleAfterMsChanged)
+    Q_PROPERTY(int      staleDemotions READ staleDemotions NOTIFY statsChanged)
+    Q_PROPERTY(int      historySampleMs READ historySampleMs NOTIFY historyFormatChanged)
+    Q_PROPERTY(int      historyDepth    READ historyDepth    NOTIFY historyFormatChanged)
+    Q_PROPERTY(int      historySamples  READ historySamples  NOTIFY elementHistoryChanged)
+    Q_PROPERTY(int        dataVersion   READ dataVersion   NOTIFY statsChanged)
+    Q_PROPERTY(int        notifyIntervalMs        READ notifyIntervalMs WRITE setNotifyIntervalMs NOTIFY notifyIntervalMsChanged)
+    Q_PROPERTY(int        framesPublished         READ framesPublished         NOTIFY frameUpdated)
+    Q_PROPERTY(int        suppressedNotifications READ suppressedNotifications NOTIFY frameUpdated)
+    // One byte per cluster slot (q * clusterSlots + c): written during the last frame
+    Q_PROPERTY(QByteArray frameClusterMask        READ frameClusterMask        NOTIFY frameUpdated)
+    Q_PROPERTY(QByteArray statusBuffer  READ statusBuffer  NOTIFY statsChanged)   // u8 per element
+    Q_PROPERTY(QByteArray powerBuffer   READ powerBuffer   NOTIFY statsChanged)   // float32 per element
+    Q_PROPERTY(QByteArray tempBuffer    READ tempBuffer    NOTIFY statsChanged)
+    Q_PROPERTY(QByteArray currentBuffer READ currentBuffer NOTIFY statsChanged)
 
 public:
     explicit RadarModel(const AntennaConfig &cfg, QObject *parent = nullptr);
+    ~RadarModel() override;
+
+    /** Run the write side on @p thread (nullptr = the model's own thread).
+     *  Blocks if the write side currently lives on another running thread. */
+    void setWriteThread(QThread *thread);
+    bool writeThreaded() const;
+
+    /** The frame the read API currently answers from. */
+    RadarSnapshotPtr snapshot() const { return m_front; }
 
     // Config accessors
     QString antennaName()         const { return m_cfg.name; }
@@ -100,40 +243,89 @@ public:
     int     clustersPerQuadrant() const { return m_cfg.clustersPerQuadrant(); }
     int     totalElements()       const { return m_cfg.totalElements(); }
     int     udpPort()             const { return m_cfg.udpPort; }
+    const ElementThresholds &thresholds() const { return m_cfg.thresholds; }
+    QVariantMap thresholdMap() const;
 
     // Global counts
-    int     healthyCount()  const { return m_healthy; }
-    int     warningCount()  const { return m_warning; }
-    int     criticalCount() const { return m_critical; }
-    int     noDataCount()   const { return m_noData; }
-    QString lastUpdateTime() const { return m_lastUpdate; }
+    int     healthyCount()  const { return m_front->counts[ElementHealth::Healthy]; }
+    int     warningCount()  const { return m_front->counts[ElementHealth::Warning]; }
+    int     criticalCount() const { return m_front->counts[ElementHealth::Critical]; }
+    int     noDataCount()   const { return m_front->counts[ElementHealth::NoData]; }
+    QString lastUpdateTime() const;
     QVariantList healthHistory() const { return m_history; }
+    QVariantList quadrantUpdateTimes() const;
+
+    int     staleAfterMs()   const { return m_staleAfterMs; }
+    void    setStaleAfterMs(int ms);
+    int     staleDemotions() const { return m_front->staleDemotions; }
+
+    int     historySampleMs() const { return m_historySampleMs; }
+    int     historyDepth()    const { return m_elemHistory.depth(); }
+    int     historySamples()  const { return m_elemHistory.size(); }
+    // Reallocates and clears the per-element history
+    Q_INVOKABLE void setHistoryFormat(int sampleMs, int depth);
+
+    int        notifyIntervalMs()        const { return m_notifyIntervalMs; }
+    void       setNotifyIntervalMs(int ms);
+    int        framesPublished()         const { return m_framesPublished; }
+    int        suppressedNotifications() const { return m_suppressed; }
+    QByteArray frameClusterMask()        const { return m_front->clusterMask; }
+
+    int        dataVersion()   const { return int(m_front->dataVersion); }
+    QByteArray statusBuffer()  const { return exportBuffer(0); }
+    QByteArray powerBuffer()   const { return exportBuffer(1); }
+    QByteArray tempBuffer()    const { return exportBuffer(2); }
+    QByteArray currentBuffer() const { return exportBuffer(3); }
+
+    // ── LOD0: whole antenna ────────────────────────────────────────
+    Q_INVOKABLE int          antennaHealth() const;
+    // Same keys as quadrantMetrics
+    Q_INVOKABLE QVariantMap  antennaMetrics() const;
 
     // ── LOD1: per-quadrant ─────────────────────────────────────────
     // Returns 0-100 health%  (-1 if all no-data)
     Q_INVOKABLE int          quadrantHealth(int q) const;
     // Returns [healthy, warning, critical, nodata] counts
     Q_INVOKABLE QVariantList quadrantStats(int q) const;
-    // Returns {avgPower, avgTemp, avgCurrent, minPower, maxTemp, maxCurrent}
+    // Returns {avgPower, avgTemp, avgCurrent, minPower, maxPower, minTemp,
+    //          maxTemp, minCurrent, maxCurrent}  (-999 where no data)
     Q_INVOKABLE QVariantMap  quadrantMetrics(int q) const;
 
     // ── LOD2: per-cluster ──────────────────────────────────────────
     Q_INVOKABLE int          clusterHealth(int q, int c) const;
     Q_INVOKABLE QVariantList clusterStats(int q, int c) const;
+    // Same keys as quadrantMetrics
     Q_INVOKABLE QVariantMap  clusterMetrics(int q, int c) const;
 
     // ── LOD3 / Full: element arrays ───────────────────────────────
-    // Returns status int (0=NoData,1=Healthy,2=Warning,3=Critical) per element
+    // Returns status int (0=NoData,1=Healthy,2=Warning,3=Critical) per element.
+    // Builds a new list per call; per-frame QML code uses statusBuffer / elementStatus
     Q_INVOKABLE QVariantList quadrantData(int q) const;
     Q_INVOKABLE QVariantList clusterData(int q, int c) const;
 
     // ── Per-element detail ─────────────────────────────────────────
     Q_INVOKABLE QVariantMap  elementDetail(int q, int localElem) const;
+    // By global id, without allocating: status (NoData if out of range) and
+    // param 0 = power, 1 = temperature, 2 = current (-999 if out of range)
+    Q_INVOKABLE int          elementStatus(int gid) const;
+    Q_INVOKABLE double       elementValue(int gid, int param) const;
 
     // ── Analytics ─────────────────────────────────────────────────
     Q_INVOKABLE QVariantList worstElements(int n = 8) const;
+    // metric: "power" (lowest first), "temp" or "current" (highest first);
+    // anything else falls back to worstElements. Same entry keys.
+    Q_INVOKABLE QVariantList worstElementsBy(const QString &metric, int n = 8) const;
+
+    // ── Per-element history (oldest first; samples ≤ 0 = all held) ─
+    // {times, power, temp, current}  (-999 where no data)
+    Q_INVOKABLE QVariantMap  elementHistory(int q, int localElem, int samples = 0) const;
+    // {minPower, maxPower, minTemp, maxTemp, minCurrent, maxCurrent} over the window
+    Q_INVOKABLE QVariantMap  elementEnvelope(int q, int localElem, int samples = 0) const;
+    // Per sample across the cluster: {times, avgPower, minPower, maxPower,
+    //   avgTemp, minTemp, maxTemp, avgCurrent, minCurrent, maxCurrent}
+    Q_INVOKABLE QVariantMap  clusterHistory(int q, int c, int samples = 0) const;
 
-    // ── Data ingestion (called by UdpReceiver) ─────────────────────
+    // ── Data ingestion (called by UdpReceiver, on the write thread) ─
     // Update a single element
     void setElement(int quad, int localElem, float power, float temp, float current);
     // Update entire quadrant at once
@@ -146,27 +338,167 @@ public:
                          const QVector<QVector<float>> &temps,
                          const QVector<QVector<float>> &currents);
 
+    // ── Raw ingestion (wire format, see UdpReceiver.h) ─────────────
+    // Payloads are packed little-endian u16 triplets [pwr][tmp][cur];
+    // they are decoded straight into preallocated buffers with no
+    // per-packet allocation. Return false if the payload is too short.
+    void setElementRaw(int quad, int localElem, const uchar *triplet);
+    bool setQuadrantRaw(int quad, const uchar *triplets, int len);
+    bool setAllQuadrantsRaw(const uchar *triplets, int len);
+    // Sparse update from a 0x13 delta run list or a 0x15 chunk; false (and
+    // nothing applied) if any run is truncated or falls outside the array
+    bool setElementRunsRaw(const uchar *runs, int len, int runCount);
+
+    static float decodePower  (quint16 raw) { return raw / 100.0f - 10.0f; }
+    static float decodeTemp   (quint16 raw) { return raw / 10.0f; }
+    static float decodeCurrent(quint16 raw) { return raw / 1000.0f; }
+
+    /** Classify n elements into out[] (ElementHealth::Status bytes). */
+    static void classify(const float *power, const float *temp, const float *current,
+                         quint8 *out, int n, const ElementThresholds &th = ElementThresholds());
+
+    // ── Packed element arrays for C++ renderers, indexed by global id ──
+    // Current snapshot; read on the GUI thread, or on the render thread during sync
+    const quint8 *statusData()  const { return m_front->status.constData(); }
+    const float  *powerData()   const { return m_front->power.constData(); }
+    const float  *tempData()    const { return m_front->temp.constData(); }
+    const float  *currentData() const { return m_front->current.constData(); }
+
 signals:
     void statsChanged();
     void historyChanged();
     void quadrantUpdated(int q);
+    // Bit q set if quadrant q was written during the frame (quadrants ≥ 31 share bit 31)
+    void frameUpdated(int quadrantMask);
+    void notifyIntervalMsChanged();
+    void staleAfterMsChanged();
+    void elementHistoryChanged();
+    void historyFormatChanged();
 
 private slots:
     void snapshotHistory();
+    void sampleElementHistory();
+    // Write thread: build a snapshot of everything written since the last frame
+    void publishFrame();
 
 private:
-    void rebuildStats();
-    static int calcHealth(const QVector<ElementHealth> &elems, int start, int count);
+    // Running totals for one scope (quadrant or cluster)
+    struct Aggregate {
+        int    counts[4] = {0, 0, 0, 0};   // by ElementHealth::Status
+        double sum[3]    = {0, 0, 0};      // power, temperature, current (valid values only)
+        int    valid[3]  = {0, 0, 0};
+    };
+    typedef RadarSnapshot::Node Node;
+
+    // ── Write side (write thread) ──────────────────────────────────
+    // Write one full quadrant from contiguous arrays, applying deltas only
+    // for changed elements; returns true if anything changed
+    bool writeQuadrant(int q, const float *P, const float *T, const float *C);
+    // Write one element by global id: aggregates, status and dirty flags
+    void writeElement(int g, float power, float temp, float current);
+    void applyStatus(int g, quint8 status);
+    void reindexWorst(int g);
+    // Stamp the update times, bump dataVersion and schedule a frame
+    void touched(quint32 quadMask);
+    void scheduleFrame(quint32 quadMask);
+    void sweepStale();
+    static quint32 quadBit(int q) { return 1u << qMin(q, 31); }
+    quint32 allQuadsMask() const;
+    static int  calcHealth(const Aggregate &a);
+    static void applyValue(Aggregate &a, int param, float oldV, float newV);
+    int  clusterSlot(int q, int c) const { return q * m_clusterSlots + c; }
+
+    void markDirty(int q, int cluster);
+    // Refresh the nodes of every cluster flagged since the last frame
+    void refreshNodes();
+    void refreshCluster(int q, int c);
+    static void finishNode(Node &n, const Aggregate &a);
+    RadarSnapshotPtr buildSnapshot();
+
+    // ── Read side (model thread) ───────────────────────────────────
+    void adoptFrame(const RadarSnapshotPtr &frame);
+    QVariantMap elementEntry(int g) const;
+    QByteArray exportBuffer(int which) const;
+
+    bool validQuad(int q) const { return q >= 0 && q < m_cfg.quadrants; }
+    int  quadBase(int q) const  { return q * m_cfg.elementsPerQuadrant; }
+    // Cluster c of quadrant q, clipped to the quadrant; count 0 if out of range
+    void clusterRange(int q, int c, int &begin, int &count) const;
+
+    AntennaConfig   m_cfg;
+    int             m_clusterSlots = 0;   // clusters per quadrant incl. a partial last one
 
-    AntennaConfig               m_cfg;
-    QVector<QVector<ElementHealth>> m_data; // [quad][elem]
+    // Write side. m_writer is the context object of the write-side timers
+    // and lives on the write thread; everything below up to the read side
+    // is touched only from there.
+    QObject        *m_writer = nullptr;
+    QVector<float>  m_power;     // [gid] dBm
+    QVector<float>  m_temp;      // [gid] °C
+    QVector<float>  m_current;   // [gid] A
+    QVector<quint8> m_status;    // [gid] ElementHealth::Status
+    QVector<quint8> m_scratch;   // classification buffer for one quadrant
+    QVector<float>  m_decoded;   // raw decode buffer: 3 × elementsPerQuadrant
 
-    int     m_healthy  = 0;
-    int     m_warning  = 0;
-    int     m_critical = 0;
-    int     m_noData   = 0;
-    QString m_lastUpdate;
+    QVector<Aggregate> m_quadAgg;            // [q]
+    QVector<Aggregate> m_clusterAgg;         // [q * m_clusterSlots + c]
+    QVector<Node>      m_quadNodes;          // [q]    as of the last frame
+    QVector<Node>      m_clusterNodes;       // [slot] as of the last frame
+    Node               m_antennaNode;
+
+    int     m_counts[4]    = {0, 0, 0, 0};   // by ElementHealth::Status
+    qint64  m_lastUpdateMs = 0;              // 0 = no data yet
+    quint32 m_dataVersion  = 0;
+
+    // Worst-element index: warning / critical only
+    struct WorstKey {
+        quint8 status;
+        float  power;    // NO_DATA sorts last
+        int    gid;
+        bool operator<(const WorstKey &o) const {
+            if (status != o.status) return status > o.status;
+            if (power != o.power)   return power < o.power;
+            return gid < o.gid;
+        }
+    };
+    std::set<WorstKey> m_worst;
+    QVector<quint8>    m_worstStatus;   // [gid] status indexed under (< Warning = not indexed)
+    QVector<float>     m_worstPower;    // [gid] power key indexed under
+    QVector<int>       m_worstOrder;    // m_worst's gids as of the last frame
+    bool               m_worstChanged = false;
+
+    // Freshness
+    static const quint32 kStaleGenerations = 4;
+    QVector<quint32> m_refreshGen;   // [gid] sweep generation of the last write
+    QVector<qint64>  m_quadUpdateMs; // [q]
+    QVector<quint8>  m_quadFresh;    // [q] written since the last touched()
+    quint32 m_generation     = 0;
+    int     m_staleDemotions = 0;
+    QTimer *m_staleTimer     = nullptr;
+
+    // Frame coalescing
+    QTimer         *m_frameTimer       = nullptr;
+    quint32         m_frameQuads       = 0;     // dirty quadrant bits since the last frame
+    QVector<quint8> m_frameClusters;            // [cluster slot] written since the last frame
+    int             m_pendingNotifies  = 0;     // signals the old per-write path would have sent
+
+    // Read side
+    RadarSnapshotPtr m_front;                   // frame the read API answers from
+    int     m_staleAfterMs     = 0;
+    int     m_notifyIntervalMs = 0;
+    int     m_framesPublished  = 0;
+    int     m_suppressed       = 0;
+
+    // QML export snapshots: status, power, temperature, current
+    struct ExportBuffer {
+        QByteArray bytes;
+        quint32    version = ~0u;
+    };
+    mutable ExportBuffer m_export[4];
 
     QVariantList m_history; // ring buffer of health% snapshots (up to 60)
     QTimer      *m_histTimer = nullptr;
+
+    ElementHistory m_elemHistory;
+    int            m_historySampleMs = 0;
+    QTimer        *m_sampleTimer     = nullptr;
 };
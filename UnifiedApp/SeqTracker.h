@@ -0,0 +1,77 @@
+#pragma once
+#include <QtGlobal>
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SeqTracker — loss / reorder / duplicate accounting for a u32 sequence stream
+//
+// Keeps the highest sequence seen plus a 64-bit window of the ones below it.
+// A jump forward counts the skipped numbers as lost; when one of them turns
+// up later it is counted as reordered and taken back off the loss count. A
+// number already in the window is a duplicate. Jumps larger than kRestart in
+// either direction are treated as a sender restart and re-anchor the window
+// without touching the counters.
+// ─────────────────────────────────────────────────────────────────────────────
+struct SeqTracker {
+    enum Result { First, InOrder, Gap, Late, Duplicate, Restart };
+
+    quint64 received   = 0;
+    quint64 lost       = 0;
+    quint64 reordered  = 0;
+    quint64 duplicates = 0;
+
+    Result track(quint32 seq)
+    {
+        if (!m_started) return anchor(seq, First);
+
+        const qint32 d = qint32(seq - m_highest);
+        if (d > 0) {
+            if (d > kRestart) return anchor(seq, Restart);
+            lost     += quint64(d - 1);
+            m_window  = (d >= 64) ? 1 : (m_window << d) | 1;
+            m_highest = seq;
+            ++received;
+            return d == 1 ? InOrder : Gap;
+        }
+        if (d < -kRestart) return anchor(seq, Restart);
+
+        const int back = -d;
+        if (back < 64) {
+            const quint64 bit = quint64(1) << back;
+            if (m_window & bit) {
+                ++duplicates;
+                return Duplicate;
+            }
+            m_window |= bit;
+        }
+        ++reordered;
+        ++received;
+        if (lost) --lost;
+        return Late;
+    }
+
+    double lossPercent() const
+    {
+        const quint64 expected = received + lost;
+        return expected ? 100.0 * double(lost) / double(expected) : 0.0;
+    }
+
+    void    reset()         { *this = SeqTracker(); }
+    bool    started() const { return m_started; }
+    quint32 highest() const { return m_highest; }
+
+private:
+    static const qint32 kRestart = 1 << 20;
+
+    Result anchor(quint32 seq, Result r)
+    {
+        m_started = true;
+        m_highest = seq;
+        m_window  = 1;
+        ++received;
+        return r;
+    }
+
+    bool    m_started = false;
+    quint32 m_highest = 0;
+    quint64 m_window  = 0;     // bit i: m_highest - i was received
+};
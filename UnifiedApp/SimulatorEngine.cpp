@@ -1,6 +1,36 @@
 #include "SimulatorEngine.h"
 #include <QHostAddress>
 #include <cmath>
+#include <cstring>
+
+// ── Wire encoding ────────────────────────────────────────────────────────────
+static void putU16(uchar *p, quint16 v) { p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; }
+static void putU32(uchar *p, quint32 v)
+{
+    p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; p[2] = (v >> 16) & 0xFF; p[3] = (v >> 24) & 0xFF;
+}
+static quint16 getU16(const uchar *p) { return quint16(p[0] | (p[1] << 8)); }
+
+// Reporting deadband in raw units: 0.5 dB, 1 °C, 50 mA
+static const int kPowerDeadband   = 50;
+static const int kTempDeadband    = 10;
+static const int kCurrentDeadband = 50;
+
+static ElementHealth::Status rawStatus(const uchar *t, const ElementThresholds &th)
+{
+    return ElementHealth::classify(RadarModel::decodePower(getU16(t)),
+                                   RadarModel::decodeTemp(getU16(t + 2)),
+                                   RadarModel::decodeCurrent(getU16(t + 4)), th);
+}
+
+// True if the receiver's copy (sent) is stale enough to be worth a delta entry
+static bool needsUpdate(const uchar *cur, const uchar *sent, const ElementThresholds &th)
+{
+    if (qAbs(int(getU16(cur))     - int(getU16(sent)))     > kPowerDeadband)   return true;
+    if (qAbs(int(getU16(cur + 2)) - int(getU16(sent + 2))) > kTempDeadband)    return true;
+    if (qAbs(int(getU16(cur + 4)) - int(getU16(sent + 4))) > kCurrentDeadband) return true;
+    return rawStatus(cur, th) != rawStatus(sent, th);
+}
 
 // ── Helpers ──────────────────────────────────────────────────────────────────
 float SimulatorEngine::rnd(float lo, float hi)
@@ -159,38 +189,182 @@ void SimulatorEngine::tick()
             m_current[q][i] = qBound( 0.0f, m_current[q][i],  5.0f);
         }
     }
-    sendSnapshot();
+
+    encodeFrame();
+    if (!m_deltaMode) {
+        sendSnapshot();
+        return;
+    }
+    const bool keyDue = m_forceKeyframe || m_sentRaw.size() != m_frame.size()
+                        || ++m_ticksSinceKey >= kKeyframeTicks;
+    if (keyDue || !buildDelta()) {
+        sendKeyframe();
+        return;
+    }
+    for (int i = 0; i < m_deltaCount; ++i) {
+        uchar *p = reinterpret_cast<uchar*>(m_deltaPackets[i].data());
+        putU32(p + 1, ++m_seq);
+        putU32(p + 5, m_keySeq);
+        send(m_deltaPackets[i]);
+    }
 }
 
-// ── Send 0x12 all-quadrants snapshot ─────────────────────────────────────────
-void SimulatorEngine::sendSnapshot()
+// ── Frame encoding ───────────────────────────────────────────────────────────
+void SimulatorEngine::encodeFrame()
 {
     int Q   = m_model->quadrantCount();
     int EPQ = m_model->elementsPerQuadrant();
-    int payloadLen = 1 + Q * EPQ * 6;
-
-    QByteArray pkt(payloadLen, 0);
-    uchar *p = reinterpret_cast<uchar*>(pkt.data());
-    p[0] = 0x12;
+    m_frame.resize(Q * EPQ * 6);
+    uchar *p = reinterpret_cast<uchar*>(m_frame.data());
 
     for (int q = 0; q < Q; ++q) {
         for (int i = 0; i < EPQ; ++i) {
-            uchar *ep = p + 1 + (q * EPQ + i) * 6;
-            quint16 pw = encodePower  (m_power[q][i]);
-            quint16 tm = encodeTemp   (m_temp[q][i]);
-            quint16 cu = encodeCurrent(m_current[q][i]);
-            ep[0] = pw & 0xFF; ep[1] = (pw >> 8) & 0xFF;
-            ep[2] = tm & 0xFF; ep[3] = (tm >> 8) & 0xFF;
-            ep[4] = cu & 0xFF; ep[5] = (cu >> 8) & 0xFF;
+            uchar *ep = p + (q * EPQ + i) * 6;
+            putU16(ep,     encodePower  (m_power[q][i]));
+            putU16(ep + 2, encodeTemp   (m_temp[q][i]));
+            putU16(ep + 4, encodeCurrent(m_current[q][i]));
         }
     }
+}
+
+void SimulatorEngine::send(const QByteArray &pkt)
+{
     m_socket->writeDatagram(pkt, QHostAddress::LocalHost, m_port);
 }
 
+// ── Send 0x12 all-quadrants snapshot ─────────────────────────────────────────
+void SimulatorEngine::sendSnapshot()
+{
+    if (1 + m_frame.size() > m_maxDatagram) {
+        sendChunks();
+        return;
+    }
+    m_packet.resize(1 + m_frame.size());
+    m_packet[0] = char(0x12);
+    memcpy(m_packet.data() + 1, m_frame.constData(), m_frame.size());
+    send(m_packet);
+}
+
+// ── Send 0x14 keyframe ───────────────────────────────────────────────────────
+void SimulatorEngine::sendKeyframe()
+{
+    if (5 + m_frame.size() > m_maxDatagram) {
+        m_keySeq = sendChunks();
+    } else {
+        m_keySeq = ++m_seq;
+        m_packet.resize(5 + m_frame.size());
+        uchar *p = reinterpret_cast<uchar*>(m_packet.data());
+        p[0] = 0x14;
+        putU32(p + 1, m_keySeq);
+        memcpy(p + 5, m_frame.constData(), m_frame.size());
+        send(m_packet);
+    }
+
+    m_sentRaw.resize(m_frame.size());
+    memcpy(m_sentRaw.data(), m_frame.constData(), m_frame.size());
+    m_ticksSinceKey  = 0;
+    m_forceKeyframe  = false;
+}
+
+// ── Send m_frame as 0x15 chunks ──────────────────────────────────────────────
+// Every chunk takes one sequence number: chunk i is frameId + i.
+quint32 SimulatorEngine::sendChunks()
+{
+    static const int kHeader = 15;
+    const int total    = m_frame.size() / 6;
+    const int perChunk = (m_maxDatagram - kHeader) / 6;
+    const int chunks   = (total + perChunk - 1) / perChunk;
+    const quint32 frameId = m_seq + 1;
+    m_seq += quint32(chunks);
+
+    for (int c = 0; c < chunks; ++c) {
+        const int offset = c * perChunk;
+        const int n      = qMin(perChunk, total - offset);
+        m_packet.resize(kHeader + n * 6);
+        uchar *p = reinterpret_cast<uchar*>(m_packet.data());
+        p[0] = 0x15;
+        putU32(p + 1,  frameId);
+        putU16(p + 5,  quint16(c));
+        putU16(p + 7,  quint16(chunks));
+        putU32(p + 9,  quint32(offset));
+        putU16(p + 13, quint16(n));
+        memcpy(p + kHeader, m_frame.constData() + offset * 6, n * 6);
+        send(m_packet);
+    }
+    return frameId;
+}
+
+// ── Build 0x13 deltas ────────────────────────────────────────────────────────
+// Consecutive changed elements share one run; a new packet is started when
+// the next entry would not fit in m_maxDatagram. Sequence numbers are filled
+// in by tick(). m_sentRaw is updated as runs are added; if we bail out the
+// caller sends a keyframe, which overwrites it.
+bool SimulatorEngine::buildDelta()
+{
+    const int n     = m_frame.size() / 6;
+    const int limit = m_frame.size() / 2;
+    const uchar *cur = reinterpret_cast<const uchar*>(m_frame.constData());
+    uchar *sent      = reinterpret_cast<uchar*>(m_sentRaw.data());
+    const ElementThresholds &th = m_model->thresholds();
+
+    QByteArray *pkt = nullptr;
+    int bytes = 0, runs = 0, runHeader = -1, runLen = 0;
+    auto finishPacket = [&]() {
+        uchar *p = reinterpret_cast<uchar*>(pkt->data());
+        p[0] = 0x13;
+        putU16(p + 9, quint16(runs));
+        bytes += pkt->size();
+        pkt = nullptr;
+    };
+    auto startPacket = [&]() {
+        if (m_deltaCount == m_deltaPackets.size()) m_deltaPackets.append(QByteArray());
+        pkt = &m_deltaPackets[m_deltaCount++];
+        pkt->resize(11);
+        runs = 0;
+        runHeader = -1;
+    };
+
+    m_deltaCount = 0;
+    for (int g = 0; g < n; ++g) {
+        const uchar *c = cur + g * 6;
+        if (!needsUpdate(c, sent + g * 6, th)) {
+            runHeader = -1;
+            continue;
+        }
+        const bool newRun = runHeader < 0 || runLen == 0xFFFF;
+        if (pkt && pkt->size() + (newRun ? 12 : 6) > m_maxDatagram) finishPacket();
+        if (!pkt) startPacket();
+        if (runHeader < 0 || runLen == 0xFFFF) {
+            if (runs == 0xFFFF) return false;
+            ++runs;
+            runHeader = pkt->size();
+            runLen    = 0;
+            pkt->resize(runHeader + 6);
+            putU32(reinterpret_cast<uchar*>(pkt->data()) + runHeader, quint32(g));
+        }
+        pkt->append(reinterpret_cast<const char*>(c), 6);
+        putU16(reinterpret_cast<uchar*>(pkt->data()) + runHeader + 4, quint16(++runLen));
+        memcpy(sent + g * 6, c, 6);
+        if (bytes + pkt->size() > limit) return false;
+    }
+    if (!pkt && m_deltaCount == 0) startPacket();      // nothing changed: empty delta keeps seq moving
+    if (pkt) finishPacket();
+    return true;
+}
+
+void SimulatorEngine::setDeltaMode(bool on)
+{
+    if (m_deltaMode == on) return;
+    m_deltaMode     = on;
+    m_forceKeyframe = true;
+    emit deltaModeChanged();
+}
+
 // ── Start / Stop ─────────────────────────────────────────────────────────────
 void SimulatorEngine::start()
 {
     buildScenario();
+    m_forceKeyframe = true;
     m_timer->start();
     m_scenTimer->start();
     emit runningChanged();
@@ -15,26 +15,46 @@
  *   Current: 1.2–1.7 A   (threshold 2.0 A)
  *
  * Six rotating scenarios demonstrate all fault modes.
+ *
+ * Transmission (see UdpReceiver.h for the wire format):
+ *   deltaMode on  (default) — a 0x14 keyframe every kKeyframeTicks, 0x13
+ *                 deltas in between carrying only elements that moved by
+ *                 more than the reporting deadband or changed status
+ *   deltaMode off — a full 0x12 snapshot every tick
+ * A delta that would exceed half a keyframe is sent as a keyframe
+ * instead; requestKeyframe() forces one on the next tick (wired to the
+ * receiver's keyframeRequested() when it detects loss).
+ *
+ * No datagram exceeds setMaxDatagramSize() (default 1472, one Ethernet
+ * MTU without IP fragmentation): keyframes and snapshots that do not fit
+ * go out as 0x15 chunks, and a large delta is split over several
+ * consecutive 0x13 packets.
  */
 class SimulatorEngine : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(bool    running  READ running  NOTIFY runningChanged)
     Q_PROPERTY(QString scenario READ scenario NOTIFY scenarioChanged)
+    Q_PROPERTY(bool    deltaMode READ deltaMode WRITE setDeltaMode NOTIFY deltaModeChanged)
 
 public:
     explicit SimulatorEngine(RadarModel *model, quint16 targetPort, QObject *parent = nullptr);
 
     bool    running()  const { return m_timer && m_timer->isActive(); }
     QString scenario() const { return m_scenarioName; }
+    bool    deltaMode() const { return m_deltaMode; }
+    void    setDeltaMode(bool on);
+    void    setMaxDatagramSize(int bytes) { m_maxDatagram = qMax(64, bytes); }
 
 public slots:
     void start();
     void stop();
+    void requestKeyframe() { m_forceKeyframe = true; }
 
 signals:
     void runningChanged();
     void scenarioChanged();
+    void deltaModeChanged();
 
 private slots:
     void tick();
@@ -50,7 +70,14 @@ private:
     float  noise(float sigma);          // gaussian-like noise
 
     void buildScenario();               // populate m_power/m_temp/m_current
-    void sendSnapshot();
+    void encodeFrame();                 // m_power/m_temp/m_current → m_frame
+    void sendSnapshot();                // 0x12, or 0x15 chunks if too large
+    void sendKeyframe();                // 0x14, or 0x15 chunks if too large
+    quint32 sendChunks();               // m_frame as 0x15 chunks; returns the frame id
+    bool buildDelta();                  // 0x13s into m_deltaPackets; false if too large
+    void send(const QByteArray &pkt);
+
+    static const int kKeyframeTicks = 25;   // ~2 s at the 80 ms tick
 
     // Element type per simulation
     enum ElemType { Good, PowerWarn, PowerFault, ThermalWarn, ThermalFault,
@@ -74,4 +101,17 @@ private:
     QVector<QVector<float>> m_pwrBase;
     QVector<QVector<float>> m_tmpBase;
     QVector<QVector<float>> m_curBase;
+
+    // Wire state
+    QByteArray m_frame;                 // current values, Q × EPQ triplets
+    QByteArray m_sentRaw;               // values the receiver holds
+    QByteArray m_packet;                // reused datagram buffer
+    QVector<QByteArray> m_deltaPackets; // reused 0x13 buffers, first m_deltaCount valid
+    int     m_deltaCount    = 0;
+    int     m_maxDatagram   = 1472;
+    bool    m_deltaMode     = true;
+    bool    m_forceKeyframe = true;
+    quint32 m_seq           = 0;
+    quint32 m_keySeq        = 0;
+    int     m_ticksSinceKey = 0;
 };
@@ -1,90 +1,416 @@
 #include "UdpReceiver.h"
-#include <QNetworkDatagram>
+#include "datagrambatchreader.h"
+#include <algorithm>
+#include <climits>
+
+// Re-request a keyframe every this many discarded deltas while out of sync,
+// in case the keyframe itself was lost
+static const int kResyncRetryDeltas = 16;
+
+static quint32 readU32(const uchar *p)
+{
+    return quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24);
+}
 
 UdpReceiver::UdpReceiver(RadarModel *model, QObject *parent)
-    : QObject(parent), m_model(model)
-{}
+    : QObject(parent), m_model(model), m_ctx(new QObject)
+{
+    m_quadLink.resize(model->quadrantCount());
+    m_touched.resize(model->quadrantCount());
+    m_stats = collectStats();
+}
+
+UdpReceiver::~UdpReceiver()
+{
+    // Socket, reader and replayer are children of the decode context and
+    // have to be destroyed on its thread
+    auto teardown = [this]() {
+        closeSocket();
+        delete m_ctx;
+    };
+    if (m_ctx->thread() != QThread::currentThread() && m_ctx->thread()->isRunning())
+        QMetaObject::invokeMethod(m_ctx, teardown, Qt::BlockingQueuedConnection);
+    else
+        teardown();
+}
+
+void UdpReceiver::setIngestThread(QThread *thread)
+{
+    QThread *target = thread ? thread : this->thread();
+    if (m_ctx->thread() != target)
+        onDecoder([this, target]() { m_ctx->moveToThread(target); }, 0);
+    m_model->setWriteThread(target);
+}
 
 bool UdpReceiver::startListening(quint16 port)
 {
-    m_socket = new QUdpSocket(this);
-    bool ok = m_socket->bind(QHostAddress::AnyIPv4, port,
-                              QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint);
-    if (ok)
-        connect(m_socket, &QUdpSocket::readyRead, this, &UdpReceiver::onReadyRead);
-    emit listeningChanged();
+    // One listeningChanged() at most, once the bind result is known
+    bool ok = false;
+    onDecoder([&]() {
+        closeSocket();
+        m_captureTag = QString("antenna:%1").arg(port);
+        m_socket = new QUdpSocket(m_ctx);
+        ok = m_socket->bind(QHostAddress::AnyIPv4, port,
+                            QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint);
+        if (ok) {
+            // Largest datagram we decode is an unchunked 0x14 keyframe (the
+            // batch reader caps slots at the UDP maximum; bigger arrays use 0x15)
+            int maxDatagram = 5 + m_model->quadrantCount() * m_model->elementsPerQuadrant() * 6;
+            m_reader = new DatagramBatchReader(m_socket, m_batchSize, maxDatagram, m_ctx);
+            m_reader->setReceiveBufferSize(m_rcvBufBytes);
+            connect(m_reader, &DatagramBatchReader::readyRead, m_ctx, [this]() { onReadyRead(); });
+        }
+    }, Listening);
     return ok;
 }
 
 void UdpReceiver::stopListening()
 {
-    if (m_socket) m_socket->close();
-    emit listeningChanged();
+    onDecoder([this]() { closeSocket(); }, Listening);
+}
+
+void UdpReceiver::closeSocket()
+{
+    delete m_reader;
+    m_reader = nullptr;
+    if (m_socket) {
+        m_socket->close();
+        m_socket->deleteLater();
+        m_socket = nullptr;
+    }
 }
 
 void UdpReceiver::onReadyRead()
 {
-    while (m_socket->hasPendingDatagrams()) {
-        QNetworkDatagram dg = m_socket->receiveDatagram();
-        if (!dg.isValid()) continue;
-        QByteArray data = dg.data();
-        if (data.isEmpty()) continue;
-
-        const uchar *p   = reinterpret_cast<const uchar*>(data.constData());
-        int          len = data.size();
-        quint8       type = p[0];
-
-        // ── 0x10: single element ─────────────────────────────────
-        if (type == 0x10 && len >= 10) {
-            int    q    = p[1];
-            int    elem = quint16(p[2]) | (quint16(p[3]) << 8);
-            float  pwr  = decodePower  (readU16(p+4));
-            float  tmp  = decodeTemp   (readU16(p+6));
-            float  cur  = decodeCurrent(readU16(p+8));
-            m_model->setElement(q, elem, pwr, tmp, cur);
-            ++m_pktCount;
+    if (!m_reader) return;
+    int n = m_reader->drain([this](const char *data, int len) {
+        if (len <= 0) return;
+        m_recorder.write(m_captureTag, data, len);
+        handleDatagram(reinterpret_cast<const uchar*>(data), len);
+    });
+    if (n > 0) publishStats(PacketCount);
+}
+
+// ── Published counters ───────────────────────────────────────────────────────
+UdpReceiver::Stats UdpReceiver::collectStats() const
+{
+    Stats s;
+    s.listening   = m_socket && m_socket->state() == QAbstractSocket::BoundState;
+    s.recording   = m_recorder.isOpen();
+    s.replaying   = m_replayer && m_replayer->isRunning();
+    s.synced      = m_synced;
+    s.packets     = m_pktCount;
+    s.kernelDrops = m_reader ? clampCount(m_reader->kernelDrops()) : 0;
+    s.resyncs     = m_deltaResyncs;
+    s.chunkFramesComplete = m_chunkFramesComplete;
+    s.chunkFramesPartial  = m_chunkFramesPartial;
+    s.lossPercent = m_link.lossPercent();
+    s.lost        = clampCount(m_link.lost);
+    s.reordered   = clampCount(m_link.reordered);
+    s.duplicated  = clampCount(m_link.duplicates);
+    for (const QuadLink &l : m_quadLink) {
+        const quint64 expected = l.received + l.lost;
+        s.quadLoss.append(expected ? 100.0 * double(l.lost) / double(expected) : 0.0);
+        s.quadReordered.append(clampCount(l.reordered));
+        s.quadDuplicated.append(clampCount(l.duplicates));
+    }
+    s.replaySummary = m_replaySummary;
+    return s;
+}
+
+void UdpReceiver::adoptStats(const Stats &s, int notify)
+{
+    // Rebinding closes the old socket first; only the final bound state counts
+    const bool wasListening = m_stats.listening;
+    m_stats = s;
+    if ((notify & Listening) && s.listening != wasListening) emit listeningChanged();
+    if (notify & PacketCount)  emit packetCountChanged();
+    if (notify & CaptureState) emit captureStateChanged();
+    if (notify & ReplayDone)   emit replayFinished();
+}
+
+void UdpReceiver::publishStats(int notify)
+{
+    const Stats s = collectStats();
+    // Direct without an ingest thread, queued to the receiver's thread with one
+    QMetaObject::invokeMethod(this, [this, s, notify]() { adoptStats(s, notify); });
+}
+
+void UdpReceiver::refreshStats()
+{
+    onDecoder([]() {}, PacketCount);
+}
+
+// ── Capture / replay ─────────────────────────────────────────────────────────
+bool UdpReceiver::startRecording(const QString &path)
+{
+    bool ok = false;
+    onDecoder([&]() { ok = m_recorder.open(path); }, CaptureState);
+    return ok;
+}
+
+void UdpReceiver::stopRecording()
+{
+    onDecoder([this]() { m_recorder.close(); }, CaptureState);
+}
+
+bool UdpReceiver::startReplay(const QString &path, double speed)
+{
+    bool ok = false;
+    onDecoder([&]() {
+        if (m_replayer) m_replayer->stop();
+        if (!m_replayer) {
+            m_replayer = new FrameReplayer(m_ctx);
+            connect(m_replayer, &FrameReplayer::finished, m_ctx, [this](const ReplayReport &report) {
+                ReplayReport r = report;
+                r.droppedFrames = m_replayRejected;
+                m_replaySummary = r.summary();
+                publishStats(PacketCount | CaptureState | ReplayDone);
+            });
+            m_replayer->setConsumer([this](int, const QByteArray &frame) {
+                if (!handleDatagram(reinterpret_cast<const uchar*>(frame.constData()), frame.size()))
+                    ++m_replayRejected;
+                if ((m_pktCount & 63) == 0) publishStats(PacketCount);
+            });
         }
+        if (!m_replayer->open(path)) return;
+
+        m_replayRejected = 0;
+        m_replayer->setSpeed(speed);
+        m_replayer->start();
+        ok = true;
+    }, CaptureState);
+    return ok;
+}
+
+void UdpReceiver::stopReplay()
+{
+    onDecoder([this]() { if (m_replayer) m_replayer->stop(); }, CaptureState);
+}
+
+bool UdpReceiver::handleDatagram(const uchar *p, int len)
+{
+    if (len < 1) return false;
+    quint8       type = p[0];
 
-        // ── 0x11: full quadrant ──────────────────────────────────
-        else if (type == 0x11 && len >= 2) {
-            int q   = p[1];
-            int EPQ = m_model->elementsPerQuadrant();
-            int expected = 2 + EPQ * 6;
-            if (len < expected) continue;
-
-            QVector<float> powers(EPQ), temps(EPQ), currents(EPQ);
-            for (int i = 0; i < EPQ; ++i) {
-                const uchar *ep = p + 2 + i * 6;
-                powers[i]   = decodePower  (readU16(ep));
-                temps[i]    = decodeTemp   (readU16(ep+2));
-                currents[i] = decodeCurrent(readU16(ep+4));
-            }
-            m_model->setQuadrant(q, powers, temps, currents);
+    // ── 0x10: single element ─────────────────────────────────
+    if (type == 0x10 && len >= 10) {
+        int    q    = p[1];
+        int    elem = quint16(p[2]) | (quint16(p[3]) << 8);
+        m_model->setElementRaw(q, elem, p + 4);
+        ++m_pktCount;
+        return true;
+    }
+
+    // ── 0x11: full quadrant ──────────────────────────────────
+    else if (type == 0x11 && len >= 2) {
+        if (!m_model->setQuadrantRaw(p[1], p + 2, len - 2)) return false;
+        ++m_pktCount;
+        return true;
+    }
+
+    // ── 0x12: all quadrants snapshot ─────────────────────────
+    else if (type == 0x12) {
+        if (!m_model->setAllQuadrantsRaw(p + 1, len - 1)) return false;
+        ++m_pktCount;
+        return true;
+    }
+
+    // ── 0x14: sequenced keyframe ─────────────────────────────
+    else if (type == 0x14 && len >= 5) {
+        const quint32 seq = readU32(p + 1);
+        trackSequenced(seq, p, len);
+        if (m_synced && qint32(seq - m_lastSeq) <= 0) {   // late or duplicate
             ++m_pktCount;
+            return true;
         }
+        if (!m_model->setAllQuadrantsRaw(p + 5, len - 5)) return false;
+        keyframeApplied(seq, seq);
+        ++m_pktCount;
+        return true;
+    }
 
-        // ── 0x12: all quadrants snapshot ─────────────────────────
-        else if (type == 0x12) {
-            int Q   = m_model->quadrantCount();
-            int EPQ = m_model->elementsPerQuadrant();
-            int expected = 1 + Q * EPQ * 6;
-            if (len < expected) continue;
-
-            QVector<QVector<float>> powers(Q), temps(Q), currents(Q);
-            for (int q = 0; q < Q; ++q) {
-                powers[q].resize(EPQ);
-                temps[q].resize(EPQ);
-                currents[q].resize(EPQ);
-                for (int i = 0; i < EPQ; ++i) {
-                    const uchar *ep = p + 1 + (q * EPQ + i) * 6;
-                    powers[q][i]   = decodePower  (readU16(ep));
-                    temps[q][i]    = decodeTemp   (readU16(ep+2));
-                    currents[q][i] = decodeCurrent(readU16(ep+4));
-                }
-            }
-            m_model->setAllQuadrants(powers, temps, currents);
+    // ── 0x13: delta against the last keyframe ────────────────
+    else if (type == 0x13 && len >= 11) {
+        const quint32 seq  = readU32(p + 1);
+        const quint32 base = readU32(p + 5);
+        const int     runs = p[9] | (p[10] << 8);
+        trackSequenced(seq, p, len);
+        if (m_synced && qint32(seq - m_lastSeq) <= 0) {   // late or duplicate
             ++m_pktCount;
+            return true;
         }
-        emit packetCountChanged();
+        if (!m_synced || base != m_keySeq || seq != m_lastSeq + 1) {
+            loseSync();
+            ++m_pktCount;
+            return true;
+        }
+        if (!m_model->setElementRunsRaw(p + 11, len - 11, runs)) return false;
+        m_lastSeq = seq;
+        ++m_pktCount;
+        return true;
+    }
+
+    // ── 0x15: snapshot chunk ─────────────────────────────────
+    else if (type == 0x15 && len >= 15) {
+        if (!handleChunk(p, len)) return false;
+        ++m_pktCount;
+        return true;
+    }
+    return false;
+}
+
+bool UdpReceiver::handleChunk(const uchar *p, int len)
+{
+    const quint32 frame = readU32(p + 1);
+    const int     index = p[5] | (p[6] << 8);
+    const int     count = p[7] | (p[8] << 8);
+    if (count == 0 || index >= count) return false;
+    trackSequenced(frame + quint32(index), p, len);
+
+    if (m_chunkActive && frame != m_chunkFrame) {
+        if (qint32(frame - m_chunkFrame) < 0) return true;       // straggler of an older frame
+        if (m_chunkReceived < m_chunkCount) ++m_chunkFramesPartial;
+        m_chunkActive = false;
+    }
+    if (!m_chunkActive) {
+        m_chunkActive   = true;
+        m_chunkFrame    = frame;
+        m_chunkCount    = count;
+        m_chunkReceived = 0;
+        m_chunkStride   = 0;
+        m_chunkSeen.fill(false, count);
+    }
+    if (count != m_chunkCount) return false;
+    if (m_chunkSeen[index]) return true;                         // duplicate
+    if (index < count - 1) m_chunkStride = p[13] | (p[14] << 8);
+
+    // The element range is laid out exactly like a single 0x13 run
+    if (!m_model->setElementRunsRaw(p + 9, len - 9, 1)) return false;
+    m_chunkSeen[index] = true;
+    if (++m_chunkReceived == m_chunkCount) {
+        ++m_chunkFramesComplete;
+        const quint32 last = frame + quint32(count - 1);
+        if (!m_synced || qint32(last - m_lastSeq) > 0) keyframeApplied(frame, last);
+    }
+    return true;
+}
+
+void UdpReceiver::keyframeApplied(quint32 keySeq, quint32 lastSeq)
+{
+    m_synced  = true;
+    m_keySeq  = keySeq;
+    m_lastSeq = lastSeq;
+    m_unsyncedDeltas = 0;
+}
+
+// ── Link quality ─────────────────────────────────────────────────────────────
+void UdpReceiver::markQuadrants(int firstGid, int count)
+{
+    const int epq   = m_model->elementsPerQuadrant();
+    const int total = m_model->totalElements();
+    if (count <= 0 || firstGid < 0 || firstGid >= total) return;
+    const int last = qMin(total, firstGid + count) - 1;
+    for (int q = firstGid / epq; q <= last / epq; ++q)
+        m_touched[q] = 1;
+}
+
+void UdpReceiver::trackSequenced(quint32 seq, const uchar *p, int len)
+{
+    const bool    started = m_link.started();
+    const quint32 before  = m_link.highest();
+    const SeqTracker::Result r = m_link.track(seq);
+
+    // Quadrants this datagram carries data for
+    std::fill(m_touched.begin(), m_touched.end(), quint8(0));
+    if (p[0] == 0x14) {
+        std::fill(m_touched.begin(), m_touched.end(), quint8(1));
+    } else if (p[0] == 0x15) {
+        markQuadrants(int(qMin<quint32>(readU32(p + 9), INT_MAX)), p[13] | (p[14] << 8));
+    } else {
+        const int runs = p[9] | (p[10] << 8);
+        int off = 11;
+        for (int i = 0; i < runs && len - off >= 6; ++i) {
+            const int count = p[off + 4] | (p[off + 5] << 8);
+            markQuadrants(int(qMin<quint32>(readU32(p + off), INT_MAX)), count);
+            off += 6 + count * 6;
+        }
+    }
+
+    for (int q = 0; q < m_quadLink.size(); ++q) {
+        if (!m_touched[q]) continue;
+        QuadLink &l = m_quadLink[q];
+        if (r == SeqTracker::Duplicate) {
+            ++l.duplicates;
+            continue;
+        }
+        ++l.received;
+        if (r == SeqTracker::Late) {
+            ++l.reordered;
+            if (l.lost) --l.lost;
+        }
+    }
+    if (r == SeqTracker::Gap && started) chargeLoss(before + 1, seq, p);
+}
+
+// Charge the sequence numbers [from, to) that never arrived. Chunks of the
+// frame being assembled, or of the frame this datagram belongs to, map to an
+// element range (chunks are equal-sized except the last); anything else is
+// charged to every quadrant.
+void UdpReceiver::chargeLoss(quint32 from, quint32 to, const uchar *p)
+{
+    struct Frame { quint32 first; int count; int stride; };
+    Frame frames[2];
+    int nf = 0;
+    if (m_chunkActive && m_chunkStride > 0)
+        frames[nf++] = { m_chunkFrame, m_chunkCount, m_chunkStride };
+    if (p[0] == 0x15) {
+        const quint32 frame = readU32(p + 1);
+        const int index = p[5] | (p[6] << 8);
+        const int count = p[7] | (p[8] << 8);
+        const int stride = index < count - 1 ? (p[13] | (p[14] << 8))
+                         : (m_chunkActive && frame == m_chunkFrame) ? m_chunkStride : 0;
+        if (stride > 0) frames[nf++] = { frame, count, stride };
+    }
+
+    const quint32 n = to - from;
+    if (n > 65536) nf = 0;              // far more than one frame: no per-chunk walk
+    quint64 unknown = 0;
+    for (quint32 i = 0; i < n && nf > 0; ++i) {
+        const quint32 s = from + i;
+        bool charged = false;
+        for (int f = 0; f < nf && !charged; ++f) {
+            const quint32 chunk = s - frames[f].first;
+            if (chunk >= quint32(frames[f].count)) continue;
+            std::fill(m_touched.begin(), m_touched.end(), quint8(0));
+            markQuadrants(int(chunk) * frames[f].stride, frames[f].stride);
+            for (int q = 0; q < m_quadLink.size(); ++q)
+                m_quadLink[q].lost += m_touched[q];
+            charged = true;
+        }
+        if (!charged) ++unknown;
+    }
+    if (nf == 0) unknown = n;
+    for (QuadLink &l : m_quadLink)
+        l.lost += unknown;
+}
+
+void UdpReceiver::resetLinkStats()
+{
+    onDecoder([this]() {
+        m_link.reset();
+        std::fill(m_quadLink.begin(), m_quadLink.end(), QuadLink());
+    }, PacketCount);
+}
+
+void UdpReceiver::loseSync()
+{
+    if (m_synced) {
+        m_synced = false;
+        m_unsyncedDeltas = 1;
+        ++m_deltaResyncs;
+        emit keyframeRequested();
+    } else if (m_unsyncedDeltas++ % kResyncRetryDeltas == 0) {
+        emit keyframeRequested();   // first delta after start-up, then periodic retries
     }
 }
@@ -1,7 +1,13 @@
 #pragma once
 #include <QObject>
 #include <QUdpSocket>
+#include <QThread>
+#include <climits>
 #include "RadarModel.h"
+#include "framecapture.h"
+#include "SeqTracker.h"
+
+class DatagramBatchReader;
 
 /*
  * UDP Receive Packet Protocol  (multi-parameter)
@@ -16,10 +22,52 @@
  * Type 0x11 — Full quadrant update
  *   [0x11][quad:1][EPQ × 6 bytes: pwr(2)+tmp(2)+cur(2)]
  *
- * Type 0x12 — All quadrants snapshot (simulator uses this)
+ * Type 0x12 — All quadrants snapshot (unsequenced)
  *   [0x12][Q × EPQ × 6 bytes]
+ *
+ * Type 0x14 — Keyframe: sequenced all-quadrants snapshot
+ *   [0x14][seq:4][Q × EPQ × 6 bytes]
+ *
+ * Type 0x13 — Delta against the last keyframe (simulator uses 0x13/0x14)
+ *   [0x13][seq:4][base_seq:4][run_count:2]
+ *   run_count × { [start_gid:4][count:2][count × 6 bytes] }
+ *   start_gid = quad * EPQ + elem; runs cover changed elements only
+ *
+ * Type 0x15 — Snapshot chunk (frames larger than one datagram)
+ *   [0x15][frame_id:4][chunk_idx:2][chunk_count:2]
+ *   [elem_offset:4][elem_count:2][elem_count × 6 bytes]
+ *   elem_offset is a global element id; chunks of one frame cover the
+ *   array in order without overlap, all the same size except the last,
+ *   and are sized to avoid IP fragmentation
  * ─────────────────────────────────────────────────────────────────
  *
+ * Sequencing: seq is one little-endian u32 counter, one number per
+ * datagram, shared by 0x13, 0x14 and 0x15 (chunk i of a frame is
+ * frame_id + i; the next packet after a frame uses frame_id + chunk_count).
+ * A delta is applied only if its base_seq is the keyframe we hold
+ * and its seq directly follows the last applied packet; older or
+ * duplicate packets are ignored. On a gap or foreign base the receiver
+ * drops out of sync, counts a resync, emits keyframeRequested() and
+ * discards deltas until the next keyframe (senders emit one periodically,
+ * so this also recovers without a back-channel).
+ *
+ * Chunked frames: every chunk is applied as soon as it arrives (its values
+ * are absolute), so a lost chunk only leaves that range one frame behind.
+ * Chunks are tracked per frame_id: a chunk of an older frame than the one
+ * being assembled is dropped, and when a new frame starts before the
+ * previous one completed, that frame counts in chunkFramesPartial. A
+ * complete frame is a keyframe for 0x13 deltas (base_seq = frame_id).
+ *
+ * Link quality: every sequenced datagram goes through a SeqTracker for the
+ * antenna (packetLossPercent, packetsLost / Reordered / Duplicated) and one
+ * per quadrant it carries data for (quadrantLossPercent etc., lists indexed
+ * by quadrant). A lost 0x15 chunk is charged to the quadrants its range
+ * covers; a lost 0x13 / 0x14 is charged to every quadrant since its content
+ * is unknown, so per-quadrant loss is an upper bound for delta streams.
+ *
+ * Payloads are handed to RadarModel's raw ingest API (setElementRaw,
+ * setQuadrantRaw, setAllQuadrantsRaw), which decodes them in place.
+ *
  * Encoding helpers:
  *   power  :  raw = (dBm + 10.0) * 100  → stored as uint16
  *   temp   :  raw = temp_C * 10         → stored as uint16
@@ -28,36 +76,190 @@
  *   Decode:  dBm  = raw / 100.0 - 10.0
  *            temp = raw / 10.0
  *            amps = raw / 1000.0
+ *
+ * Datagrams are drained in batches through DatagramBatchReader (recvmmsg
+ * into a preallocated slab on Linux). kernelDrops reports datagrams the
+ * kernel discarded because the socket receive buffer overflowed.
+ *
+ * Capture / replay: startRecording(path) journals every received datagram
+ * (source tag "antenna:<port>") into a capture file (framecapture.h);
+ * startReplay(path, speed) feeds a capture back through the same decode
+ * path at 1×, N× or (speed 0) as fast as possible. Replayed datagrams that
+ * do not decode are reported as dropped frames in replaySummary.
+ *
+ * Ingest thread: the socket, batch reader, capture / replay and all decode
+ * state belong to an internal context object. setIngestThread() moves that
+ * context, together with the model's write side, to a worker thread, so
+ * decoding and model writes no longer compete with rendering; the receiver
+ * object itself stays on the GUI thread for QML. Control calls (listen,
+ * record, replay, reset) run on the ingest thread and wait for it. The
+ * counters QML reads are a copy published after every received batch (and
+ * every 64 replayed datagrams); direct handleDatagram() callers publish
+ * with refreshStats(). Without an ingest thread the context lives on the
+ * receiver's thread and everything runs inline as before.
  */
 class UdpReceiver : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(bool listening         READ listening         NOTIFY listeningChanged)
     Q_PROPERTY(int  packetsReceived   READ packetsReceived   NOTIFY packetCountChanged)
+    Q_PROPERTY(int  kernelDrops       READ kernelDrops       NOTIFY packetCountChanged)
+    Q_PROPERTY(bool deltaSynced       READ deltaSynced       NOTIFY packetCountChanged)
+    Q_PROPERTY(int  deltaResyncs      READ deltaResyncs      NOTIFY packetCountChanged)
+    Q_PROPERTY(int  chunkFramesComplete READ chunkFramesComplete NOTIFY packetCountChanged)
+    Q_PROPERTY(int  chunkFramesPartial  READ chunkFramesPartial  NOTIFY packetCountChanged)
+    Q_PROPERTY(double packetLossPercent READ packetLossPercent NOTIFY packetCountChanged)
+    Q_PROPERTY(int  packetsLost       READ packetsLost       NOTIFY packetCountChanged)
+    Q_PROPERTY(int  packetsReordered  READ packetsReordered  NOTIFY packetCountChanged)
+    Q_PROPERTY(int  packetsDuplicated READ packetsDuplicated NOTIFY packetCountChanged)
+    Q_PROPERTY(QVariantList quadrantLossPercent READ quadrantLossPercent NOTIFY packetCountChanged)
+    Q_PROPERTY(QVariantList quadrantReordered   READ quadrantReordered   NOTIFY packetCountChanged)
+    Q_PROPERTY(QVariantList quadrantDuplicated  READ quadrantDuplicated  NOTIFY packetCountChanged)
+    Q_PROPERTY(bool recording         READ recording         NOTIFY captureStateChanged)
+    Q_PROPERTY(bool replaying         READ replaying         NOTIFY captureStateChanged)
+    Q_PROPERTY(QString replaySummary  READ replaySummary     NOTIFY replayFinished)
 
 public:
     explicit UdpReceiver(RadarModel *model, QObject *parent = nullptr);
+    ~UdpReceiver() override;
+
+    /** Decode on @p thread (nullptr = the receiver's own thread) and move the
+     *  model's write side there too. Call while not listening. */
+    void setIngestThread(QThread *thread);
+    bool ingestThreaded() const { return m_ctx->thread() != thread(); }
+
+    /** Applied on the next startListening(). */
+    void setReceiveBufferSize(int bytes) { m_rcvBufBytes = bytes; }
+    void setBatchSize(int datagrams)     { m_batchSize = datagrams; }
 
     bool startListening(quint16 port);
     void stopListening();
 
-    bool listening()       const { return m_socket && m_socket->state() == QAbstractSocket::BoundState; }
-    int  packetsReceived() const { return m_pktCount; }
+    bool listening()       const { return m_stats.listening; }
+    int  packetsReceived() const { return m_stats.packets; }
+    int  kernelDrops()     const { return m_stats.kernelDrops; }
+    bool deltaSynced()     const { return m_stats.synced; }
+    int  deltaResyncs()    const { return m_stats.resyncs; }
+    int  chunkFramesComplete() const { return m_stats.chunkFramesComplete; }
+    int  chunkFramesPartial()  const { return m_stats.chunkFramesPartial; }
+
+    double packetLossPercent() const { return m_stats.lossPercent; }
+    int  packetsLost()       const { return m_stats.lost; }
+    int  packetsReordered()  const { return m_stats.reordered; }
+    int  packetsDuplicated() const { return m_stats.duplicated; }
+    QVariantList quadrantLossPercent() const { return m_stats.quadLoss; }
+    QVariantList quadrantReordered()   const { return m_stats.quadReordered; }
+    QVariantList quadrantDuplicated()  const { return m_stats.quadDuplicated; }
+    Q_INVOKABLE void resetLinkStats();
+    /** Publish the decode-side counters now. */
+    Q_INVOKABLE void refreshStats();
+
+    Q_INVOKABLE bool startRecording(const QString &path);
+    Q_INVOKABLE void stopRecording();
+    Q_INVOKABLE bool startReplay(const QString &path, double speed = 1.0);
+    Q_INVOKABLE void stopReplay();
+
+    bool    recording()     const { return m_stats.recording; }
+    bool    replaying()     const { return m_stats.replaying; }
+    QString replaySummary() const { return m_stats.replaySummary; }
+
+    /** Decode one antenna packet into the model (socket, replay and
+     *  benchmarks all go through here; ingest thread only). Returns false
+     *  if not decodable. */
+    bool handleDatagram(const uchar *p, int len);
 
 signals:
     void listeningChanged();
     void packetCountChanged();
+    void captureStateChanged();
+    void replayFinished();
+    /** A delta arrived that cannot be applied; the sender should follow
+     *  up with a 0x14 keyframe. */
+    void keyframeRequested();
+
+private:
+    // QML-visible counters, copied from the decode side
+    struct Stats {
+        bool    listening = false, recording = false, replaying = false, synced = false;
+        int     packets = 0, kernelDrops = 0, resyncs = 0;
+        int     chunkFramesComplete = 0, chunkFramesPartial = 0;
+        int     lost = 0, reordered = 0, duplicated = 0;
+        double  lossPercent = 0.0;
+        QVariantList quadLoss, quadReordered, quadDuplicated;
+        QString replaySummary;
+    };
+    // Signals emitted when a Stats copy is taken over
+    enum Notify { Listening = 1, PacketCount = 2, CaptureState = 4, ReplayDone = 8 };
+
+    Stats collectStats() const;                         // decode thread
+    void  adoptStats(const Stats &s, int notify);       // receiver thread
+    void  publishStats(int notify);                     // decode thread, queued if threaded
+
+    // Run fn on the decode thread and wait for it, then take over the
+    // counters and emit the notify signals on the calling thread
+    template <typename F>
+    void onDecoder(F fn, int notify)
+    {
+        Stats s;
+        QMetaObject::invokeMethod(m_ctx, [&]() { fn(); s = collectStats(); },
+                                  m_ctx->thread() == QThread::currentThread()
+                                      ? Qt::DirectConnection : Qt::BlockingQueuedConnection);
+        adoptStats(s, notify);
+    }
 
-private slots:
+    // ── Decode thread ───────────────────────────────────────────────
     void onReadyRead();
+    void closeSocket();
+    void loseSync();
+    void keyframeApplied(quint32 keySeq, quint32 lastSeq);
+    bool handleChunk(const uchar *p, int len);
 
-private:
-    static float decodePower  (quint16 raw) { return raw / 100.0f - 10.0f; }
-    static float decodeTemp   (quint16 raw) { return raw / 10.0f; }
-    static float decodeCurrent(quint16 raw) { return raw / 1000.0f; }
-    static quint16 readU16(const uchar *p)  { return quint16(p[0]) | (quint16(p[1]) << 8); }
+    // Per-quadrant link counters (same meaning as SeqTracker's)
+    struct QuadLink {
+        quint64 received = 0, lost = 0, reordered = 0, duplicates = 0;
+    };
+    void trackSequenced(quint32 seq, const uchar *p, int len);
+    void markQuadrants(int firstGid, int count);
+    void chargeLoss(quint32 from, quint32 to, const uchar *p);
+    static int clampCount(quint64 n) { return int(qMin<quint64>(n, INT_MAX)); }
 
     RadarModel *m_model   = nullptr;
+    Stats       m_stats;                // receiver thread
+    QObject    *m_ctx     = nullptr;    // decode context; owns socket, reader and replayer
+
+    // Decode side: touched on the decode thread only (the socket options
+    // are set before listening and read when the socket is opened)
     QUdpSocket *m_socket  = nullptr;
+    DatagramBatchReader *m_reader = nullptr;
     int         m_pktCount = 0;
+    int         m_rcvBufBytes = 0;
+    int         m_batchSize   = 32;
+
+    // 0x13 / 0x14 sequencing
+    bool        m_synced       = false;
+    quint32     m_keySeq       = 0;     // seq of the keyframe deltas must reference
+    quint32     m_lastSeq      = 0;     // last applied 0x13 / 0x14
+    int         m_deltaResyncs = 0;
+    int         m_unsyncedDeltas = 0;   // deltas dropped since losing sync
+
+    // 0x15 reassembly (one frame in flight)
+    bool          m_chunkActive   = false;
+    quint32       m_chunkFrame    = 0;
+    int           m_chunkCount    = 0;
+    int           m_chunkReceived = 0;
+    QVector<bool> m_chunkSeen;          // [chunk_idx]
+    int           m_chunkStride   = 0;  // elements per chunk (0 = not yet known)
+    int           m_chunkFramesComplete = 0;
+    int           m_chunkFramesPartial  = 0;
+
+    // Link quality
+    SeqTracker        m_link;
+    QVector<QuadLink> m_quadLink;       // [q]
+    QVector<quint8>   m_touched;        // [q] scratch: quadrants in the current datagram
+
+    FrameCaptureWriter m_recorder;
+    QString        m_captureTag;            // "antenna:<port>"
+    FrameReplayer *m_replayer = nullptr;
+    quint64        m_replayRejected = 0;
+    QString        m_replaySummary;
 };
@@ -40,6 +40,16 @@ SOURCES += \
     analytics.cpp \
     analyticsdashboard.cpp \
     messageserver.cpp \
+    healthmessageparser.cpp \
+    fasthealthjson.cpp \
+    binaryhealthframe.cpp \
+    ingestworker.cpp \
+    ingeststats.cpp \
+    ingestdiagnosticspanel.cpp \
+    framecapture.cpp \
+    replayprotocolhandler.cpp \
+    datagrambatchreader.cpp \
+    healthstatecache.cpp \
     componentregistry.cpp \
     addcomponentdialog.cpp \
     editcomponentdialog.cpp \
@@ -54,10 +64,13 @@ SOURCES += \
     canprotocolhandler.cpp \
     protocolhandlerfactory.cpp \
     trmgridview.cpp \
+    AntennaConfig.cpp \
     RadarModel.cpp \
+    ElementHistory.cpp \
     UdpReceiver.cpp \
     SimulatorEngine.cpp \
     CommandSender.cpp \
+    ElementGridItem.cpp \
     radarantennawidget.cpp
 
 HEADERS += \
@@ -73,6 +86,19 @@ HEADERS += \
     analytics.h \
     analyticsdashboard.h \
     messageserver.h \
+    healthupdate.h \
+    healthmessageparser.h \
+    fasthealthjson.h \
+    trmrecord.h \
+    binaryhealthframe.h \
+    spscqueue.h \
+    ingestworker.h \
+    ingeststats.h \
+    ingestdiagnosticspanel.h \
+    framecapture.h \
+    replayprotocolhandler.h \
+    datagrambatchreader.h \
+    healthstatecache.h \
     componentregistry.h \
     addcomponentdialog.h \
     editcomponentdialog.h \
@@ -89,16 +115,19 @@ HEADERS += \
     trmgridview.h \
     AntennaConfig.h \
     RadarModel.h \
+    ElementHistory.h \
     UdpReceiver.h \
+    SeqTracker.h \
     SimulatorEngine.h \
     CommandSender.h \
+    ElementGridItem.h \
     radarantennawidget.h
 
 RESOURCES += \
     resources.qrc
 
-# Copy components.json to build directory
-config_file.files = components.json
+# Copy components.json and antennas.json to build directory
+config_file.files = components.json antennas.json
 config_file.path = $$OUT_PWD
 INSTALLS += config_file
 
@@ -40,7 +40,7 @@ void Analytics::removeComponent(const QString& id)
     updateDisplay();
 }
 
-void Analytics::recordMessage(const QString& id, const QString& color, qreal size)
+void Analytics::recordMessage(const QString& id, const QString& color, qreal size, bool refresh)
 {
     if (!m_stats.contains(id)) {
         m_stats[id] = ComponentStats();
@@ -76,7 +76,8 @@ void Analytics::recordMessage(const QString& id, const QString& color, qreal siz
     if (stats.sizeHistory.size() > 10)
         stats.sizeHistory.removeFirst();
 
-    updateDisplay();
+    if (refresh)
+        updateDisplay();
 }
 
 void Analytics::addDesignSubComponent(const QString& parentId, const QString& subType)
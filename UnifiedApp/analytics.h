@@ -54,7 +54,8 @@ public:
 
     void addComponent(const QString& id, const QString& type);
     void removeComponent(const QString& id);
-    void recordMessage(const QString& id, const QString& color, qreal size);
+    /** Record one health message; pass refresh = false to batch display updates. */
+    void recordMessage(const QString& id, const QString& color, qreal size, bool refresh = true);
 
     /** Track a design sub-component being added to a parent component. */
     void addDesignSubComponent(const QString& parentId, const QString& subType);
@@ -0,0 +1,165 @@
+#include "binaryhealthframe.h"
+#include "healthmessageparser.h"
+#include <QDebug>
+
+namespace {
+
+// Bounds-checked little-endian cursor over one frame
+struct Reader {
+    const uchar* p;
+    const uchar* end;
+    bool ok = true;
+
+    Reader(const uchar* begin, const uchar* e) : p(begin), end(e) {}
+
+    bool need(int n) {
+        if (!ok || end - p < n) ok = false;
+        return ok;
+    }
+    quint8 u8() {
+        if (!need(1)) return 0;
+        return *p++;
+    }
+    quint16 u16() {
+        if (!need(2)) return 0;
+        quint16 v = quint16(p[0]) | (quint16(p[1]) << 8);
+        p += 2;
+        return v;
+    }
+    QString str() {
+        int len = u8();
+        if (!need(len)) return QString();
+        QString s = QString::fromUtf8(reinterpret_cast<const char*>(p), len);
+        p += len;
+        return s;
+    }
+};
+
+const char* const kStatusColors[] = {
+    "#00FF00", "#FFFF00", "#FFA500", "#FF0000", "#808080"
+};
+
+QString trmStatusForHealth(qreal h)
+{
+    if (h >= 90) return QStringLiteral("HEALTHY");
+    if (h >= 70) return QStringLiteral("WARNING");
+    if (h >= 40) return QStringLiteral("DEGRADED");
+    if (h >= 10) return QStringLiteral("CRITICAL");
+    return QStringLiteral("OFFLINE");
+}
+
+} // namespace
+
+bool BinaryHealthDecoder::decode(const QByteArray& data, QVector<HealthUpdate>& out)
+{
+    const char* raw = data.constData();
+    quint32 frameLen = BinaryHealthFrame::frameLength(raw, data.size());
+    if (frameLen < quint32(BinaryHealthFrame::HeaderSize) || frameLen > quint32(data.size())) {
+        qDebug() << "[MessageServer] Truncated binary health frame";
+        return false;
+    }
+    const uchar* base = reinterpret_cast<const uchar*>(raw);
+    if (base[1] != BinaryHealthFrame::Version) {
+        qDebug() << "[MessageServer] Unsupported binary frame version" << base[1];
+        return false;
+    }
+    const quint8 flags = base[2];
+
+    Reader r(base + BinaryHealthFrame::HeaderSize, base + frameLen);
+    QString componentId;
+    int channel = -1;
+    if (flags & BinaryHealthFrame::HasChannel) {
+        channel = r.u16();              // resolved to a component by MessageServer
+    } else {
+        componentId = r.str();
+        if (r.ok && componentId.isEmpty()) r.ok = false;
+    }
+    if (!r.ok) {
+        qDebug() << "[MessageServer] Missing component_id in binary frame";
+        return false;
+    }
+
+    QHash<quint8, QString>& dict =
+        m_dictionaries[channel >= 0 ? QLatin1Char('#') + QString::number(channel) : componentId];
+    if (flags & BinaryHealthFrame::HasDictionary) {
+        int n = r.u8();
+        for (int i = 0; i < n && r.ok; ++i) {
+            quint8 idx = r.u8();
+            QString name = r.str();
+            if (r.ok) dict.insert(idx, name);
+        }
+    }
+
+    QVector<HealthUpdate> decoded;
+
+    // ── Component-level health ───────────────────────────────────────
+    if (flags & BinaryHealthFrame::HasComponent) {
+        quint16 health = r.u16();
+        quint8 status  = r.u8();
+        HealthUpdate u;
+        u.kind = HealthUpdate::Component;
+        u.componentId = componentId;
+        u.channel = channel;
+        u.value = health / 10.0;
+        u.color = QString::fromLatin1(kStatusColors[status < 5 ? status : 4]);
+        decoded.append(u);
+    }
+
+    // ── Interned subsystem health ────────────────────────────────────
+    if (flags & BinaryHealthFrame::HasSubsystems) {
+        int n = r.u8();
+        for (int i = 0; i < n && r.ok; ++i) {
+            quint8 idx = r.u8();
+            qreal health = r.u16() / 10.0;
+            auto it = dict.constFind(idx);
+            if (it == dict.constEnd()) { ++m_unresolved; continue; }
+            HealthUpdate u;
+            u.kind = HealthUpdate::Subsystem;
+            u.componentId = componentId;
+            u.channel = channel;
+            u.subsystem = it.value();
+            u.value = health;
+            u.color = HealthMessageParser::colorForHealth(health);
+            decoded.append(u);
+        }
+    }
+
+    // ── Packed TRM array ─────────────────────────────────────────────
+    if (flags & BinaryHealthFrame::HasTrm) {
+        int n = r.u16();
+        if (r.need(n * BinaryHealthFrame::TrmRecordSize) && n > 0) {
+            HealthUpdate u;
+            u.kind = HealthUpdate::Trm;
+            u.componentId = componentId;
+            u.channel = channel;
+            u.trms.resize(n);
+            for (int i = 0; i < n; ++i) {
+                const uchar* t = r.p + i * BinaryHealthFrame::TrmRecordSize;
+                qreal health = (quint16(t[2]) | (quint16(t[3]) << 8)) / 10.0;
+                quint8 tf = t[10];
+                TrmRecord& d = u.trms[i];
+                d.id       = int(quint16(t[0]) | (quint16(t[1]) << 8));
+                d.quadrant = t[8] == 0xFF ? -1 : int(t[8]);
+                d.channel  = t[9] == 0xFF ? -1 : int(t[9]);
+                d.health   = health;
+                d.color    = HealthMessageParser::colorForHealth(health);
+                d.status   = trmStatusForHealth(health);
+                d.on       = (tf & 0x01) != 0;
+                if (tf & 0x02) d.trip = QStringLiteral("Tripped");
+                if (tf & 0x04) d.bit  = QStringLiteral("Fault");
+                d.voltage  = (quint16(t[4]) | (quint16(t[5]) << 8)) / 100.0;
+                d.current  = (quint16(t[6]) | (quint16(t[7]) << 8)) / 1000.0;
+            }
+            r.p += n * BinaryHealthFrame::TrmRecordSize;
+            decoded.append(u);
+        }
+    }
+
+    if (!r.ok) {
+        qDebug() << "[MessageServer] Malformed binary health frame from"
+                 << (channel >= 0 ? QString("channel %1").arg(channel) : componentId);
+        return false;
+    }
+    out += decoded;
+    return true;
+}
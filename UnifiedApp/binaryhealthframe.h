@@ -0,0 +1,99 @@
+#ifndef BINARYHEALTHFRAME_H
+#define BINARYHEALTHFRAME_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "healthupdate.h"
+
+/**
+ * Compact binary health frame (version 1).
+ *
+ * Sent alongside the JSON protocol on the same transports. The first byte
+ * (0xB5) can never start a JSON document, so HealthMessageParser selects the
+ * decoder by looking at it. All multi-byte fields are little-endian.
+ *
+ *   Header (8 bytes)
+ *     [0]    u8   magic     0xB5
+ *     [1]    u8   version   0x01
+ *     [2]    u8   flags     bit0 DICT | bit1 COMPONENT | bit2 SUBSYSTEMS | bit3 TRM
+ *                          | bit4 CHANNEL
+ *     [3]    u8   reserved  0
+ *     [4..7] u32  frame length in bytes, header included
+ *
+ *   Body (always the address, then each section whose flag is set, in order)
+ *     address      : component_id as u8 len, len × UTF-8
+ *                    or, with CHANNEL set, a u16 channel ID that MessageServer
+ *                    maps to a component through its routing table
+ *     DICT         : u8 n, n × { u8 subsystemIdx, u8 len, len × UTF-8 name }
+ *     COMPONENT    : u16 health×10, u8 status (0 op, 1 warn, 2 deg, 3 crit, 4 off)
+ *     SUBSYSTEMS   : u8 n, n × { u8 subsystemIdx, u16 health×10 }
+ *     TRM          : u16 n, n × 12-byte record
+ *                      u16 id, u16 health×10, u16 voltage×100, u16 current×1000,
+ *                      u8 quadrant (0xFF = none), u8 channel (0xFF = none),
+ *                      u8 flags (bit0 on, bit1 tripped, bit2 BIT fault), u8 reserved
+ *
+ * Subsystem names are interned per component: the sender assigns each name a
+ * one-byte index and transmits the DICT section on the first frame and then
+ * periodically (so a restarted receiver re-learns it). Frames referring to an
+ * index that has not been defined yet are decoded without those entries.
+ *
+ * APCU telemetry is not part of the binary format; senders keep using a JSON
+ * frame for it.
+ */
+namespace BinaryHealthFrame {
+    const quint8 Magic   = 0xB5;
+    const quint8 Version = 0x01;
+    const int    HeaderSize    = 8;
+    const int    TrmRecordSize = 12;
+    const quint32 MaxFrameSize = 4u * 1024u * 1024u;   // sanity bound for stream resync
+
+    enum Flag : quint8 {
+        HasDictionary = 0x01,
+        HasComponent  = 0x02,
+        HasSubsystems = 0x04,
+        HasTrm        = 0x08,
+        HasChannel    = 0x10
+    };
+
+    /** True if @p data starts with the binary frame magic byte. */
+    inline bool isBinary(const QByteArray& data)
+    {
+        return !data.isEmpty() && static_cast<quint8>(data.at(0)) == Magic;
+    }
+
+    /**
+     * Total frame length announced by a header at @p p, or 0 if fewer than
+     * HeaderSize bytes are available or the magic byte does not match.
+     * Used by stream transports to delimit binary frames.
+     */
+    inline quint32 frameLength(const char* p, qint64 available)
+    {
+        if (available < HeaderSize || static_cast<quint8>(p[0]) != Magic) return 0;
+        const uchar* u = reinterpret_cast<const uchar*>(p);
+        return quint32(u[4]) | (quint32(u[5]) << 8) | (quint32(u[6]) << 16) | (quint32(u[7]) << 24);
+    }
+}
+
+/**
+ * BinaryHealthDecoder – Decodes BinaryHealthFrame v1 into HealthUpdates.
+ *
+ * Holds the per-component subsystem dictionaries, so one decoder instance
+ * must only be used from one thread (MessageServer keeps one for the GUI
+ * thread, each IngestWorker owns its own).
+ */
+class BinaryHealthDecoder
+{
+public:
+    bool decode(const QByteArray& data, QVector<HealthUpdate>& out);
+
+    /** Subsystem entries skipped because their index was not yet defined. */
+    quint64 unresolvedEntries() const { return m_unresolved; }
+
+private:
+    QHash<QString, QHash<quint8, QString>> m_dictionaries;   // componentId (or "#channel") → idx → name
+    quint64 m_unresolved = 0;
+};
+
+#endif // BINARYHEALTHFRAME_H
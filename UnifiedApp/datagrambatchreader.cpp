@@ -0,0 +1,141 @@
+#include "datagrambatchreader.h"
+#include <QSocketNotifier>
+#include <QDebug>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+DatagramBatchReader::DatagramBatchReader(QUdpSocket* socket, int batchSize,
+                                         int maxDatagramSize, QObject* parent)
+    : QObject(parent)
+    , m_socket(socket)
+    , m_batch(qBound(1, batchSize, 1024))
+    , m_slotSize(qBound(512, maxDatagramSize, 65536))
+    , m_slab(m_batch * m_slotSize, Qt::Uninitialized)
+    , m_lengths(static_cast<std::size_t>(m_batch), -1)
+{
+#ifdef Q_OS_LINUX
+    const int sd = static_cast<int>(m_socket->socketDescriptor());
+    m_fd = sd >= 0 ? ::dup(sd) : -1;
+    if (m_fd >= 0) {
+#ifdef SO_RXQ_OVFL
+        int on = 1;
+        if (::setsockopt(m_fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on)) != 0)
+            qWarning() << "[UDP] SO_RXQ_OVFL unavailable:" << std::strerror(errno);
+#endif
+        m_controlSize = static_cast<int>(CMSG_SPACE(sizeof(quint32)));
+        m_msgs.resize(static_cast<std::size_t>(m_batch));
+        m_iov.resize(static_cast<std::size_t>(m_batch));
+        m_control.assign(static_cast<std::size_t>(m_batch * m_controlSize), 0);
+
+        char* slab = m_slab.data();
+        for (int i = 0; i < m_batch; ++i) {
+            m_iov[i].iov_base = slab + i * m_slotSize;
+            m_iov[i].iov_len  = static_cast<std::size_t>(m_slotSize);
+            std::memset(&m_msgs[i], 0, sizeof(mmsghdr));
+            m_msgs[i].msg_hdr.msg_iov     = &m_iov[i];
+            m_msgs[i].msg_hdr.msg_iovlen  = 1;
+            m_msgs[i].msg_hdr.msg_control = m_control.data() + i * m_controlSize;
+        }
+
+        m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated,
+                this, &DatagramBatchReader::readyRead);
+        return;
+    }
+    qWarning() << "[UDP] recvmmsg path unavailable, falling back to readDatagram()";
+#endif
+    connect(m_socket, &QUdpSocket::readyRead, this, &DatagramBatchReader::readyRead);
+}
+
+DatagramBatchReader::~DatagramBatchReader()
+{
+    delete m_notifier;
+    m_notifier = nullptr;
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) ::close(m_fd);
+#endif
+}
+
+void DatagramBatchReader::setReceiveBufferSize(int bytes)
+{
+    if (bytes <= 0) return;
+    m_socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, bytes);
+#if defined(Q_OS_LINUX) && defined(SO_RCVBUFFORCE)
+    // SO_RCVBUF is capped at net.core.rmem_max; with CAP_NET_ADMIN we may exceed it
+    // (the kernel reports double the requested size to account for bookkeeping).
+    if (m_fd >= 0 && receiveBufferSize() < bytes)
+        ::setsockopt(m_fd, SOL_SOCKET, SO_RCVBUFFORCE, &bytes, sizeof(bytes));
+#endif
+    if (receiveBufferSize() < bytes)
+        qWarning() << "[UDP] Receive buffer limited to" << receiveBufferSize()
+                   << "bytes (requested" << bytes << ")";
+}
+
+int DatagramBatchReader::receiveBufferSize() const
+{
+    return m_socket->socketOption(QAbstractSocket::ReceiveBufferSizeSocketOption).toInt();
+}
+
+int DatagramBatchReader::readBatch()
+{
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        for (int i = 0; i < m_batch; ++i) {
+            m_msgs[i].msg_hdr.msg_controllen = static_cast<std::size_t>(m_controlSize);
+            m_msgs[i].msg_hdr.msg_flags = 0;
+            m_msgs[i].msg_len = 0;
+        }
+
+        int n;
+        do {
+            n = ::recvmmsg(m_fd, m_msgs.data(), static_cast<unsigned>(m_batch),
+                           MSG_DONTWAIT, nullptr);
+        } while (n < 0 && errno == EINTR);
+
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                qWarning() << "[UDP] recvmmsg failed:" << std::strerror(errno);
+            return 0;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            msghdr& h = m_msgs[i].msg_hdr;
+#ifdef SO_RXQ_OVFL
+            for (cmsghdr* c = CMSG_FIRSTHDR(&h); c; c = CMSG_NXTHDR(&h, c)) {
+                if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL) {
+                    quint32 drops;
+                    std::memcpy(&drops, CMSG_DATA(c), sizeof(drops));
+                    m_kernelDrops = drops;   // cumulative since socket creation
+                }
+            }
+#endif
+            if (h.msg_flags & MSG_TRUNC) {
+                ++m_truncated;
+                m_lengths[i] = -1;
+            } else {
+                m_lengths[i] = static_cast<int>(m_msgs[i].msg_len);
+            }
+        }
+        return n;
+    }
+#endif
+
+    int n = 0;
+    char* slab = m_slab.data();
+    while (n < m_batch && m_socket->hasPendingDatagrams()) {
+        if (m_socket->pendingDatagramSize() > m_slotSize) {
+            char discard;
+            m_socket->readDatagram(&discard, 1);
+            ++m_truncated;
+            m_lengths[n++] = -1;
+            continue;
+        }
+        qint64 len = m_socket->readDatagram(slab + n * m_slotSize, m_slotSize);
+        m_lengths[n++] = len < 0 ? -1 : static_cast<int>(len);
+    }
+    return n;
+}
@@ -0,0 +1,114 @@
+#ifndef DATAGRAMBATCHREADER_H
+#define DATAGRAMBATCHREADER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QUdpSocket>
+#include <vector>
+
+class QSocketNotifier;
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+/**
+ * DatagramBatchReader – Drains a bound QUdpSocket in batches into a
+ * preallocated slab instead of one QNetworkDatagram (and one heap
+ * allocation) per packet.
+ *
+ * Linux fast path:
+ *   - recvmmsg(2) pulls up to batchSize datagrams per syscall directly into
+ *     fixed slots of the slab (no per-packet allocation)
+ *   - SO_RXQ_OVFL is enabled so the kernel reports how many datagrams it
+ *     dropped because the socket receive buffer was full (kernelDrops())
+ *   - the reader reads from its own dup() of the descriptor, watched by its
+ *     own QSocketNotifier (a second notifier on the same fd would clash with
+ *     QUdpSocket's); QUdpSocket::readyRead() is not used on this path
+ * Other platforms fall back to QUdpSocket::readDatagram() into the same
+ * slab, driven by readyRead().
+ *
+ * Usage:
+ *   reader = new DatagramBatchReader(socket, 32, 65536, this);
+ *   reader->setReceiveBufferSize(4 << 20);
+ *   connect(reader, &DatagramBatchReader::readyRead, this, [this] {
+ *       reader->drain([](const char* data, int len) { ... });
+ *   });
+ *
+ * The pointers handed to the drain callback refer to the slab and are only
+ * valid until the callback returns. Because the duplicated descriptor keeps
+ * the socket open, destroy the reader before closing the QUdpSocket.
+ */
+class DatagramBatchReader : public QObject
+{
+    Q_OBJECT
+public:
+    DatagramBatchReader(QUdpSocket* socket, int batchSize = 32,
+                        int maxDatagramSize = 65536, QObject* parent = nullptr);
+    ~DatagramBatchReader() override;
+
+    /** Request an SO_RCVBUF size (bytes); the kernel may clamp it. */
+    void setReceiveBufferSize(int bytes);
+    /** Effective receive buffer size reported by the kernel. */
+    int  receiveBufferSize() const;
+
+    /** True when the recvmmsg fast path is active. */
+    bool isBatched() const { return m_notifier != nullptr; }
+    int  batchSize() const { return m_batch; }
+
+    /** Datagrams dropped by the kernel on this socket (SO_RXQ_OVFL). */
+    quint64 kernelDrops() const { return m_kernelDrops; }
+    /** Datagrams larger than maxDatagramSize (discarded). */
+    quint64 truncatedDatagrams() const { return m_truncated; }
+
+    /**
+     * Read all currently queued datagrams (bounded per call so the event
+     * loop is not starved) and invoke fn(const char* data, int len) for each.
+     * Returns the number of datagrams delivered.
+     */
+    template <typename Fn>
+    int drain(Fn fn)
+    {
+        int total = 0;
+        for (int round = 0; round < kMaxRoundsPerDrain; ++round) {
+            int n = readBatch();
+            for (int i = 0; i < n; ++i) {
+                if (m_lengths[i] >= 0)
+                    fn(m_slab.constData() + i * m_slotSize, m_lengths[i]);
+            }
+            total += n;
+            if (n < m_batch) break;
+        }
+        return total;
+    }
+
+signals:
+    /** Datagrams are waiting; call drain(). */
+    void readyRead();
+
+private:
+    static const int kMaxRoundsPerDrain = 16;
+
+    int readBatch();   // fills m_lengths[0..n), returns n (0 if nothing queued)
+
+    QUdpSocket*      m_socket;
+    QSocketNotifier* m_notifier = nullptr;
+    int              m_batch;
+    int              m_slotSize;
+    QByteArray       m_slab;              // m_batch × m_slotSize bytes
+    std::vector<int> m_lengths;           // payload length per slot, -1 = skip
+
+#ifdef Q_OS_LINUX
+    int                  m_fd = -1;
+    std::vector<mmsghdr> m_msgs;
+    std::vector<iovec>   m_iov;
+    std::vector<char>    m_control;       // per-slot cmsg space for SO_RXQ_OVFL
+    int                  m_controlSize = 0;
+#endif
+
+    quint64 m_kernelDrops = 0;
+    quint64 m_truncated   = 0;
+};
+
+#endif // DATAGRAMBATCHREADER_H
@@ -617,10 +617,10 @@ void EnlargedComponentView::updateSubcomponentHealth(const QString& /*subName*/,
     // Subsystem health bars shown in the subsystem overview dots/percentages
 }
 
-void EnlargedComponentView::updateTrmData(const QJsonArray& trmArray)
+void EnlargedComponentView::updateTrmData(const TrmRecordList& trms)
 {
     if (m_trmGrid) {
-        m_trmGrid->updateTrmData(trmArray);
+        m_trmGrid->updateTrmData(trms);
     }
 }
 
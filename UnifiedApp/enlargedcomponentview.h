@@ -69,7 +69,7 @@ public:
 
     void updateComponentHealth(const QColor& color, qreal size);
     void updateSubcomponentHealth(const QString& subName, qreal health, const QColor& color);
-    void updateTrmData(const QJsonArray& trmArray);
+    void updateTrmData(const TrmRecordList& trms);
     void updateDisplayName(const QString& newDisplayName);
     void updateFromComponent(Component* sourceComponent);
     QString getComponentId() const { return m_componentId; }
@@ -0,0 +1,487 @@
+#include "fasthealthjson.h"
+#include "healthmessageparser.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPair>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FASTHEALTHJSON_SSE2 1
+#endif
+
+namespace {
+
+inline bool isWs(char c)    { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// First '"' or '\\' in [p, end), or end
+inline const char* findQuoteOrEscape(const char* p, const char* end)
+{
+#ifdef FASTHEALTHJSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i slash = _mm_set1_epi8('\\');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                                  _mm_cmpeq_epi8(v, slash)));
+        if (mask) return p + qCountTrailingZeroBits(quint32(mask));
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '"' && *p != '\\') ++p;
+    return p;
+}
+
+// First '"', '{', '}', '[' or ']' in [p, end), or end
+inline const char* findStructural(const char* p, const char* end)
+{
+#ifdef FASTHEALTHJSON_SSE2
+    // '[' | 0x20 == '{' and ']' | 0x20 == '}', so two compares cover all brackets
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i case20 = _mm_set1_epi8(0x20);
+    const __m128i open  = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i f = _mm_or_si128(v, case20);
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                 _mm_or_si128(_mm_cmpeq_epi8(f, open), _mm_cmpeq_epi8(f, close)));
+        int mask = _mm_movemask_epi8(m);
+        if (mask) return p + qCountTrailingZeroBits(quint32(mask));
+        p += 16;
+    }
+#endif
+    for (; p < end; ++p) {
+        char c = *p;
+        if (c == '"' || c == '{' || c == '}' || c == '[' || c == ']') return p;
+    }
+    return p;
+}
+
+const double kPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+int hex4(const char* p, const char* end)
+{
+    if (end - p < 4) return -1;
+    int v = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = p[i];
+        int d = (c >= '0' && c <= '9') ? c - '0'
+              : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+              : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (d < 0) return -1;
+        v = (v << 4) | d;
+    }
+    return v;
+}
+
+void appendUtf8(QByteArray& out, uint cp)
+{
+    if (cp < 0x80) {
+        out.append(char(cp));
+    } else if (cp < 0x800) {
+        out.append(char(0xC0 | (cp >> 6)));
+        out.append(char(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.append(char(0xE0 | (cp >> 12)));
+        out.append(char(0x80 | ((cp >> 6) & 0x3F)));
+        out.append(char(0x80 | (cp & 0x3F)));
+    } else {
+        out.append(char(0xF0 | (cp >> 18)));
+        out.append(char(0x80 | ((cp >> 12) & 0x3F)));
+        out.append(char(0x80 | ((cp >> 6) & 0x3F)));
+        out.append(char(0x80 | (cp & 0x3F)));
+    }
+}
+
+// Decode the body of a JSON string that contains escape sequences
+QString unescape(const char* p, int len)
+{
+    QByteArray utf8;
+    utf8.reserve(len);
+    const char* end = p + len;
+    while (p < end) {
+        char c = *p++;
+        if (c != '\\' || p >= end) { utf8.append(c); continue; }
+        char e = *p++;
+        switch (e) {
+        case 'b': utf8.append('\b'); break;
+        case 'f': utf8.append('\f'); break;
+        case 'n': utf8.append('\n'); break;
+        case 'r': utf8.append('\r'); break;
+        case 't': utf8.append('\t'); break;
+        case 'u': {
+            int cp = hex4(p, end);
+            if (cp < 0) { utf8.append("\xEF\xBF\xBD"); break; }
+            p += 4;
+            if (cp >= 0xD800 && cp < 0xDC00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                int lo = hex4(p + 2, end);
+                if (lo >= 0xDC00 && lo < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    p += 6;
+                }
+            }
+            appendUtf8(utf8, uint(cp));
+            break;
+        }
+        default:  utf8.append(e); break;     // '"', '\\', '/'
+        }
+    }
+    return QString::fromUtf8(utf8);
+}
+
+struct Span {
+    const char* p = nullptr;
+    int  len = 0;
+    bool escaped = false;
+};
+
+template <int N>
+inline bool keyIs(const Span& s, const char (&lit)[N])
+{
+    return !s.escaped && s.len == N - 1 && std::memcmp(s.p, lit, N - 1) == 0;
+}
+
+// Cursor over one JSON document; any syntax error clears ok and sticks
+struct Scanner {
+    const char* p;
+    const char* end;
+    bool ok = true;
+
+    Scanner(const char* b, const char* e) : p(b), end(e) {}
+
+    void ws() { while (p < end && isWs(*p)) ++p; }
+    char peek() { ws(); return p < end ? *p : '\0'; }
+    bool consume(char c) { if (peek() == c) { ++p; return true; } return false; }
+    bool expect(char c) { if (!consume(c)) ok = false; return ok; }
+
+    bool string(Span& s)
+    {
+        if (!consume('"')) return ok = false;
+        const char* start = p;
+        bool escaped = false;
+        for (;;) {
+            p = findQuoteOrEscape(p, end);
+            if (p >= end) return ok = false;
+            if (*p == '"') break;
+            escaped = true;
+            p += 2;                         // skip '\' and the escaped character
+        }
+        s.p = start;
+        s.len = int(p - start);
+        s.escaped = escaped;
+        ++p;
+        return true;
+    }
+
+    bool literal(const char* lit, int n)
+    {
+        if (end - p < n || std::memcmp(p, lit, size_t(n)) != 0) return ok = false;
+        p += n;
+        return true;
+    }
+
+    bool number(double& v)
+    {
+        ws();
+        const char* begin = p;
+        bool neg = false;
+        if (p < end && *p == '-') { neg = true; ++p; }
+
+        quint64 mant = 0;
+        int digits = 0, exp10 = 0;
+        bool any = false;
+        for (; p < end && isDigit(*p); ++p) {
+            int d = *p - '0';
+            any = true;
+            if (mant == 0 && d == 0) continue;
+            if (digits < 19) { mant = mant * 10 + quint64(d); ++digits; }
+            else             { ++exp10; }
+        }
+        if (p < end && *p == '.') {
+            ++p;
+            for (; p < end && isDigit(*p); ++p) {
+                int d = *p - '0';
+                any = true;
+                if (mant == 0 && d == 0)  { --exp10; continue; }
+                if (digits < 19) { mant = mant * 10 + quint64(d); ++digits; --exp10; }
+            }
+        }
+        if (!any) return ok = false;
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            bool eneg = false;
+            if (p < end && (*p == '+' || *p == '-')) eneg = (*p++ == '-');
+            if (p >= end || !isDigit(*p)) return ok = false;
+            int e = 0;
+            for (; p < end && isDigit(*p); ++p)
+                if (e < 10000) e = e * 10 + (*p - '0');
+            exp10 += eneg ? -e : e;
+        }
+
+        // Exact when the mantissa fits a double and the scale is a power of
+        // ten that is itself exact; otherwise let Qt do correct rounding.
+        if (mant < (quint64(1) << 53) && exp10 >= -22 && exp10 <= 22) {
+            double d = double(mant);
+            d = exp10 < 0 ? d / kPow10[-exp10] : d * kPow10[exp10];
+            v = neg ? -d : d;
+        } else {
+            bool conv = false;
+            v = QByteArray(begin, int(p - begin)).toDouble(&conv);
+            if (!conv) return ok = false;
+        }
+        return true;
+    }
+
+    bool skipValue()
+    {
+        char c = peek();
+        if (c == '"') { Span s; return string(s); }
+        if (c != '{' && c != '[') {
+            const char* b = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ']' && !isWs(*p)) ++p;
+            if (p == b) ok = false;
+            return ok;
+        }
+        int depth = 0;
+        while (p < end) {
+            p = findStructural(p, end);
+            if (p >= end) break;
+            char s = *p;
+            if (s == '"') { Span tmp; if (!string(tmp)) return false; continue; }
+            ++p;
+            if (s == '{' || s == '[') ++depth;
+            else if (--depth == 0) return true;
+        }
+        return ok = false;
+    }
+
+    // ── Typed values with QJsonValue::toX() fallback semantics ──────────
+
+    bool stringValue(Span& s)
+    {
+        if (peek() == '"') return string(s);
+        skipValue();
+        return false;
+    }
+
+    double numberValue(double def)
+    {
+        char c = peek();
+        if (c == '-' || isDigit(c)) {
+            double v;
+            return number(v) ? v : def;
+        }
+        skipValue();
+        return def;
+    }
+
+    int intValue(int def)
+    {
+        double v = numberValue(double(def));
+        return (v >= -2147483648.0 && v <= 2147483647.0 && int(v) == v) ? int(v) : def;
+    }
+
+    bool boolValue(bool def)
+    {
+        char c = peek();
+        if (c == 't') return literal("true", 4) ? true : def;
+        if (c == 'f') return literal("false", 5) ? false : def;
+        skipValue();
+        return def;
+    }
+};
+
+} // namespace
+
+QString FastHealthJsonDecoder::InternCache::get(const char* p, int len, bool escaped)
+{
+    for (const InternSlot& s : m_slots) {
+        if (!s.raw.isNull() && s.raw.size() == len && std::memcmp(s.raw.constData(), p, size_t(len)) == 0)
+            return s.value;
+    }
+    InternSlot& s = m_slots[m_next];
+    m_next = (m_next + 1) % m_slots.size();
+    s.raw = QByteArray(p, len);
+    s.value = escaped ? unescape(p, len) : QString::fromUtf8(p, len);
+    return s.value;
+}
+
+FastHealthJsonDecoder::FastHealthJsonDecoder()
+    : m_colors(8)
+    , m_status(8)
+    , m_flags(8)
+    , m_names(32)
+{}
+
+FastHealthJsonDecoder::Result
+FastHealthJsonDecoder::decode(const char* data, int size, QVector<HealthUpdate>& out)
+{
+    Scanner s(data, data + size);
+    if (!s.consume('{')) return Malformed;
+
+    QString componentId, color, subsystem;
+    qreal   componentSize = 0.0;
+    bool    hasSubsystem = false, hasTelemetry = false;
+    QVector<QPair<QString, qreal>> subsystemHealth;
+    TrmRecordList trms;
+    const char* telemetryBegin = nullptr;
+    const char* telemetryEnd   = nullptr;
+
+    auto internString = [&s](InternCache& cache, QString& target) {
+        Span v;
+        if (s.stringValue(v)) target = cache.get(v.p, v.len, v.escaped);
+    };
+
+    auto parseSubsystemHealth = [&]() {
+        subsystemHealth.clear();
+        if (s.peek() != '{') { s.skipValue(); return; }
+        ++s.p;
+        if (s.consume('}')) return;
+        do {
+            Span k;
+            if (!s.string(k) || !s.expect(':')) return;
+            qreal v = s.numberValue(0.0);
+            subsystemHealth.append(qMakePair(m_names.get(k.p, k.len, k.escaped), v));
+        } while (s.ok && s.consume(','));
+        s.expect('}');
+    };
+
+    auto parseTrm = [&](TrmRecord& d) {
+        d.id = -1;
+        if (s.peek() != '{') { s.skipValue(); return; }
+        ++s.p;
+        if (s.consume('}')) return;
+        do {
+            Span k;
+            if (!s.string(k) || !s.expect(':')) return;
+            if      (keyIs(k, "id"))       d.id       = s.intValue(-1);
+            else if (keyIs(k, "health"))   d.health   = s.numberValue(100.0);
+            else if (keyIs(k, "color"))    internString(m_colors, d.color);
+            else if (keyIs(k, "status"))   internString(m_status, d.status);
+            else if (keyIs(k, "voltage"))  d.voltage  = s.numberValue(0.0);
+            else if (keyIs(k, "current"))  d.current  = s.numberValue(0.0);
+            else if (keyIs(k, "on"))       d.on       = s.boolValue(true);
+            else if (keyIs(k, "trip"))     internString(m_flags, d.trip);
+            else if (keyIs(k, "bit"))      internString(m_flags, d.bit);
+            else if (keyIs(k, "quadrant")) d.quadrant = s.intValue(-1);
+            else if (keyIs(k, "channel"))  d.channel  = s.intValue(-1);
+            else                           s.skipValue();
+        } while (s.ok && s.consume(','));
+        s.expect('}');
+    };
+
+    auto parseTrmArray = [&]() {
+        trms.clear();
+        if (s.peek() != '[') { s.skipValue(); return; }
+        ++s.p;
+        if (s.consume(']')) return;
+        trms.reserve(m_lastTrmCount);
+        do {
+            trms.append(TrmRecord());
+            parseTrm(trms.last());
+        } while (s.ok && s.consume(','));
+        s.expect(']');
+    };
+
+    if (!s.consume('}')) {
+        do {
+            Span key;
+            if (!s.string(key) || !s.expect(':')) return Malformed;
+
+            if (keyIs(key, "component_id")) {
+                Span v;
+                componentId = s.stringValue(v) ? m_names.get(v.p, v.len, v.escaped) : QString();
+            } else if (keyIs(key, "color")) {
+                Span v;
+                color = s.stringValue(v) ? m_colors.get(v.p, v.len, v.escaped) : QString();
+            } else if (keyIs(key, "size")) {
+                componentSize = s.numberValue(0.0);
+            } else if (keyIs(key, "subsystem")) {
+                Span v;
+                hasSubsystem = true;
+                subsystem = s.stringValue(v) ? m_names.get(v.p, v.len, v.escaped) : QString();
+            } else if (keyIs(key, "subsystem_health")) {
+                parseSubsystemHealth();
+            } else if (keyIs(key, "trm_data")) {
+                parseTrmArray();
+            } else if (keyIs(key, "apcu_telemetry")) {
+                hasTelemetry = true;
+                s.ws();
+                telemetryBegin = s.p;
+                s.skipValue();
+                telemetryEnd = s.p;
+            } else {
+                s.skipValue();
+            }
+            if (!s.ok) return Malformed;
+        } while (s.consume(','));
+        if (!s.expect('}')) return Malformed;
+    }
+    s.ws();
+    if (s.p != s.end) return Malformed;
+
+    // ── Emit in the same order as HealthMessageParser::parseJson ─────
+    if (componentId.isEmpty()) {
+        qDebug() << "[MessageServer] Missing component_id in message";
+        return Rejected;
+    }
+
+    if (hasSubsystem) {
+        if (!subsystem.isEmpty() && !color.isEmpty()) {
+            HealthUpdate u;
+            u.kind = HealthUpdate::Subsystem;
+            u.componentId = componentId;
+            u.subsystem = subsystem;
+            u.color = color;
+            u.value = componentSize;
+            out.append(u);
+        }
+        return Decoded;
+    }
+
+    if (!color.isEmpty() && componentSize >= 0) {
+        HealthUpdate u;
+        u.kind = HealthUpdate::Component;
+        u.componentId = componentId;
+        u.color = color;
+        u.value = componentSize;
+        out.append(u);
+    }
+
+    for (const QPair<QString, qreal>& entry : subsystemHealth) {
+        HealthUpdate u;
+        u.kind = HealthUpdate::Subsystem;
+        u.componentId = componentId;
+        u.subsystem = entry.first;
+        u.value = entry.second;
+        u.color = HealthMessageParser::colorForHealth(u.value);
+        out.append(u);
+    }
+
+    if (!trms.isEmpty()) {
+        m_lastTrmCount = trms.size();
+        HealthUpdate u;
+        u.kind = HealthUpdate::Trm;
+        u.componentId = componentId;
+        u.trms = trms;
+        out.append(u);
+    }
+
+    if (hasTelemetry) {
+        HealthUpdate u;
+        u.kind = HealthUpdate::Telemetry;
+        u.componentId = componentId;
+        u.telemetry = QJsonDocument::fromJson(
+            QByteArray::fromRawData(telemetryBegin, int(telemetryEnd - telemetryBegin))).object();
+        out.append(u);
+    }
+
+    return Decoded;
+}
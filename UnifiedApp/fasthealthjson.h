@@ -0,0 +1,61 @@
+#ifndef FASTHEALTHJSON_H
+#define FASTHEALTHJSON_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "healthupdate.h"
+
+/**
+ * FastHealthJsonDecoder – Single-pass JSON decoder for health messages.
+ *
+ * Scans the frame once and writes component_id, color, size, subsystem,
+ * subsystem_health and trm_data straight into HealthUpdate / TrmRecord
+ * fields without building a QJsonDocument. Unknown keys are skipped
+ * structurally; string and bracket scanning uses SSE2 (16 bytes per step)
+ * where available. Only the apcu_telemetry sub-object, which is passed on
+ * as a QJsonObject, is handed to QJsonDocument.
+ *
+ * Produces the same updates as HealthMessageParser::parseJson(), except that
+ * subsystem_health entries come out in document order rather than sorted.
+ *
+ * Repeated TRM strings (color, status, trip, bit) are interned in small
+ * per-decoder caches so steady-state decoding does not allocate them; an
+ * instance must therefore be confined to one thread.
+ */
+class FastHealthJsonDecoder
+{
+public:
+    enum Result {
+        Decoded,        // updates appended to out
+        Rejected,       // well-formed JSON but not a usable health message
+        Malformed       // not a JSON object (or not one this decoder understands)
+    };
+
+    FastHealthJsonDecoder();
+
+    Result decode(const char* data, int size, QVector<HealthUpdate>& out);
+    Result decode(const QByteArray& data, QVector<HealthUpdate>& out)
+    {
+        return decode(data.constData(), data.size(), out);
+    }
+
+private:
+    struct InternSlot { QByteArray raw; QString value; };
+    class InternCache {
+    public:
+        explicit InternCache(int capacity) : m_slots(capacity) {}
+        QString get(const char* p, int len, bool escaped);
+    private:
+        QVector<InternSlot> m_slots;
+        int m_next = 0;
+    };
+
+    InternCache m_colors;
+    InternCache m_status;
+    InternCache m_flags;      // trip / bit values ("Normal", "Tripped", ...)
+    InternCache m_names;      // component ids and subsystem names
+    int m_lastTrmCount = 0;   // reserve hint for the next trm_data array
+};
+
+#endif // FASTHEALTHJSON_H
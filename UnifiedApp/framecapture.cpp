@@ -0,0 +1,290 @@
+#include "framecapture.h"
+#include <QTimer>
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+void putU16(uchar* p, quint16 v) { p[0] = uchar(v); p[1] = uchar(v >> 8); }
+void putU32(uchar* p, quint32 v) { for (int i = 0; i < 4; ++i) p[i] = uchar(v >> (8 * i)); }
+void putI64(uchar* p, qint64 v)
+{
+    quint64 u = static_cast<quint64>(v);
+    for (int i = 0; i < 8; ++i) p[i] = uchar(u >> (8 * i));
+}
+
+quint16 getU16(const uchar* p) { return quint16(p[0] | (p[1] << 8)); }
+quint32 getU32(const uchar* p)
+{
+    return quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24);
+}
+qint64 getI64(const uchar* p)
+{
+    quint64 u = 0;
+    for (int i = 7; i >= 0; --i) u = (u << 8) | p[i];
+    return static_cast<qint64>(u);
+}
+
+int padded(int size) { return (size + 7) & ~7; }
+
+} // namespace
+
+// ────────────────────────────────────────────────────────────────────────────
+//  FrameCaptureWriter
+// ────────────────────────────────────────────────────────────────────────────
+
+bool FrameCaptureWriter::open(const QString& path)
+{
+    close();
+    QMutexLocker lock(&m_mutex);
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[Capture] Cannot create" << path << "-" << m_file.errorString();
+        return false;
+    }
+
+    uchar header[FrameCapture::HeaderSize] = {};
+    std::memcpy(header, FrameCapture::Magic, sizeof(FrameCapture::Magic));
+    putU16(header + 8, FrameCapture::Version);
+    putU16(header + 10, FrameCapture::HeaderSize);
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    m_sources.clear();
+    m_frames.store(0, std::memory_order_relaxed);
+    m_clock.start();
+    m_open.store(true, std::memory_order_release);
+    qDebug() << "[Capture] Recording to" << path;
+    return true;
+}
+
+void FrameCaptureWriter::close()
+{
+    if (!m_open.exchange(false)) return;
+    QMutexLocker lock(&m_mutex);
+    m_file.close();
+    qDebug() << "[Capture] Closed" << m_file.fileName() << "-"
+             << framesWritten() << "frames";
+}
+
+void FrameCaptureWriter::write(const QString& source, const char* data, int size)
+{
+    if (!isOpen() || size <= 0) return;
+    const qint64 t = m_clock.nsecsElapsed();
+
+    QMutexLocker lock(&m_mutex);
+    if (!m_file.isOpen()) return;
+
+    auto it = m_sources.constFind(source);
+    quint16 id;
+    if (it != m_sources.constEnd()) {
+        id = it.value();
+    } else {
+        id = static_cast<quint16>(m_sources.size());
+        m_sources.insert(source, id);
+        const QByteArray tag = source.toUtf8();
+        appendRecord(FrameCapture::SourceDef, id, t, tag.constData(), tag.size());
+    }
+    appendRecord(FrameCapture::Frame, id, t, data, size);
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameCaptureWriter::appendRecord(quint16 kind, quint16 source, qint64 timeNs,
+                                      const char* data, int size)
+{
+    static const char zeros[8] = {};
+    uchar header[FrameCapture::RecordHeaderSize];
+    putI64(header, timeNs);
+    putU32(header + 8, static_cast<quint32>(size));
+    putU16(header + 12, source);
+    putU16(header + 14, kind);
+
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    m_file.write(data, size);
+    if (padded(size) > size)
+        m_file.write(zeros, padded(size) - size);
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  FrameCaptureReader
+// ────────────────────────────────────────────────────────────────────────────
+
+bool FrameCaptureReader::open(const QString& path)
+{
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+    const qint64 fileSize = m_file.size();
+    if (fileSize < FrameCapture::HeaderSize) {
+        m_error = QStringLiteral("file too short");
+        m_file.close();
+        return false;
+    }
+    m_base = m_file.map(0, fileSize);
+    if (!m_base) {
+        m_error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    if (std::memcmp(m_base, FrameCapture::Magic, sizeof(FrameCapture::Magic)) != 0
+            || getU16(m_base + 8) != FrameCapture::Version) {
+        m_error = QStringLiteral("not a version %1 capture file").arg(FrameCapture::Version);
+        close();
+        return false;
+    }
+
+    // Index every complete record; a truncated tail is ignored
+    qint64 off = getU16(m_base + 10);
+    while (off + FrameCapture::RecordHeaderSize <= fileSize) {
+        const uchar* h = m_base + off;
+        const int size = static_cast<int>(getU32(h + 8));
+        const qint64 end = off + FrameCapture::RecordHeaderSize + size;
+        if (size < 0 || end > fileSize) break;
+
+        const char* payload = reinterpret_cast<const char*>(h + FrameCapture::RecordHeaderSize);
+        const quint16 source = getU16(h + 12);
+        if (getU16(h + 14) == FrameCapture::SourceDef) {
+            while (m_sourceNames.size() <= source) m_sourceNames.append(QString());
+            m_sourceNames[source] = QString::fromUtf8(payload, size);
+        } else {
+            Frame f;
+            f.timeNs = getI64(h);
+            f.source = source;
+            f.data = payload;
+            f.size = size;
+            m_frames.append(f);
+        }
+        off += FrameCapture::RecordHeaderSize + padded(size);
+    }
+    return true;
+}
+
+void FrameCaptureReader::close()
+{
+    if (m_base) m_file.unmap(const_cast<uchar*>(m_base));
+    m_base = nullptr;
+    m_file.close();
+    m_frames.clear();
+    m_sourceNames.clear();
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Replay
+// ────────────────────────────────────────────────────────────────────────────
+
+QString ReplayReport::summary() const
+{
+    return QString("%1 frames (%2 KB) in %3 s at %4 – %5 frames/s, %6 MB/s, "
+                   "%7 late (max lag %8 ms), %9 rejected, %10 updates dropped%11")
+        .arg(framesSent)
+        .arg(bytesSent / 1024)
+        .arg(elapsedNs / 1e9, 0, 'f', 2)
+        .arg(speed > 0 ? QString("%1x").arg(speed) : QString("max speed"))
+        .arg(framesPerSec(), 0, 'f', 0)
+        .arg(mbPerSec(), 0, 'f', 2)
+        .arg(lateFrames)
+        .arg(maxLagNs / 1e6, 0, 'f', 2)
+        .arg(droppedFrames)
+        .arg(droppedUpdates)
+        .arg(completed ? QString() : QString(" (stopped)"));
+}
+
+FrameReplayer::FrameReplayer(QObject* parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &FrameReplayer::pump);
+}
+
+bool FrameReplayer::open(const QString& path)
+{
+    stop();
+    if (!m_reader.open(path)) {
+        qWarning() << "[Replay] Cannot open" << path << "-" << m_reader.errorString();
+        return false;
+    }
+    setSourceFilter(QStringList());
+    qDebug() << "[Replay] Loaded" << path << "-" << m_reader.frameCount() << "frames,"
+             << m_reader.durationNs() / 1e9 << "s, sources" << m_reader.sources();
+    return true;
+}
+
+void FrameReplayer::setSourceFilter(const QStringList& tags)
+{
+    const QStringList names = m_reader.sources();
+    m_sourceEnabled.fill(true, names.size());
+    if (tags.isEmpty()) return;
+    for (int i = 0; i < names.size(); ++i)
+        m_sourceEnabled[i] = tags.contains(names[i]);
+}
+
+void FrameReplayer::start()
+{
+    if (!m_reader.isOpen() || m_running) return;
+    m_report = ReplayReport();
+    m_report.speed = m_speed;
+    m_next = 0;
+    m_running = true;
+    m_clock.start();
+    m_timer->start(0);
+}
+
+void FrameReplayer::stop()
+{
+    if (m_running) finish(false);
+}
+
+void FrameReplayer::pump()
+{
+    if (!m_running) return;
+
+    const int count = m_reader.frameCount();
+    const qint64 origin = count > 0 ? m_reader.frame(0).timeNs : 0;
+    int sliceLeft = kFastSlice;
+
+    while (m_next < count) {
+        const FrameCaptureReader::Frame& f = m_reader.frame(m_next);
+
+        if (m_speed > 0.0) {
+            const qint64 due = static_cast<qint64>((f.timeNs - origin) / m_speed);
+            const qint64 now = m_clock.nsecsElapsed();
+            if (due > now) {
+                // Sleep until the next frame is due (ms timer resolution)
+                m_timer->start(static_cast<int>((due - now) / 1000000));
+                return;
+            }
+            const qint64 lag = now - due;
+            if (lag > kLateThresholdNs) ++m_report.lateFrames;
+            m_report.maxLagNs = qMax(m_report.maxLagNs, lag);
+        } else if (sliceLeft-- == 0) {
+            m_timer->start(0);
+            return;
+        }
+
+        ++m_next;
+        if (f.source >= 0 && f.source < m_sourceEnabled.size() && !m_sourceEnabled[f.source])
+            continue;
+        if (m_consumer)
+            m_consumer(f.source, QByteArray::fromRawData(f.data, f.size));
+        ++m_report.framesSent;
+        m_report.bytesSent += f.size;
+        if (!m_running) return;   // consumer stopped us
+    }
+    finish(true);
+}
+
+void FrameReplayer::finish(bool completed)
+{
+    m_timer->stop();
+    m_running = false;
+    m_report.elapsedNs = m_clock.nsecsElapsed();
+    m_report.completed = completed;
+    qDebug() << "[Replay]" << m_report.summary();
+    emit finished(m_report);
+}
@@ -0,0 +1,203 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <QObject>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+class QTimer;
+
+/**
+ * Frame capture file (version 1) – append-only journal of raw ingest frames.
+ *
+ *   File header (16 bytes, little-endian)
+ *     char[8] magic    "VAJRACAP"
+ *     u16     version  1
+ *     u16     header size (16)
+ *     u32     reserved
+ *
+ *   Records, each starting on an 8-byte boundary
+ *     i64  time_ns   monotonic time since the capture was opened
+ *     u32  length    payload bytes
+ *     u16  source    source index
+ *     u16  kind      0 = frame, 1 = source definition
+ *     u8[length] payload, zero-padded to a multiple of 8
+ *
+ * A source definition record (payload = UTF-8 tag such as "tcp:global" or
+ * "antenna:5005") is written the first time a tag is used and assigns it
+ * the next source index. Records are never rewritten, so a capture that was
+ * cut short (crash, power loss) is still readable up to its last complete
+ * record. The 8-byte alignment lets the reader walk a memory-mapped file
+ * without copying.
+ */
+namespace FrameCapture {
+    static const char    Magic[8]   = { 'V', 'A', 'J', 'R', 'A', 'C', 'A', 'P' };
+    static const quint16 Version    = 1;
+    static const int     HeaderSize = 16;
+    static const int     RecordHeaderSize = 16;
+
+    enum RecordKind : quint16 {
+        Frame = 0,
+        SourceDef = 1
+    };
+}
+
+/**
+ * FrameCaptureWriter – Appends frames to a capture file.
+ *
+ * write() may be called from any thread (protocol handlers on ingest
+ * workers record concurrently); a mutex serialises the appends. When no
+ * capture is open, write() costs one relaxed atomic load.
+ */
+class FrameCaptureWriter
+{
+public:
+    FrameCaptureWriter() = default;
+    ~FrameCaptureWriter() { close(); }
+
+    /** Create (truncate) @p path and start a new capture. */
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_open.load(std::memory_order_relaxed); }
+    QString fileName() const { return m_file.fileName(); }
+
+    void write(const QString& source, const char* data, int size);
+    void write(const QString& source, const QByteArray& data)
+    {
+        write(source, data.constData(), data.size());
+    }
+
+    quint64 framesWritten() const { return m_frames.load(std::memory_order_relaxed); }
+
+private:
+    void appendRecord(quint16 kind, quint16 source, qint64 timeNs,
+                      const char* data, int size);   // m_mutex held
+
+    QMutex        m_mutex;
+    QFile         m_file;
+    QElapsedTimer m_clock;
+    QHash<QString, quint16> m_sources;
+    std::atomic<bool>    m_open{false};
+    std::atomic<quint64> m_frames{0};
+};
+
+/**
+ * FrameCaptureReader – Memory-maps a capture file and walks its records.
+ *
+ * Frame payload pointers point into the mapping and stay valid until the
+ * reader is closed or destroyed.
+ */
+class FrameCaptureReader
+{
+public:
+    struct Frame {
+        qint64      timeNs = 0;
+        int         source = -1;
+        const char* data = nullptr;
+        int         size = 0;
+    };
+
+    FrameCaptureReader() = default;
+    ~FrameCaptureReader() { close(); }
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+    QString errorString() const { return m_error; }
+
+    /** Source tags, indexed by Frame::source. */
+    QStringList sources() const { return m_sourceNames; }
+    int frameCount() const { return m_frames.size(); }
+    const Frame& frame(int i) const { return m_frames[i]; }
+    /** Time of the last frame (capture duration). */
+    qint64 durationNs() const { return m_frames.isEmpty() ? 0 : m_frames.last().timeNs; }
+
+private:
+    QFile         m_file;
+    const uchar*  m_base = nullptr;
+    QStringList   m_sourceNames;
+    QVector<Frame> m_frames;          // index built once on open()
+    QString       m_error;
+};
+
+/** Outcome of one replay run. */
+struct ReplayReport {
+    int     framesSent = 0;
+    qint64  bytesSent = 0;
+    qint64  elapsedNs = 0;
+    double  speed = 1.0;            // 0 = as fast as possible
+    int     lateFrames = 0;         // delivered > 1 ms behind schedule
+    qint64  maxLagNs = 0;
+    quint64 droppedFrames = 0;      // rejected by the consumer (parse failures)
+    quint64 droppedUpdates = 0;     // lost downstream (queue overflow)
+    bool    completed = false;      // false if stopped early
+
+    double framesPerSec() const { return elapsedNs > 0 ? framesSent * 1e9 / elapsedNs : 0.0; }
+    double mbPerSec() const { return elapsedNs > 0 ? bytesSent * 1e3 / elapsedNs : 0.0; }
+    QString summary() const;
+};
+Q_DECLARE_METATYPE(ReplayReport)
+
+/**
+ * FrameReplayer – Plays a capture back in capture time.
+ *
+ * speed 1.0 reproduces the original inter-frame timing, N > 1 plays N times
+ * faster, 0 delivers frames as fast as possible (in slices, so the owning
+ * thread's event loop keeps running). Frames are never skipped when the
+ * consumer falls behind; they are delivered late and counted in
+ * ReplayReport::lateFrames instead.
+ *
+ * The consumer callback receives each frame as a QByteArray::fromRawData()
+ * view into the mapped file. The replayer and its timer live on the thread
+ * that calls start().
+ */
+class FrameReplayer : public QObject
+{
+    Q_OBJECT
+public:
+    typedef std::function<void(int source, const QByteArray& frame)> Consumer;
+
+    explicit FrameReplayer(QObject* parent = nullptr);
+
+    bool open(const QString& path);
+    QString errorString() const { return m_reader.errorString(); }
+    const FrameCaptureReader& reader() const { return m_reader; }
+
+    /** Only replay frames whose source tag is listed (empty = all). */
+    void setSourceFilter(const QStringList& tags);
+    void setSpeed(double speed) { m_speed = qMax(0.0, speed); }
+    void setConsumer(const Consumer& consumer) { m_consumer = consumer; }
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+    ReplayReport report() const { return m_report; }
+
+signals:
+    void finished(const ReplayReport& report);
+
+private:
+    void pump();
+    void finish(bool completed);
+
+    static const int kFastSlice = 512;        // frames per event-loop turn (speed 0)
+    static const qint64 kLateThresholdNs = 1000000;
+
+    FrameCaptureReader m_reader;
+    QVector<bool>  m_sourceEnabled;
+    Consumer       m_consumer;
+    QTimer*        m_timer;
+    QElapsedTimer  m_clock;
+    double         m_speed = 1.0;
+    int            m_next = 0;
+    bool           m_running = false;
+    ReplayReport   m_report;
+};
+
+#endif // FRAMECAPTURE_H
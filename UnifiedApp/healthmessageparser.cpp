@@ -0,0 +1,111 @@
+#include "healthmessageparser.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+QString HealthMessageParser::colorForHealth(qreal health)
+{
+    if (health >= 90) return QStringLiteral("#00FF00");
+    if (health >= 70) return QStringLiteral("#FFFF00");
+    if (health >= 40) return QStringLiteral("#FFA500");
+    if (health >= 10) return QStringLiteral("#FF0000");
+    return QStringLiteral("#808080");
+}
+
+bool HealthMessageParser::parse(const QByteArray& data, QVector<HealthUpdate>& out)
+{
+    if (BinaryHealthFrame::isBinary(data))
+        return m_binary.decode(data, out);
+
+    switch (m_json.decode(data, out)) {
+    case FastHealthJsonDecoder::Decoded:  return true;
+    case FastHealthJsonDecoder::Rejected: return false;
+    case FastHealthJsonDecoder::Malformed: break;
+    }
+    return parseJson(data, out);
+}
+
+bool HealthMessageParser::parseJson(const QByteArray& data, QVector<HealthUpdate>& out)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject()) {
+        qDebug() << "[MessageServer] Invalid JSON received";
+        return false;
+    }
+
+    QJsonObject obj = doc.object();
+    QString componentId = obj["component_id"].toString();
+    QString color = obj["color"].toString();
+    qreal size = obj["size"].toDouble();
+
+    if (componentId.isEmpty()) {
+        qDebug() << "[MessageServer] Missing component_id in message";
+        return false;
+    }
+
+    // ── Single subsystem update ──────────────────────────────────────
+    if (obj.contains("subsystem")) {
+        QString subsystem = obj["subsystem"].toString();
+        if (!subsystem.isEmpty() && !color.isEmpty()) {
+            HealthUpdate u;
+            u.kind = HealthUpdate::Subsystem;
+            u.componentId = componentId;
+            u.subsystem = subsystem;
+            u.color = color;
+            u.value = size;
+            out.append(u);
+        }
+        return true;
+    }
+
+    // ── Component-level health update ────────────────────────────────
+    if (!color.isEmpty() && size >= 0) {
+        HealthUpdate u;
+        u.kind = HealthUpdate::Component;
+        u.componentId = componentId;
+        u.color = color;
+        u.value = size;
+        out.append(u);
+    }
+
+    // ── Bulk subsystem health map ────────────────────────────────────
+    if (obj.contains("subsystem_health")) {
+        QJsonObject subHealth = obj["subsystem_health"].toObject();
+        for (auto it = subHealth.begin(); it != subHealth.end(); ++it) {
+            HealthUpdate u;
+            u.kind = HealthUpdate::Subsystem;
+            u.componentId = componentId;
+            u.subsystem = it.key();
+            u.value = it.value().toDouble();
+            u.color = colorForHealth(u.value);
+            out.append(u);
+        }
+    }
+
+    // ── TRM grid data ────────────────────────────────────────────────
+    if (obj.contains("trm_data")) {
+        QJsonArray trmArray = obj["trm_data"].toArray();
+        if (!trmArray.isEmpty()) {
+            HealthUpdate u;
+            u.kind = HealthUpdate::Trm;
+            u.componentId = componentId;
+            u.trms.reserve(trmArray.size());
+            for (const QJsonValue& v : trmArray)
+                u.trms.append(TrmRecord::fromJson(v.toObject()));
+            out.append(u);
+        }
+    }
+
+    // ── Full APCU telemetry ──────────────────────────────────────────
+    if (obj.contains("apcu_telemetry")) {
+        qDebug() << "[MessageServer] APCU telemetry received for" << componentId;
+        HealthUpdate u;
+        u.kind = HealthUpdate::Telemetry;
+        u.componentId = componentId;
+        u.telemetry = obj["apcu_telemetry"].toObject();
+        out.append(u);
+    }
+
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef HEALTHMESSAGEPARSER_H
+#define HEALTHMESSAGEPARSER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "healthupdate.h"
+#include "binaryhealthframe.h"
+#include "fasthealthjson.h"
+
+/**
+ * HealthMessageParser – Decoder for health frames.
+ *
+ * Converts one raw frame (as emitted by ProtocolHandler::dataReceived) into
+ * a list of typed HealthUpdate records, in the same order MessageServer has
+ * always emitted its signals. The wire format is auto-detected: frames
+ * starting with BinaryHealthFrame::Magic go to the binary decoder, anything
+ * else is treated as JSON.
+ *
+ * JSON goes through FastHealthJsonDecoder first; frames it cannot handle
+ * fall back to the QJsonDocument path (parseJson), which also produces the
+ * diagnostics for invalid input.
+ *
+ * A parser instance carries the binary subsystem dictionaries and the JSON
+ * string caches and must be confined to one thread; use one instance per
+ * ingest thread.
+ */
+class HealthMessageParser
+{
+public:
+    /**
+     * Decode @p data and append the resulting updates to @p out.
+     * Returns false (and appends nothing) if the frame is malformed or has
+     * no component_id.
+     */
+    bool parse(const QByteArray& data, QVector<HealthUpdate>& out);
+
+    /** Reference JSON path via QJsonDocument; stateless. */
+    static bool parseJson(const QByteArray& data, QVector<HealthUpdate>& out);
+
+    /** Map a 0-100 health value to the standard status colour. */
+    static QString colorForHealth(qreal health);
+
+private:
+    BinaryHealthDecoder   m_binary;
+    FastHealthJsonDecoder m_json;
+};
+
+#endif // HEALTHMESSAGEPARSER_H
@@ -0,0 +1,114 @@
+#include "healthstatecache.h"
+
+HealthStateCache::HealthStateCache(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &HealthStateCache::flush);
+    setRefreshRate(m_refreshHz);
+}
+
+void HealthStateCache::setRefreshRate(int hz)
+{
+    m_refreshHz = qMax(0, hz);
+    if (m_refreshHz > 0)
+        m_timer.setInterval(qMax(1, 1000 / m_refreshHz));
+    else
+        flush();
+}
+
+void HealthStateCache::clear()
+{
+    m_timer.stop();
+    m_components.clear();
+    m_subsystems.clear();
+    m_trm.clear();
+    m_pendingComponents.clear();
+    m_pendingSubsystems.clear();
+    m_pendingTrm.clear();
+    m_received = m_delivered = 0;
+}
+
+void HealthStateCache::markPending(bool& pending, QStringList& queue, const QString& key)
+{
+    ++m_received;
+    // A value still pending was never shown; this one supersedes it (conflated)
+    if (!pending) {
+        pending = true;
+        queue.append(key);
+    }
+
+    if (m_refreshHz == 0)
+        flush();
+    else if (!m_timer.isActive())
+        m_timer.start();
+}
+
+int HealthStateCache::pendingCount() const
+{
+    return m_pendingComponents.size() + m_pendingSubsystems.size() + m_pendingTrm.size();
+}
+
+void HealthStateCache::updateComponent(const QString& componentId, const QString& color, qreal size)
+{
+    ComponentState& s = m_components[componentId];
+    s.color = color;
+    s.size  = size;
+    markPending(s.pending, m_pendingComponents, componentId);
+}
+
+void HealthStateCache::updateSubsystem(const QString& componentId, const QString& subsystemName,
+                                       const QString& color, qreal health)
+{
+    const QString key = componentId + QLatin1Char('/') + subsystemName;
+    SubsystemState& s = m_subsystems[key];
+    if (s.componentId.isEmpty()) {
+        s.componentId = componentId;
+        s.subsystem   = subsystemName;
+    }
+    s.color  = color;
+    s.health = health;
+    markPending(s.pending, m_pendingSubsystems, key);
+}
+
+void HealthStateCache::updateTrmData(const QString& componentId, const TrmRecordList& trms)
+{
+    TrmState& s = m_trm[componentId];
+    s.trms = trms;
+    markPending(s.pending, m_pendingTrm, componentId);
+}
+
+void HealthStateCache::flush()
+{
+    m_timer.stop();
+    if (pendingCount() == 0) return;
+
+    // Swap the queues out and copy each state before emitting: slots may
+    // feed new updates back in
+    QStringList components, subsystems, trm;
+    components.swap(m_pendingComponents);
+    subsystems.swap(m_pendingSubsystems);
+    trm.swap(m_pendingTrm);
+
+    for (const QString& id : components) {
+        m_components[id].pending = false;
+        const ComponentState s = m_components.value(id);
+        ++m_delivered;
+        emit componentHealthChanged(id, s.color, s.size);
+    }
+    for (const QString& key : subsystems) {
+        m_subsystems[key].pending = false;
+        const SubsystemState s = m_subsystems.value(key);
+        ++m_delivered;
+        emit subsystemHealthChanged(s.componentId, s.subsystem, s.color, s.health);
+    }
+    for (const QString& id : trm) {
+        m_trm[id].pending = false;
+        const TrmState s = m_trm.value(id);
+        ++m_delivered;
+        emit trmDataChanged(id, s.trms);
+    }
+
+    emit flushed();
+}
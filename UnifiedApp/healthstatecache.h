@@ -0,0 +1,84 @@
+#ifndef HEALTHSTATECACHE_H
+#define HEALTHSTATECACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include "trmrecord.h"
+#include <QTimer>
+
+/**
+ * HealthStateCache – Latest-value conflation between MessageServer and the UI.
+ *
+ * Every health update is stored against its key (component, component +
+ * subsystem, or component TRM grid). Only the newest pending value per key
+ * is delivered, at most once per refresh period, through the *Changed
+ * signals; older pending values for the same key are counted as conflated
+ * and dropped. Callers that need every update (e.g. statistics) should
+ * record them before handing them to the cache.
+ *
+ * A refresh rate of 0 disables conflation: updates are delivered immediately.
+ * The flush timer only runs while something is pending.
+ */
+class HealthStateCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit HealthStateCache(QObject* parent = nullptr);
+
+    /** UI refresh rate in Hz (default 30); 0 = deliver every update at once. */
+    void setRefreshRate(int hz);
+    int  refreshRate() const { return m_refreshHz; }
+
+    quint64 receivedUpdates()  const { return m_received; }
+    quint64 deliveredUpdates() const { return m_delivered; }
+    quint64 conflatedUpdates() const { return m_received - m_delivered - pendingCount(); }
+
+    /** Forget all cached state (e.g. when the design is cleared). */
+    void clear();
+
+public slots:
+    void updateComponent(const QString& componentId, const QString& color, qreal size);
+    void updateSubsystem(const QString& componentId, const QString& subsystemName,
+                         const QString& color, qreal health);
+    void updateTrmData(const QString& componentId, const TrmRecordList& trms);
+
+    /** Deliver all pending state now. */
+    void flush();
+
+signals:
+    void componentHealthChanged(const QString& componentId, const QString& color, qreal size);
+    void subsystemHealthChanged(const QString& componentId, const QString& subsystemName,
+                                const QString& color, qreal health);
+    void trmDataChanged(const QString& componentId, const TrmRecordList& trms);
+
+    /** Emitted after each flush that delivered something. */
+    void flushed();
+
+private:
+    struct ComponentState { QString color; qreal size = 0.0; bool pending = false; };
+    struct SubsystemState { QString componentId; QString subsystem; QString color;
+                            qreal health = 0.0; bool pending = false; };
+    struct TrmState       { TrmRecordList trms; bool pending = false; };
+
+    void markPending(bool& pending, QStringList& queue, const QString& key);
+    int  pendingCount() const;
+
+    QHash<QString, ComponentState> m_components;   // componentId → state
+    QHash<QString, SubsystemState> m_subsystems;   // componentId + '/' + subsystem → state
+    QHash<QString, TrmState>       m_trm;          // componentId → state
+
+    // Keys with a pending value, in first-arrival order
+    QStringList m_pendingComponents;
+    QStringList m_pendingSubsystems;
+    QStringList m_pendingTrm;
+
+    quint64 m_received  = 0;
+    quint64 m_delivered = 0;
+
+    int    m_refreshHz = 30;
+    QTimer m_timer;
+};
+
+#endif // HEALTHSTATECACHE_H
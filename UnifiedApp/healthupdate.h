@@ -0,0 +1,42 @@
+#ifndef HEALTHUPDATE_H
+#define HEALTHUPDATE_H
+
+#include <QString>
+#include <QJsonObject>
+#include "trmrecord.h"
+
+class IngestStats;
+
+/**
+ * HealthUpdate – One decoded, typed health event produced by the ingest
+ * pipeline (HealthMessageParser).
+ *
+ * A single wire frame may decode into several updates (e.g. a component
+ * colour/size update followed by one Subsystem update per entry of the
+ * "subsystem_health" map). MessageServer turns each update back into the
+ * matching public signal, so the rest of the application is unaware of
+ * whether decoding happened on the GUI thread or on an ingest worker.
+ */
+struct HealthUpdate {
+    enum Kind {
+        Component,   // messageReceived(componentId, color, value)
+        Subsystem,   // subsystemHealthReceived(componentId, subsystem, color, value)
+        Telemetry,   // telemetryReceived(componentId, telemetry)
+        Trm          // trmDataReceived(componentId, trms)
+    };
+
+    Kind        kind = Component;
+    QString     componentId;    // empty when addressed by channel
+    int         channel = -1;   // binary channel ID (HasChannel frames), else -1
+    QString     subsystem;      // Subsystem only
+    QString     color;          // Component / Subsystem
+    qreal       value = 0.0;    // size (Component) or health (Subsystem)
+    QJsonObject telemetry;      // Telemetry only
+    TrmRecordList trms;         // Trm only
+
+    // Instrumentation: stamped by the ingest pipeline right after parsing
+    IngestStats* source = nullptr;  // counters of the feed that produced it
+    qint64      receivedNs = 0;     // IngestStats::nowNs() when the frame arrived
+};
+
+#endif // HEALTHUPDATE_H
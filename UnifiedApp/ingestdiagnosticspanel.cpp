@@ -0,0 +1,121 @@
+#include "ingestdiagnosticspanel.h"
+#include "messageserver.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTableWidget>
+#include <QTableWidgetItem>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+
+namespace {
+
+enum Column {
+    ColFeed, ColProtocol, ColFramesPerSec, ColKBPerSec, ColFrames, ColUpdates,
+    ColFailures, ColOversized, ColResync, ColKernelDrops, ColParseP50, ColParseP99, ColLatencyP50,
+    ColLatencyP99, ColLatencyMax, ColumnCount
+};
+
+QString feedName(const IngestStatsSnapshot& s)
+{
+    if (s.source.isEmpty()) return QStringLiteral("(global TCP)");
+    if (s.source == QLatin1String("udp_global")) return QStringLiteral("(global UDP)");
+    return s.source;
+}
+
+QString micros(qint64 ns) { return QString::number(ns / 1000.0, 'f', 1); }
+QString millis(qint64 ns) { return QString::number(ns / 1e6, 'f', 2); }
+
+} // namespace
+
+IngestDiagnosticsPanel::IngestDiagnosticsPanel(MessageServer* server, QWidget* parent)
+    : QWidget(parent)
+    , m_server(server)
+{
+    setObjectName("ingestDiagnosticsPanel");
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->setSpacing(6);
+
+    QHBoxLayout* header = new QHBoxLayout();
+    m_summary = new QLabel(this);
+    m_summary->setObjectName("ingestDiagnosticsSummary");
+    m_resetBtn = new QPushButton("RESET COUNTERS", this);
+    m_resetBtn->setObjectName("ingestDiagnosticsResetBtn");
+    m_resetBtn->setCursor(Qt::PointingHandCursor);
+    header->addWidget(m_summary, 1);
+    header->addWidget(m_resetBtn);
+    layout->addLayout(header);
+
+    m_table = new QTableWidget(0, ColumnCount, this);
+    m_table->setObjectName("ingestDiagnosticsTable");
+    m_table->setHorizontalHeaderLabels({
+        "Feed", "Protocol", "Frames/s", "KB/s", "Frames", "Updates",
+        "Parse fail", "Oversized", "Resync B", "Kernel drops", "Parse p50 (µs)", "Parse p99 (µs)",
+        "Dispatch p50 (ms)", "Dispatch p99 (ms)", "Dispatch max (ms)"});
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(m_table, 1);
+
+    connect(m_server, &MessageServer::ingestStatsUpdated, this, [this]() {
+        if (isVisible()) refresh();
+    });
+    connect(m_resetBtn, &QPushButton::clicked, this, [this]() {
+        m_server->resetIngestStats();
+        refresh();
+    });
+}
+
+void IngestDiagnosticsPanel::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    refresh();
+}
+
+void IngestDiagnosticsPanel::refresh()
+{
+    const QList<IngestStatsSnapshot> feeds = m_server->ingestStats();
+    m_table->setRowCount(feeds.size());
+
+    int row = 0;
+    for (const IngestStatsSnapshot& s : feeds) {
+        const QStringList cells = {
+            feedName(s),
+            s.active ? s.protocol : s.protocol + " (removed)",
+            QString::number(s.framesPerSec, 'f', 1),
+            QString::number(s.bytesPerSec / 1024.0, 'f', 1),
+            QString::number(s.frames),
+            QString::number(s.updates),
+            QString::number(s.parseFailures),
+            QString::number(s.oversizedFrames),
+            QString::number(s.resyncBytes),
+            QString::number(s.kernelDrops),
+            micros(s.parseP50Ns),
+            micros(s.parseP99Ns),
+            millis(s.latencyP50Ns),
+            millis(s.latencyP99Ns),
+            millis(s.latencyMaxNs)
+        };
+        for (int c = 0; c < ColumnCount; ++c) {
+            QTableWidgetItem* item = m_table->item(row, c);
+            if (!item) {
+                item = new QTableWidgetItem;
+                if (c >= ColFramesPerSec)
+                    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                m_table->setItem(row, c, item);
+            }
+            item->setText(cells[c]);
+        }
+        ++row;
+    }
+
+    m_summary->setText(QString("Feeds: %1  |  Ingest threads: %2  |  Queue drops: %3  |  Unrouted: %4")
+        .arg(feeds.size())
+        .arg(m_server->ingestThreadCount())
+        .arg(m_server->droppedUpdates())
+        .arg(m_server->unroutedUpdates()));
+}
@@ -0,0 +1,39 @@
+#ifndef INGESTDIAGNOSTICSPANEL_H
+#define INGESTDIAGNOSTICSPANEL_H
+
+#include <QWidget>
+
+class MessageServer;
+class QTableWidget;
+class QLabel;
+class QPushButton;
+
+/**
+ * IngestDiagnosticsPanel - Live table of MessageServer ingest counters.
+ *
+ * One row per feed (handler key): frame/byte rates, totals, parse failures,
+ * oversized frames, bytes skipped to resynchronise, kernel drops, parse-time
+ * and receive→dispatch latency percentiles (see MessageServer). The table is
+ * rebuilt on every MessageServer::ingestStatsUpdated() while the panel is
+ * visible, so a hidden panel costs nothing.
+ */
+class IngestDiagnosticsPanel : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit IngestDiagnosticsPanel(MessageServer* server, QWidget* parent = nullptr);
+
+public slots:
+    void refresh();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
+private:
+    MessageServer* m_server;
+    QTableWidget*  m_table;
+    QLabel*        m_summary;
+    QPushButton*   m_resetBtn;
+};
+
+#endif // INGESTDIAGNOSTICSPANEL_H
@@ -0,0 +1,152 @@
+#include "ingeststats.h"
+#include <QtAlgorithms>
+#include <chrono>
+
+// ────────────────────────────────────────────────────────────────────────────
+//  LatencyHistogram
+// ────────────────────────────────────────────────────────────────────────────
+
+static int bucketFor(qint64 ns)
+{
+    if (ns <= 1) return 0;
+    int b = 63 - static_cast<int>(qCountLeadingZeroBits(static_cast<quint64>(ns)));
+    return b < LatencyHistogram::kBuckets ? b : LatencyHistogram::kBuckets - 1;
+}
+
+void LatencyHistogram::record(qint64 ns)
+{
+    if (ns < 0) ns = 0;
+    m_buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(static_cast<quint64>(ns), std::memory_order_relaxed);
+
+    qint64 seen = m_max.load(std::memory_order_relaxed);
+    while (ns > seen && !m_max.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::reset()
+{
+    for (int i = 0; i < kBuckets; ++i)
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::meanNs() const
+{
+    quint64 n = count();
+    return n ? static_cast<qint64>(m_sum.load(std::memory_order_relaxed) / n) : 0;
+}
+
+qint64 LatencyHistogram::percentileNs(double p) const
+{
+    quint64 counts[kBuckets];
+    quint64 total = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) return 0;
+
+    quint64 rank = static_cast<quint64>(p * static_cast<double>(total) + 0.5);
+    if (rank < 1) rank = 1;
+    quint64 seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank)
+            return qMin(maxNs(), (qint64(1) << (i + 1)) - 1);
+    }
+    return maxNs();
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  IngestStats
+// ────────────────────────────────────────────────────────────────────────────
+
+qint64 IngestStats::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void IngestStats::reset()
+{
+    m_frames.store(0, std::memory_order_relaxed);
+    m_bytes.store(0, std::memory_order_relaxed);
+    m_updates.store(0, std::memory_order_relaxed);
+    m_parseFailures.store(0, std::memory_order_relaxed);
+    m_oversized.store(0, std::memory_order_relaxed);
+    m_resyncBytes.store(0, std::memory_order_relaxed);
+    m_kernelDrops.store(0, std::memory_order_relaxed);
+    m_parseTime.reset();
+    m_latency.reset();
+}
+
+IngestStatsSnapshot IngestStats::snapshot(const IngestStatsSnapshot& previous,
+                                          qint64 elapsedNs) const
+{
+    IngestStatsSnapshot s;
+    s.frames          = frames();
+    s.bytes           = bytes();
+    s.updates         = m_updates.load(std::memory_order_relaxed);
+    s.parseFailures   = parseFailures();
+    s.oversizedFrames = m_oversized.load(std::memory_order_relaxed);
+    s.resyncBytes     = m_resyncBytes.load(std::memory_order_relaxed);
+    s.kernelDrops     = m_kernelDrops.load(std::memory_order_relaxed);
+
+    // Counters only go backwards after reset(); report a zero rate then
+    if (elapsedNs > 0 && s.frames >= previous.frames && s.bytes >= previous.bytes) {
+        const double secs = elapsedNs / 1e9;
+        s.framesPerSec = (s.frames - previous.frames) / secs;
+        s.bytesPerSec  = (s.bytes - previous.bytes) / secs;
+    }
+
+    s.parseCount   = m_parseTime.count();
+    s.parseMeanNs  = m_parseTime.meanNs();
+    s.parseP50Ns   = m_parseTime.percentileNs(0.50);
+    s.parseP99Ns   = m_parseTime.percentileNs(0.99);
+    s.parseMaxNs   = m_parseTime.maxNs();
+
+    s.latencyCount  = m_latency.count();
+    s.latencyMeanNs = m_latency.meanNs();
+    s.latencyP50Ns  = m_latency.percentileNs(0.50);
+    s.latencyP99Ns  = m_latency.percentileNs(0.99);
+    s.latencyMaxNs  = m_latency.maxNs();
+    return s;
+}
+
+QJsonObject IngestStatsSnapshot::toJson() const
+{
+    // Counters as doubles: QJsonValue has no 64-bit unsigned type
+    QJsonObject parse;
+    parse["count"]   = double(parseCount);
+    parse["mean_ns"] = double(parseMeanNs);
+    parse["p50_ns"]  = double(parseP50Ns);
+    parse["p99_ns"]  = double(parseP99Ns);
+    parse["max_ns"]  = double(parseMaxNs);
+
+    QJsonObject latency;
+    latency["count"]   = double(latencyCount);
+    latency["mean_ns"] = double(latencyMeanNs);
+    latency["p50_ns"]  = double(latencyP50Ns);
+    latency["p99_ns"]  = double(latencyP99Ns);
+    latency["max_ns"]  = double(latencyMaxNs);
+
+    QJsonObject o;
+    o["source"]           = source;
+    o["protocol"]         = protocol;
+    o["active"]           = active;
+    o["frames"]           = double(frames);
+    o["bytes"]            = double(bytes);
+    o["updates"]          = double(updates);
+    o["parse_failures"]   = double(parseFailures);
+    o["oversized_frames"] = double(oversizedFrames);
+    o["resync_bytes"]     = double(resyncBytes);
+    o["kernel_drops"]     = double(kernelDrops);
+    o["frames_per_sec"]   = framesPerSec;
+    o["bytes_per_sec"]    = bytesPerSec;
+    o["parse_time"]       = parse;
+    o["receive_to_dispatch"] = latency;
+    return o;
+}
@@ -0,0 +1,119 @@
+#ifndef INGESTSTATS_H
+#define INGESTSTATS_H
+
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+#include <atomic>
+
+/**
+ * LatencyHistogram – Lock-free log2 histogram of nanosecond durations.
+ *
+ * Bucket i counts samples in [2^i, 2^(i+1)) ns (bucket 0 also takes 0 ns),
+ * so 40 buckets span 1 ns .. ~18 min with ±50 % resolution – enough to tell
+ * a 20 µs parse from a 2 ms one. record() is a handful of relaxed atomic
+ * adds and may be called from any thread; readers see a consistent-enough
+ * view for monitoring (no cross-counter snapshot guarantee).
+ */
+class LatencyHistogram
+{
+public:
+    static const int kBuckets = 40;
+
+    LatencyHistogram() { reset(); }
+
+    void record(qint64 ns);
+    void reset();
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    qint64  maxNs() const { return m_max.load(std::memory_order_relaxed); }
+    qint64  meanNs() const;
+    /** Upper bound of the bucket holding the p-th percentile (0 < p <= 1). */
+    qint64  percentileNs(double p) const;
+
+private:
+    std::atomic<quint64> m_buckets[kBuckets];
+    std::atomic<quint64> m_count{0};
+    std::atomic<quint64> m_sum{0};
+    std::atomic<qint64>  m_max{0};
+};
+
+/** Plain copy of one feed's counters, with rates over the last interval. */
+struct IngestStatsSnapshot {
+    QString source;             // handler key ("" = global TCP, component id, ...)
+    QString protocol;
+    bool    active = false;     // a handler currently feeds these counters
+
+    quint64 frames = 0;
+    quint64 bytes = 0;
+    quint64 updates = 0;        // HealthUpdates produced
+    quint64 parseFailures = 0;
+    quint64 oversizedFrames = 0;
+    quint64 resyncBytes = 0;    // bytes skipped to find the next frame boundary
+    quint64 kernelDrops = 0;    // datagrams dropped by the kernel (UDP, SO_RXQ_OVFL)
+    double  framesPerSec = 0.0;
+    double  bytesPerSec = 0.0;
+
+    quint64 parseCount = 0;
+    qint64  parseMeanNs = 0, parseP50Ns = 0, parseP99Ns = 0, parseMaxNs = 0;
+    quint64 latencyCount = 0;
+    qint64  latencyMeanNs = 0, latencyP50Ns = 0, latencyP99Ns = 0, latencyMaxNs = 0;
+
+    QJsonObject toJson() const;
+};
+
+/**
+ * IngestStats – Counters for one ingest feed (one protocol handler key).
+ *
+ * Written from whichever thread services the feed – the handler's thread
+ * for frame/parse counters, the GUI thread for dispatch latency – without
+ * locks. MessageServer owns one instance per handler key for its whole
+ * lifetime, so the pointer carried by HealthUpdate::source stays valid even
+ * after the handler that produced the update is destroyed.
+ */
+class IngestStats
+{
+public:
+    /** Monotonic timestamp shared by all threads (steady clock, ns). */
+    static qint64 nowNs();
+
+    void addFrame(int bytes, bool parsed, int updates, qint64 parseNs)
+    {
+        m_frames.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(static_cast<quint64>(qMax(0, bytes)), std::memory_order_relaxed);
+        m_updates.fetch_add(static_cast<quint64>(updates), std::memory_order_relaxed);
+        if (!parsed) m_parseFailures.fetch_add(1, std::memory_order_relaxed);
+        m_parseTime.record(parseNs);
+    }
+    void addOversized(quint64 n = 1) { m_oversized.fetch_add(n, std::memory_order_relaxed); }
+    void addResyncBytes(quint64 n) { m_resyncBytes.fetch_add(n, std::memory_order_relaxed); }
+    void addKernelDrops(quint64 n) { m_kernelDrops.fetch_add(n, std::memory_order_relaxed); }
+    void addLatency(qint64 ns) { m_latency.record(ns); }
+
+    quint64 frames() const { return m_frames.load(std::memory_order_relaxed); }
+    quint64 bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+    quint64 parseFailures() const { return m_parseFailures.load(std::memory_order_relaxed); }
+    const LatencyHistogram& parseTime() const { return m_parseTime; }
+    const LatencyHistogram& latency() const { return m_latency; }
+
+    void reset();
+
+    /**
+     * Copy the counters; rates are computed against @p previous (taken
+     * @p elapsedNs earlier), pass a default snapshot and 0 for none.
+     */
+    IngestStatsSnapshot snapshot(const IngestStatsSnapshot& previous, qint64 elapsedNs) const;
+
+private:
+    std::atomic<quint64> m_frames{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<quint64> m_updates{0};
+    std::atomic<quint64> m_parseFailures{0};
+    std::atomic<quint64> m_oversized{0};
+    std::atomic<quint64> m_resyncBytes{0};
+    std::atomic<quint64> m_kernelDrops{0};
+    LatencyHistogram     m_parseTime;
+    LatencyHistogram     m_latency;     // receive → GUI-thread signal emission (dispatch)
+};
+
+#endif // INGESTSTATS_H
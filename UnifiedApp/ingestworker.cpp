@@ -0,0 +1,85 @@
+#include "ingestworker.h"
+#include "protocolhandler.h"
+#include "ingeststats.h"
+#include <QMetaObject>
+#include <QDebug>
+
+IngestWorker::IngestWorker(int index, int queueCapacity, QObject* parent)
+    : QObject(parent)
+    , m_index(index)
+    , m_thread(new QThread(this))
+    , m_context(new QObject())
+    , m_queue(static_cast<std::size_t>(qMax(2, queueCapacity)))
+{
+    m_thread->setObjectName(QString("ingest-%1").arg(index));
+    m_context->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_context, &QObject::deleteLater);
+}
+
+IngestWorker::~IngestWorker()
+{
+    stop();
+}
+
+void IngestWorker::start()
+{
+    if (m_thread->isRunning()) return;
+    m_thread->start();
+    qDebug() << "[Ingest] Worker" << m_index << "started";
+}
+
+void IngestWorker::stop()
+{
+    if (!m_thread->isRunning()) return;
+    m_thread->quit();
+    m_thread->wait();
+    qDebug() << "[Ingest] Worker" << m_index << "stopped";
+}
+
+bool IngestWorker::adopt(ProtocolHandler* handler)
+{
+    if (!handler || !m_thread->isRunning()) return false;
+
+    handler->moveToThread(m_thread);
+
+    // Direct connection: the lambda runs on the handler's (worker) thread.
+    connect(handler, &ProtocolHandler::dataReceived, handler,
+            [this, handler](const QByteArray& data) { ingest(handler, data); },
+            Qt::DirectConnection);
+
+    bool ok = false;
+    QMetaObject::invokeMethod(m_context, [handler, &ok]() {
+        ok = handler->start();
+    }, Qt::BlockingQueuedConnection);
+    return ok;
+}
+
+void IngestWorker::release(ProtocolHandler* handler)
+{
+    if (!handler) return;
+    if (!m_thread->isRunning()) {
+        delete handler;
+        return;
+    }
+    QMetaObject::invokeMethod(m_context, [handler]() {
+        handler->stop();
+        delete handler;
+    }, Qt::BlockingQueuedConnection);
+}
+
+void IngestWorker::ingest(ProtocolHandler* handler, const QByteArray& data)
+{
+    IngestStats* stats = handler->stats();
+    const qint64 t0 = IngestStats::nowNs();
+    m_scratch.clear();
+    bool ok = m_parser.parse(data, m_scratch);
+    if (stats) stats->addFrame(data.size(), ok, m_scratch.size(), IngestStats::nowNs() - t0);
+    if (!ok) return;
+
+    for (HealthUpdate& u : m_scratch) {
+        u.source = stats;
+        u.receivedNs = t0;
+        if (!m_queue.push(std::move(u)))
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef INGESTWORKER_H
+#define INGESTWORKER_H
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include "healthupdate.h"
+#include "healthmessageparser.h"
+#include "spscqueue.h"
+
+class ProtocolHandler;
+
+/**
+ * IngestWorker – One background ingest thread used by MessageServer.
+ *
+ * Protocol handlers adopted by a worker are moved onto its thread, so their
+ * sockets / serial ports / poll timers are serviced there. Every frame they
+ * emit is decoded in place by HealthMessageParser and the resulting typed
+ * HealthUpdates are pushed into a lock-free SpscQueue. The GUI thread
+ * empties that queue with drain(), normally once per UI frame.
+ *
+ * The worker object itself lives on the thread that created it (the GUI
+ * thread); only the adopted handlers and an internal context object live on
+ * the worker thread.
+ */
+class IngestWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit IngestWorker(int index, int queueCapacity = 8192, QObject* parent = nullptr);
+    ~IngestWorker() override;
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_thread->isRunning(); }
+    int  index() const { return m_index; }
+
+    /**
+     * Move @p handler (which must have no parent) onto this worker's thread
+     * and start it there. Blocks until start() has returned.
+     */
+    bool adopt(ProtocolHandler* handler);
+
+    /** Stop and destroy an adopted handler on the worker thread. Blocks. */
+    void release(ProtocolHandler* handler);
+
+    /**
+     * Pop queued updates and invoke @p fn for each one on the calling thread.
+     * Only the items present at entry are drained so a busy producer cannot
+     * keep the caller looping. Returns the number of updates delivered.
+     */
+    template <typename Fn>
+    int drain(Fn fn)
+    {
+        int n = static_cast<int>(m_queue.sizeApprox());
+        int done = 0;
+        HealthUpdate u;
+        while (done < n && m_queue.pop(u)) {
+            fn(u);
+            ++done;
+        }
+        return done;
+    }
+
+    /** Updates discarded because the queue was full (consumer too slow). */
+    quint64 droppedUpdates() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    void ingest(ProtocolHandler* handler, const QByteArray& data);   // runs on the worker thread
+
+    int      m_index;
+    QThread* m_thread;
+    QObject* m_context;                    // lives on m_thread
+
+    SpscQueue<HealthUpdate> m_queue;
+    HealthMessageParser     m_parser;      // touched only by the worker thread
+    QVector<HealthUpdate>   m_scratch;     // touched only by the worker thread
+    std::atomic<quint64>    m_dropped{0};
+};
+
+#endif // INGESTWORKER_H
@@ -14,6 +14,7 @@
 #include <QDir>
 #include <QFrame>
 #include <QSplitter>
+#include <QSettings>
 
 MainWindow::MainWindow(const QString& username, UserRole role, QWidget* parent)
     : QMainWindow(parent)
@@ -24,6 +25,7 @@ MainWindow::MainWindow(const QString& username, UserRole role, QWidget* parent)
     , m_analytics(nullptr)
     , m_analyticsDashboard(nullptr)
     , m_messageServer(nullptr)
+    , m_healthCache(nullptr)
     , m_statusLabel(nullptr)
     , m_userLabel(nullptr)
     , m_connectedClients(0)
@@ -102,6 +104,7 @@ void MainWindow::applyRoleRestrictions()
         
         // Hide dashboard button (only for Operator mode)
         if (m_dashboardBtn) m_dashboardBtn->setVisible(false);
+        if (m_ingestStatsBtn) m_ingestStatsBtn->setVisible(false);
         
     } else if (m_role == UserRole::Operator) {
         // Operator: Monitor-only. Can load designs to view, but no design tools.
@@ -257,6 +260,15 @@ void MainWindow::setupUI()
     m_radarAntennaBtnAction = toolbar->addWidget(m_radarAntennaBtn);
     connect(m_radarAntennaBtn, &QPushButton::clicked, this, &MainWindow::toggleRadarAntennaPanel);
 
+    // Ingest diagnostics button (panel exists only when the message server runs)
+    m_ingestStatsBtn = new QPushButton("⏱ INGEST STATS", this);
+    m_ingestStatsBtn->setObjectName("ingestStatsBtn");
+    m_ingestStatsBtn->setCursor(Qt::PointingHandCursor);
+    m_ingestStatsBtn->setToolTip("Per-feed ingest throughput, parse failures and latency");
+    m_ingestStatsBtn->setCheckable(true);
+    toolbar->addWidget(m_ingestStatsBtn);
+    connect(m_ingestStatsBtn, &QPushButton::clicked, this, &MainWindow::toggleIngestDiagnosticsPanel);
+
     toolbar->addSeparator();
 
     // Logout button (top right corner)
@@ -415,6 +427,21 @@ void MainWindow::setupUI()
         
         // Message server for health data from external systems
         m_messageServer = new MessageServer(this);
+
+        // Optional off-GUI-thread ingest ("ingest/workerThreads", 0 = disabled)
+        QSettings settings;
+        m_messageServer->setIngestThreadCount(
+            settings.value("ingest/workerThreads", 0).toInt());
+
+        // "ingest/listenerMode": "global" (default) delivers everything from
+        // the global listeners; "shared" routes TCP/UDP components through
+        // the routing table (channel IDs, unrouted-update accounting)
+        if (settings.value("ingest/listenerMode", "global").toString() == "shared") {
+            m_messageServer->setListenerMode(MessageServer::ListenerMode::Shared);
+            m_messageServer->setDropUnrouted(
+                settings.value("ingest/dropUnrouted", false).toBool());
+        }
+
         if (m_messageServer->startServer(12345)) {
             if (m_statusLabel) {
                 m_statusLabel->setText("STATUS: ACTIVE  |  PORT: 12345  |  CLIENTS: 0");
@@ -425,7 +452,63 @@ void MainWindow::setupUI()
             }
             qWarning() << "[MainWindow] Failed to start message server on port 12345";
         }
+
+        // Ingest counters: sampled every "diagnostics/statsIntervalMs"; set
+        // "diagnostics/statsDumpPath" to append one JSON line per sample
+        m_messageServer->setStatsInterval(
+            settings.value("diagnostics/statsIntervalMs", 1000).toInt());
+        const QString dumpPath = settings.value("diagnostics/statsDumpPath").toString();
+        if (!dumpPath.isEmpty())
+            m_messageServer->setStatsDumpFile(dumpPath);
+
+        // Raw frame journal ("capture/recordPath") and startup replay of a
+        // capture ("capture/replayPath", "capture/replaySpeed", 0 = max speed)
+        const QString recordPath = settings.value("capture/recordPath").toString();
+        if (!recordPath.isEmpty())
+            m_messageServer->startRecording(recordPath);
+        connect(m_messageServer, &MessageServer::replayFinished, this,
+                [](const ReplayReport& report) {
+            qDebug() << "[MainWindow] Replay finished:" << report.summary();
+        });
+        const QString replayPath = settings.value("capture/replayPath").toString();
+        if (!replayPath.isEmpty())
+            m_messageServer->startReplay(replayPath,
+                                         settings.value("capture/replaySpeed", 1.0).toDouble());
+
+        m_ingestPanel = new IngestDiagnosticsPanel(m_messageServer, this);
+        m_ingestDock = new QDockWidget("Ingest Diagnostics", this);
+        m_ingestDock->setObjectName("ingestDiagnosticsDock");
+        m_ingestDock->setWidget(m_ingestPanel);
+        m_ingestDock->setAllowedAreas(Qt::AllDockWidgetAreas);
+        m_ingestDock->setFeatures(QDockWidget::DockWidgetMovable |
+                                  QDockWidget::DockWidgetFloatable |
+                                  QDockWidget::DockWidgetClosable);
+        m_ingestDock->hide();
+        addDockWidget(Qt::BottomDockWidgetArea, m_ingestDock);
+        connect(m_ingestDock, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+            if (m_ingestStatsBtn) m_ingestStatsBtn->setChecked(visible);
+        });
         
+        // Latest-value cache: every update is counted, the UI only sees the
+        // newest state per component/subsystem at "ui/refreshHz" (0 = no conflation)
+        m_healthCache = new HealthStateCache(this);
+        m_healthCache->setRefreshRate(settings.value("ui/refreshHz", 30).toInt());
+        connect(m_healthCache, &HealthStateCache::componentHealthChanged,
+                this, &MainWindow::applyComponentHealth);
+        connect(m_healthCache, &HealthStateCache::subsystemHealthChanged,
+                this, &MainWindow::applySubsystemHealth);
+        connect(m_healthCache, &HealthStateCache::trmDataChanged,
+                this, &MainWindow::applyTrmData);
+        connect(m_healthCache, &HealthStateCache::flushed, this, [this]() {
+            m_analytics->updateDisplay();
+            if (m_statusLabel) {
+                m_statusLabel->setToolTip(QString("Health updates: %1 received, %2 shown, %3 conflated")
+                    .arg(m_healthCache->receivedUpdates())
+                    .arg(m_healthCache->deliveredUpdates())
+                    .arg(m_healthCache->conflatedUpdates()));
+            }
+        });
+
         connect(m_messageServer, &MessageServer::messageReceived,
                 this, &MainWindow::onMessageReceived);
         connect(m_messageServer, &MessageServer::subsystemHealthReceived,
@@ -552,6 +635,8 @@ void MainWindow::loadDesign()
     file.close();
     
     m_analytics->clear();
+    if (m_healthCache) m_healthCache->clear();
+    if (m_messageServer) m_messageServer->clearComponentProtocols();
     m_canvas->loadFromJson(json);
     
     // Update analytics for all loaded components
@@ -571,6 +656,8 @@ void MainWindow::clearCanvas()
 {
     m_canvas->clearCanvas();
     m_analytics->clear();
+    if (m_healthCache) m_healthCache->clear();
+    if (m_messageServer) m_messageServer->clearComponentProtocols();
     clearComponentTabs();
 }
 
@@ -670,6 +757,8 @@ void MainWindow::autoLoadDesign()
     file.close();
     
     m_analytics->clear();
+    if (m_healthCache) m_healthCache->clear();
+    if (m_messageServer) m_messageServer->clearComponentProtocols();
     m_canvas->loadFromJson(json);
     
     // Update analytics
@@ -699,6 +788,7 @@ void MainWindow::onComponentAdded(const QString& id, const QString& typeId)
         displayName = registry.getComponent(typeId).displayName;
     }
     m_analytics->addComponent(id, displayName);
+    routeComponentHealth(id, typeId);
     
     // Add all subcomponents to analytics
     Component* comp = m_canvas->getComponentById(id);
@@ -718,6 +808,24 @@ void MainWindow::onComponentAdded(const QString& id, const QString& typeId)
     }
 }
 
+void MainWindow::routeComponentHealth(const QString& id, const QString& typeId)
+{
+    // Only the shared listener mode keeps a per-component routing table;
+    // serial/Modbus/CAN components are not opened from here
+    if (!m_messageServer
+            || m_messageServer->listenerMode() != MessageServer::ListenerMode::Shared)
+        return;
+
+    ComponentRegistry& registry = ComponentRegistry::instance();
+    if (!registry.hasComponent(typeId)) return;
+
+    ProtocolType type = ProtocolHandler::fromString(registry.getComponent(typeId).protocol);
+    if (type != ProtocolType::TCP && type != ProtocolType::UDP) return;
+
+    m_messageServer->registerComponentProtocol(
+        id, type, registry.buildProtocolConfig(typeId, id));
+}
+
 void MainWindow::onComponentLoaded(const QString& id, const QString& typeId)
 {
     ComponentRegistry& registry = ComponentRegistry::instance();
@@ -726,6 +834,7 @@ void MainWindow::onComponentLoaded(const QString& id, const QString& typeId)
         displayName = registry.getComponent(typeId).displayName;
     }
     m_analytics->addComponent(id, displayName);
+    routeComponentHealth(id, typeId);
     
     // Add all subcomponents to analytics
     Component* comp = m_canvas->getComponentById(id);
@@ -797,6 +906,7 @@ void MainWindow::onComponentRemoved(const QString& id, const QString& typeId)
     
     // Remove from analytics
     m_analytics->removeComponent(id);
+    if (m_messageServer) m_messageServer->unregisterComponentProtocol(id);
     
     // Close and remove enlarged view tab if it exists
     if (m_enlargedViews.contains(id)) {
@@ -826,6 +936,13 @@ void MainWindow::onDropRejected(const QString& reason)
 }
 
 void MainWindow::onMessageReceived(const QString& componentId, const QString& color, qreal size)
+{
+    // Statistics see every message; the display is refreshed once per cache flush
+    m_analytics->recordMessage(componentId, color, size, false);
+    m_healthCache->updateComponent(componentId, color, size);
+}
+
+void MainWindow::applyComponentHealth(const QString& componentId, const QString& color, qreal size)
 {
     Component* comp = m_canvas->getComponentById(componentId);
     
@@ -836,8 +953,6 @@ void MainWindow::onMessageReceived(const QString& componentId, const QString& co
         qDebug() << "[MainWindow] Component" << componentId << "not found in canvas.";
     }
     
-    m_analytics->recordMessage(componentId, color, size);
-    
     // Update enlarged view if it exists
     if (m_enlargedViews.contains(componentId)) {
         m_enlargedViews[componentId]->updateComponentHealth(QColor(color), size);
@@ -856,6 +971,13 @@ void MainWindow::onMessageReceived(const QString& componentId, const QString& co
 void MainWindow::onSubsystemHealthReceived(const QString& componentId,
                                             const QString& subsystemName,
                                             const QString& color, qreal health)
+{
+    m_healthCache->updateSubsystem(componentId, subsystemName, color, health);
+}
+
+void MainWindow::applySubsystemHealth(const QString& componentId,
+                                      const QString& subsystemName,
+                                      const QString& color, qreal health)
 {
     // Update the sub-component within the canvas component
     Component* comp = m_canvas->getComponentById(componentId);
@@ -881,13 +1003,18 @@ void MainWindow::onTelemetryReceived(const QString& componentId, const QJsonObje
              << "- array_current:" << telemetry.value("array_current").toDouble();
 }
 
-void MainWindow::onTrmDataReceived(const QString& componentId, const QJsonArray& trmArray)
+void MainWindow::onTrmDataReceived(const QString& componentId, const TrmRecordList& trms)
 {
     qDebug() << "[MainWindow] TRM data received for" << componentId
-             << "- TRMs:" << trmArray.size();
+             << "- TRMs:" << trms.size();
+
+    m_healthCache->updateTrmData(componentId, trms);
+}
 
+void MainWindow::applyTrmData(const QString& componentId, const TrmRecordList& trms)
+{
     if (m_enlargedViews.contains(componentId)) {
-        m_enlargedViews[componentId]->updateTrmData(trmArray);
+        m_enlargedViews[componentId]->updateTrmData(trms);
     }
 }
 
@@ -1069,6 +1196,21 @@ void MainWindow::toggleRadarAntennaPanel()
     }
 }
 
+void MainWindow::toggleIngestDiagnosticsPanel()
+{
+    if (!m_ingestDock) {
+        if (m_ingestStatsBtn) m_ingestStatsBtn->setChecked(false);
+        return;
+    }
+
+    if (m_ingestDock->isVisible()) {
+        m_ingestDock->hide();
+    } else {
+        m_ingestDock->show();
+        m_ingestDock->raise();
+    }
+}
+
 // ======================================================================
 // Logout
 // ======================================================================
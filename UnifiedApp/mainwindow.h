@@ -15,6 +15,8 @@
 #include "analytics.h"
 #include "analyticsdashboard.h"
 #include "messageserver.h"
+#include "healthstatecache.h"
+#include "ingestdiagnosticspanel.h"
 #include "voicealertmanager.h"
 #include "enlargedcomponentview.h"
 #include "thememanager.h"
@@ -63,7 +65,11 @@ private slots:
     void onSubsystemHealthReceived(const QString& componentId, const QString& subsystemName,
                                    const QString& color, qreal health);
     void onTelemetryReceived(const QString& componentId, const QJsonObject& telemetry);
-    void onTrmDataReceived(const QString& componentId, const QJsonArray& trmArray);
+    void onTrmDataReceived(const QString& componentId, const TrmRecordList& trms);
+    void applyComponentHealth(const QString& componentId, const QString& color, qreal size);
+    void applySubsystemHealth(const QString& componentId, const QString& subsystemName,
+                              const QString& color, qreal health);
+    void applyTrmData(const QString& componentId, const TrmRecordList& trms);
     void onClientConnected();
     void onClientDisconnected();
     void toggleVoiceAlerts();
@@ -94,6 +100,7 @@ private:
     void createComponentTabs();
     void clearComponentTabs();
     void addComponentTab(Component* comp);
+    void routeComponentHealth(const QString& id, const QString& typeId);
     void updateThemeButtonText();
     void refreshCanvasBackground();
     
@@ -105,6 +112,7 @@ private:
     Analytics* m_analytics;
     AnalyticsDashboard* m_analyticsDashboard;
     MessageServer* m_messageServer;
+    HealthStateCache* m_healthCache;
     QLabel* m_statusLabel;
     QLabel* m_userLabel;
     int m_connectedClients;
@@ -164,8 +172,14 @@ private:
     QPushButton        *m_radarAntennaBtn    = nullptr;
     QAction            *m_radarAntennaBtnAction = nullptr;
 
+    // ── Ingest diagnostics panel (Operator only) ───────────────────
+    IngestDiagnosticsPanel *m_ingestPanel    = nullptr;
+    QDockWidget            *m_ingestDock     = nullptr;
+    QPushButton            *m_ingestStatsBtn = nullptr;
+
 private slots:
     void toggleRadarAntennaPanel();
+    void toggleIngestDiagnosticsPanel();
 };
 
 #endif // MAINWINDOW_H
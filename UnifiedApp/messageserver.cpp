@@ -1,22 +1,43 @@
 #include "messageserver.h"
 #include "tcpprotocolhandler.h"
 #include "udpprotocolhandler.h"
-#include <QJsonDocument>
+#include "ingestworker.h"
+#include "replayprotocolhandler.h"
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QJsonDocument>
+#include <QDateTime>
 #include <QDebug>
 
+static const char kReplayKey[] = "replay";
+
 // ────────────────────────────────────────────────────────────────────────────
 //  Construction / destruction
 // ────────────────────────────────────────────────────────────────────────────
 
 MessageServer::MessageServer(QObject* parent)
     : QObject(parent)
-{}
+    , m_drainTimer(new QTimer(this))
+    , m_statsTimer(new QTimer(this))
+{
+    qRegisterMetaType<ReplayReport>("ReplayReport");
+
+    m_drainTimer->setInterval(16);   // ~60 Hz, one drain per UI frame
+    connect(m_drainTimer, &QTimer::timeout, this, &MessageServer::drainWorkers);
+
+    m_statsTimer->setInterval(1000);
+    connect(m_statsTimer, &QTimer::timeout, this, &MessageServer::sampleStats);
+    m_statsTimer->start();
+    m_lastSampleNs = IngestStats::nowNs();
+}
 
 MessageServer::~MessageServer()
 {
     stopServer();
+    setIngestThreadCount(0);
+    m_recorder.close();
+    m_statsDump.close();
+    qDeleteAll(m_stats);
 }
 
 // ────────────────────────────────────────────────────────────────────────────
@@ -40,7 +61,7 @@ bool MessageServer::startServer(quint16 port)
 bool MessageServer::startUdpServer(quint16 port)
 {
     // Global UDP handler (key "udp_global")
-    const QString key = "udp_global";
+    const QString key = QStringLiteral("udp_global");
     if (m_handlers.contains(key) && m_handlers[key].handler->isRunning())
         return true;
 
@@ -52,11 +73,11 @@ bool MessageServer::startUdpServer(quint16 port)
 
 void MessageServer::stopServer()
 {
-    for (auto it = m_handlers.begin(); it != m_handlers.end(); ++it) {
-        it->handler->stop();
-        it->handler->deleteLater();
-    }
+    for (auto it = m_handlers.begin(); it != m_handlers.end(); ++it)
+        destroyHandler(*it);
     m_handlers.clear();
+    m_routes.clear();
+    m_channelRoutes.clear();
 }
 
 bool MessageServer::isRunning() const
@@ -81,25 +102,45 @@ bool MessageServer::registerComponentProtocol(const QString& componentId,
 {
     // Stop & remove existing handler for this component
     if (m_handlers.contains(componentId)) {
-        m_handlers[componentId].handler->stop();
-        m_handlers[componentId].handler->deleteLater();
+        destroyHandler(m_handlers[componentId]);
         m_handlers.remove(componentId);
     }
 
-    ProtocolHandler* h = ProtocolHandlerFactory::create(type, config, this);
+    // Shared mode: TCP/UDP components become routes on one listener
+    if (m_listenerMode == ListenerMode::Shared && !isGlobalKey(componentId)
+            && (type == ProtocolType::TCP || type == ProtocolType::UDP)) {
+        if (!ensureSharedListener(type, config)) {
+            m_routes.remove(componentId);
+            rebuildChannelRoutes();
+            return false;
+        }
+        setRoute(componentId, type, config, true);
+        qDebug() << "[MessageServer] Routed component" << componentId
+                 << "to shared" << ProtocolHandler::toString(type) << "listener";
+        return true;
+    }
+
+    // Handlers bound for a worker thread must be parentless so they can move
+    ProtocolHandler* h = ProtocolHandlerFactory::create(type, config,
+                                                         m_workers.isEmpty() ? this : nullptr);
     if (!h) return false;
 
     attachHandler(componentId, h);
 
-    if (!h->start()) {
+    const HandlerEntry& entry = m_handlers[componentId];
+    bool started = entry.worker ? entry.worker->adopt(h) : h->start();
+    if (!started) {
         qWarning() << "[MessageServer] Failed to start"
                    << h->protocolName() << "handler for component"
                    << (componentId.isEmpty() ? "(global)" : componentId);
-        h->deleteLater();
+        destroyHandler(entry);
         m_handlers.remove(componentId);
         return false;
     }
 
+    if (!isGlobalKey(componentId))
+        setRoute(componentId, type, config, false);
+
     qDebug() << "[MessageServer] Registered" << h->protocolName()
              << "handler for component"
              << (componentId.isEmpty() ? "(global)" : componentId);
@@ -108,14 +149,17 @@ bool MessageServer::registerComponentProtocol(const QString& componentId,
 
 void MessageServer::unregisterComponentProtocol(const QString& componentId)
 {
+    if (m_routes.remove(componentId))
+        rebuildChannelRoutes();
     if (!m_handlers.contains(componentId)) return;
-    m_handlers[componentId].handler->stop();
-    m_handlers[componentId].handler->deleteLater();
+    destroyHandler(m_handlers[componentId]);
     m_handlers.remove(componentId);
 }
 
 ProtocolType MessageServer::protocolForComponent(const QString& componentId) const
 {
+    if (m_routes.contains(componentId))
+        return m_routes[componentId].type;
     if (m_handlers.contains(componentId))
         return m_handlers[componentId].type;
     return ProtocolType::TCP;
@@ -123,7 +167,289 @@ ProtocolType MessageServer::protocolForComponent(const QString& componentId) con
 
 QStringList MessageServer::registeredComponents() const
 {
-    return m_handlers.keys();
+    QStringList ids = m_handlers.keys();
+    for (auto it = m_routes.constBegin(); it != m_routes.constEnd(); ++it) {
+        if (it.value().shared) ids.append(it.key());
+    }
+    return ids;
+}
+
+void MessageServer::clearComponentProtocols()
+{
+    for (auto it = m_handlers.begin(); it != m_handlers.end(); ) {
+        if (isGlobalKey(it.key())) { ++it; continue; }
+        destroyHandler(*it);
+        it = m_handlers.erase(it);
+    }
+    m_routes.clear();
+    m_channelRoutes.clear();
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Listener mode / routing table
+// ────────────────────────────────────────────────────────────────────────────
+
+bool MessageServer::setListenerMode(ListenerMode mode)
+{
+    if (mode == m_listenerMode) return true;
+    for (auto it = m_handlers.constBegin(); it != m_handlers.constEnd(); ++it) {
+        if (!isGlobalKey(it.key())) {
+            qWarning() << "[MessageServer] Listener mode must be set before"
+                       << "any component protocol is registered";
+            return false;
+        }
+    }
+    if (!m_routes.isEmpty()) return false;
+
+    m_listenerMode = mode;
+    qDebug() << "[MessageServer] Listener mode:"
+             << (mode == ListenerMode::Shared ? "shared" : "per-component");
+    return true;
+}
+
+bool MessageServer::isGlobalKey(const QString& key)
+{
+    return key.isEmpty() || key == QLatin1String("udp_global")
+        || key == QLatin1String(kReplayKey);
+}
+
+bool MessageServer::ensureSharedListener(ProtocolType type, const QVariantMap& config)
+{
+    // The first route decides the port; later routes join whatever is running
+    const bool tcp = type == ProtocolType::TCP;
+    const int port = config.value("port", tcp ? 12345 : 12346).toInt();
+    const QString key = tcp ? QString() : QStringLiteral("udp_global");
+    if (m_handlers.contains(key) && m_handlers[key].type == type
+            && m_handlers[key].handler->isRunning()) {
+        const int running = m_handlers[key].handler->config().value("port").toInt();
+        if (running != port)
+            qWarning() << "[MessageServer] Shared" << ProtocolHandler::toString(type)
+                       << "listener is on port" << running << "- configured port" << port
+                       << "is ignored; the component must send to" << running;
+        return true;
+    }
+    if (tcp)
+        return startServer(static_cast<quint16>(port));
+    return startUdpServer(static_cast<quint16>(port));
+}
+
+void MessageServer::setRoute(const QString& componentId, ProtocolType type,
+                             const QVariantMap& config, bool shared)
+{
+    Route r;
+    r.type = type;
+    r.channel = config.value("channel_id", -1).toInt();
+    r.shared = shared;
+    m_routes[componentId] = r;
+    rebuildChannelRoutes();
+}
+
+void MessageServer::rebuildChannelRoutes()
+{
+    m_channelRoutes.clear();
+    for (auto it = m_routes.constBegin(); it != m_routes.constEnd(); ++it) {
+        int ch = it.value().channel;
+        if (ch < 0) continue;
+        if (m_channelRoutes.contains(ch))
+            qWarning() << "[MessageServer] Channel" << ch << "routed to both"
+                       << m_channelRoutes[ch] << "and" << it.key();
+        m_channelRoutes.insert(ch, it.key());
+    }
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Threaded ingest
+// ────────────────────────────────────────────────────────────────────────────
+
+bool MessageServer::setIngestThreadCount(int count)
+{
+    count = qMax(0, count);
+    if (count == m_workers.size()) return true;
+    if (!m_handlers.isEmpty()) {
+        qWarning() << "[MessageServer] Ingest thread count must be set before"
+                   << "any protocol handler is registered";
+        return false;
+    }
+
+    m_drainTimer->stop();
+    qDeleteAll(m_workers);      // ~IngestWorker joins its thread
+    m_workers.clear();
+    m_nextWorker = 0;
+
+    for (int i = 0; i < count; ++i) {
+        IngestWorker* w = new IngestWorker(i, 8192, this);
+        w->start();
+        m_workers.append(w);
+    }
+    if (count > 0) m_drainTimer->start();
+
+    qDebug() << "[MessageServer] Ingest mode:"
+             << (count > 0 ? QString("%1 worker thread(s)").arg(count)
+                           : QString("GUI thread"));
+    return true;
+}
+
+void MessageServer::setDrainInterval(int ms)
+{
+    m_drainTimer->setInterval(qMax(1, ms));
+}
+
+quint64 MessageServer::droppedUpdates() const
+{
+    quint64 total = 0;
+    for (IngestWorker* w : m_workers)
+        total += w->droppedUpdates();
+    return total;
+}
+
+void MessageServer::drainWorkers()
+{
+    for (IngestWorker* w : m_workers)
+        w->drain([this](const HealthUpdate& u) { emitUpdate(u); });
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Instrumentation
+// ────────────────────────────────────────────────────────────────────────────
+
+IngestStats* MessageServer::statsFor(const QString& key)
+{
+    IngestStats*& s = m_stats[key];
+    if (!s) s = new IngestStats;
+    return s;
+}
+
+void MessageServer::resetIngestStats()
+{
+    for (IngestStats* s : m_stats)
+        s->reset();
+    m_prevSnapshots.clear();
+    m_lastSnapshots.clear();
+    m_unrouted = 0;
+    m_lastSampleNs = IngestStats::nowNs();
+}
+
+void MessageServer::setStatsInterval(int ms)
+{
+    m_statsTimer->setInterval(qMax(100, ms));
+}
+
+bool MessageServer::setStatsDumpFile(const QString& path)
+{
+    m_statsDump.close();
+    m_statsDump.setFileName(path);
+    if (path.isEmpty()) return true;
+    if (!m_statsDump.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "[MessageServer] Cannot open stats dump file" << path
+                   << "-" << m_statsDump.errorString();
+        return false;
+    }
+    qDebug() << "[MessageServer] Writing ingest stats to" << path;
+    return true;
+}
+
+void MessageServer::sampleStats()
+{
+    const qint64 now = IngestStats::nowNs();
+    const qint64 elapsed = now - m_lastSampleNs;
+    m_lastSampleNs = now;
+
+    m_lastSnapshots.clear();
+    for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) {
+        IngestStatsSnapshot s = it.value()->snapshot(m_prevSnapshots.value(it.key()), elapsed);
+        s.source = it.key();
+        auto h = m_handlers.constFind(it.key());
+        if (h != m_handlers.constEnd()) {
+            s.protocol = h->handler->protocolName();
+            s.active = h->handler->stats() == it.value();
+        }
+        m_prevSnapshots[it.key()] = s;
+        m_lastSnapshots.append(s);
+    }
+
+    if (m_statsDump.isOpen()) {
+        m_statsDump.write(QJsonDocument(ingestStatsJson()).toJson(QJsonDocument::Compact));
+        m_statsDump.write("\n");
+        m_statsDump.flush();
+    }
+    emit ingestStatsUpdated();
+}
+
+QJsonObject MessageServer::ingestStatsJson() const
+{
+    QJsonArray feeds;
+    for (const IngestStatsSnapshot& s : m_lastSnapshots)
+        feeds.append(s.toJson());
+
+    QJsonObject o;
+    o["timestamp_ms"]     = double(QDateTime::currentMSecsSinceEpoch());
+    o["interval_ms"]      = m_statsTimer->interval();
+    o["ingest_threads"]   = m_workers.size();
+    o["queue_drops"]      = double(droppedUpdates());
+    o["unrouted_updates"] = double(m_unrouted);
+    o["feeds"]            = feeds;
+    return o;
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Replay
+// ────────────────────────────────────────────────────────────────────────────
+
+bool MessageServer::startReplay(const QString& path, double speed, const QStringList& sources)
+{
+    stopReplay();
+
+    QVariantMap cfg;
+    cfg["file"] = path;
+    cfg["speed"] = speed;
+    cfg["sources"] = sources;
+
+    ReplayProtocolHandler* h = new ReplayProtocolHandler(m_workers.isEmpty() ? this : nullptr);
+    h->setConfig(cfg);
+    // Queued even on the GUI thread: the slot destroys the handler that emits it
+    connect(h, &ReplayProtocolHandler::finished, this, &MessageServer::onReplayFinished,
+            Qt::QueuedConnection);
+
+    statsFor(kReplayKey)->reset();
+    m_replayDropBaseline = droppedUpdates();
+    attachHandler(kReplayKey, h);
+
+    const HandlerEntry& entry = m_handlers[kReplayKey];
+    if (!(entry.worker ? entry.worker->adopt(h) : h->start())) {
+        qWarning() << "[MessageServer] Failed to start replay of" << path;
+        destroyHandler(entry);
+        m_handlers.remove(kReplayKey);
+        return false;
+    }
+    return true;
+}
+
+void MessageServer::stopReplay()
+{
+    if (!m_handlers.contains(kReplayKey)) return;
+    // Remove first: stopping emits finished(), which must not destroy it again
+    HandlerEntry entry = m_handlers.take(kReplayKey);
+    destroyHandler(entry);
+}
+
+bool MessageServer::isReplaying() const
+{
+    return m_handlers.contains(kReplayKey);
+}
+
+void MessageServer::onReplayFinished(const ReplayReport& report)
+{
+    ReplayReport r = report;
+    r.droppedFrames = statsFor(kReplayKey)->parseFailures();
+    r.droppedUpdates = droppedUpdates() - m_replayDropBaseline;
+
+    auto it = m_handlers.find(kReplayKey);
+    if (it != m_handlers.end() && it->handler == sender()) {
+        HandlerEntry entry = *it;
+        m_handlers.erase(it);
+        destroyHandler(entry);
+    }
+    emit replayFinished(r);
 }
 
 // ────────────────────────────────────────────────────────────────────────────
@@ -132,22 +458,45 @@ QStringList MessageServer::registeredComponents() const
 
 void MessageServer::attachHandler(const QString& componentId, ProtocolHandler* handler)
 {
-    connect(handler, &ProtocolHandler::dataReceived,
-            this, &MessageServer::onHandlerData);
+    HandlerEntry e;
+    e.type = ProtocolHandler::fromString(handler->protocolName());
+    e.handler = handler;
+    handler->setStats(statsFor(componentId));
+
+    // Journal raw frames on the handler's own thread, before they are parsed
+    if (componentId != QLatin1String(kReplayKey)) {
+        const QString tag = handler->protocolName().toLower() + ':'
+                          + (isGlobalKey(componentId) ? QStringLiteral("global") : componentId);
+        connect(handler, &ProtocolHandler::dataReceived, handler,
+                [this, tag](const QByteArray& data) { m_recorder.write(tag, data); },
+                Qt::DirectConnection);
+    }
+
+    if (!m_workers.isEmpty()) {
+        // Worker decodes frames itself; only lifecycle signals reach us (queued)
+        e.worker = m_workers[m_nextWorker++ % m_workers.size()];
+    } else {
+        connect(handler, &ProtocolHandler::dataReceived, this,
+                [this, handler](const QByteArray& data) {
+                    parseAndEmitMessage(handler->stats(), data);
+                });
+    }
     connect(handler, &ProtocolHandler::connected,
             this, &MessageServer::onHandlerConnected);
     connect(handler, &ProtocolHandler::disconnected,
             this, &MessageServer::onHandlerDisconnected);
 
-    HandlerEntry e;
-    e.type = ProtocolHandler::fromString(handler->protocolName());
-    e.handler = handler;
     m_handlers[componentId] = e;
 }
 
-void MessageServer::onHandlerData(const QByteArray& data)
+void MessageServer::destroyHandler(const HandlerEntry& entry)
 {
-    parseAndEmitMessage(data);
+    if (entry.worker) {
+        entry.worker->release(entry.handler);
+    } else {
+        entry.handler->stop();
+        entry.handler->deleteLater();
+    }
 }
 
 void MessageServer::onHandlerConnected()
@@ -161,71 +510,60 @@ void MessageServer::onHandlerDisconnected()
 }
 
 // ────────────────────────────────────────────────────────────────────────────
-//  Message parsing (unchanged protocol logic)
+//  Message parsing (protocol logic lives in HealthMessageParser)
 // ────────────────────────────────────────────────────────────────────────────
 
-void MessageServer::parseAndEmitMessage(const QByteArray& data)
+void MessageServer::parseAndEmitMessage(IngestStats* stats, const QByteArray& data)
 {
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (!doc.isObject()) {
-        qDebug() << "[MessageServer] Invalid JSON received";
-        return;
+    const qint64 t0 = IngestStats::nowNs();
+    QVector<HealthUpdate> updates;
+    bool ok = m_parser.parse(data, updates);
+    if (stats) stats->addFrame(data.size(), ok, updates.size(), IngestStats::nowNs() - t0);
+    if (!ok) return;
+    for (HealthUpdate& u : updates) {
+        u.source = stats;
+        u.receivedNs = t0;
+        emitUpdate(u);
     }
+}
 
-    QJsonObject obj = doc.object();
-    QString componentId = obj["component_id"].toString();
-    QString color = obj["color"].toString();
-    qreal size = obj["size"].toDouble();
-
-    if (componentId.isEmpty()) {
-        qDebug() << "[MessageServer] Missing component_id in message";
-        return;
-    }
+void MessageServer::injectFrame(const QByteArray& data)
+{
+    parseAndEmitMessage(statsFor(QString()), data);
+}
 
-    // ── Single subsystem update ──────────────────────────────────────
-    if (obj.contains("subsystem")) {
-        QString subsystem = obj["subsystem"].toString();
-        if (!subsystem.isEmpty() && !color.isEmpty()) {
-            emit subsystemHealthReceived(componentId, subsystem, color, size);
-        }
-        return;
-    }
-
-    // ── Component-level health update ────────────────────────────────
-    if (!color.isEmpty() && size >= 0) {
-        emit messageReceived(componentId, color, size);
-    }
-
-    // ── Bulk subsystem health map ────────────────────────────────────
-    if (obj.contains("subsystem_health")) {
-        QJsonObject subHealth = obj["subsystem_health"].toObject();
-        for (auto it = subHealth.begin(); it != subHealth.end(); ++it) {
-            QString subName = it.key();
-            qreal subVal = it.value().toDouble();
-            QString subColor;
-            if (subVal >= 90)      subColor = "#00FF00";
-            else if (subVal >= 70) subColor = "#FFFF00";
-            else if (subVal >= 40) subColor = "#FFA500";
-            else if (subVal >= 10) subColor = "#FF0000";
-            else                   subColor = "#808080";
-            emit subsystemHealthReceived(componentId, subName, subColor, subVal);
-        }
+void MessageServer::emitUpdate(const HealthUpdate& in)
+{
+    // Route: resolve channel-addressed frames, account for unknown components
+    HealthUpdate resolved;
+    const HealthUpdate* p = &in;
+    if (in.componentId.isEmpty()) {
+        const QString id = m_channelRoutes.value(in.channel);
+        if (id.isEmpty()) { ++m_unrouted; return; }
+        resolved = in;
+        resolved.componentId = id;
+        p = &resolved;
+    } else if (m_listenerMode == ListenerMode::Shared && !m_routes.contains(in.componentId)) {
+        ++m_unrouted;
+        if (m_dropUnrouted) return;
     }
-
-    // ── TRM grid data ────────────────────────────────────────────────
-    if (obj.contains("trm_data")) {
-        QJsonArray trmArray = obj["trm_data"].toArray();
-        if (!trmArray.isEmpty()) {
-            qDebug() << "[MessageServer] TRM data received for" << componentId
-                     << "- TRMs:" << trmArray.size();
-            emit trmDataReceived(componentId, trmArray);
-        }
+    const HealthUpdate& u = *p;
+
+    switch (u.kind) {
+    case HealthUpdate::Component:
+        emit messageReceived(u.componentId, u.color, u.value);
+        break;
+    case HealthUpdate::Subsystem:
+        emit subsystemHealthReceived(u.componentId, u.subsystem, u.color, u.value);
+        break;
+    case HealthUpdate::Trm:
+        emit trmDataReceived(u.componentId, u.trms);
+        break;
+    case HealthUpdate::Telemetry:
+        emit telemetryReceived(u.componentId, u.telemetry);
+        break;
     }
 
-    // ── Full APCU telemetry ──────────────────────────────────────────
-    if (obj.contains("apcu_telemetry")) {
-        QJsonObject telemetry = obj["apcu_telemetry"].toObject();
-        qDebug() << "[MessageServer] APCU telemetry received for" << componentId;
-        emit telemetryReceived(componentId, telemetry);
-    }
+    if (u.source && u.receivedNs)
+        u.source->addLatency(IngestStats::nowNs() - u.receivedNs);
 }
@@ -3,9 +3,19 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QFile>
 #include <QJsonObject>
 #include "protocolhandler.h"
 #include "protocolhandlerfactory.h"
+#include "healthupdate.h"
+#include "healthmessageparser.h"
+#include "ingeststats.h"
+#include "framecapture.h"
+
+class IngestWorker;
 
 /**
  * MessageServer – Multi-protocol health message dispatcher.
@@ -25,6 +35,27 @@
  *   The handler forwards its dataReceived() to the same parseAndEmitMessage()
  *   pipeline, with the component_id injected when it is missing from the frame.
  *
+ * Shared listener mode (setListenerMode(ListenerMode::Shared), set before any
+ * registration):
+ *   TCP and UDP registrations do not open a socket per component. They add
+ *   an entry to a routing table and make sure the one shared TCP or UDP
+ *   listener is running (started on the first route's port). Serial, Modbus
+ *   and CAN registrations still get dedicated handlers. Every update is
+ *   routed through the table on the GUI thread:
+ *     - binary frames addressed by channel ID (config key "channel_id")
+ *       resolve to their component there;
+ *     - updates for unknown components are counted (unroutedUpdates()) and
+ *       dropped if setDropUnrouted(true).
+ *
+ * Threaded ingest (optional):
+ *   setIngestThreadCount(n) with n > 0, called before any handler is
+ *   registered, moves every handler onto one of n IngestWorker threads
+ *   (round-robin). Frames are decoded there by HealthMessageParser and only
+ *   typed HealthUpdates cross to the GUI thread through lock-free queues,
+ *   which are drained once per UI frame (setDrainInterval, default 16 ms).
+ *   n == 0 (default) keeps the original behaviour: handlers and parsing on
+ *   the GUI thread, signals emitted synchronously.
+ *
  * JSON message shapes (unchanged from original protocol):
  *   Basic:          { "component_id", "color", "size" }
  *   Single system:  { "component_id", "subsystem", "color", "size" }
@@ -32,6 +63,33 @@
  *                     "subsystem_health": { "Name": 0-100, ... } }
  *   APCU telemetry: { ..., "apcu_telemetry": { ... } }
  *   TRM grid:       { ..., "trm_data": [ { "id", "health", "color", ... }, ... ] }
+ *
+ * Instrumentation:
+ *   Every handler key has an IngestStats block (lock-free counters kept for
+ *   the server's lifetime): frames, bytes, produced updates, parse failures,
+ *   oversized frames, and parse-time and receive→dispatch latency histograms.
+ *   Dispatch latency runs from frame arrival to the end of the update's
+ *   signal emission on the GUI thread (worker queueing and the synchronous
+ *   slots included); it does not include HealthStateCache conflation, which
+ *   can hold the state back for up to one UI refresh period. Every
+ *   setStatsInterval() ms (default 1000) the counters are sampled into
+ *   IngestStatsSnapshots with per-second rates, ingestStatsUpdated() is
+ *   emitted and, if setStatsDumpFile() was given a path, one JSON line is
+ *   appended there.
+ *
+ * Capture / replay:
+ *   startRecording(path) journals every raw frame any handler emits (tagged
+ *   "<protocol>:<component id or global>") into a capture file, see
+ *   framecapture.h. startReplay(path, speed) plays a capture back through a
+ *   ReplayProtocolHandler registered under the key "replay", so replayed
+ *   frames go through the same dataReceived → parse → signal path as live
+ *   ones (including the ingest workers and IngestStats). replayFinished()
+ *   reports the achieved throughput, late frames and what the pipeline
+ *   dropped. Replayed frames are not recorded.
+ *
+ * Binary frames (see binaryhealthframe.h) carrying component health,
+ * interned subsystem health and a packed TRM array are accepted on the same
+ * handlers; the leading magic byte 0xB5 selects the binary decoder.
  */
 class MessageServer : public QObject
 {
@@ -66,33 +124,144 @@ public:
 
     QStringList registeredComponents() const;
 
+    /** Remove every per-component handler and route (global listeners stay). */
+    void clearComponentProtocols();
+
+    // ── Listener mode / routing ───────────────────────────────────
+    enum class ListenerMode {
+        PerComponent,   // one handler (socket) per registered component
+        Shared          // TCP/UDP components share one listener per transport
+    };
+    /** Returns false if component handlers or routes already exist. */
+    bool setListenerMode(ListenerMode mode);
+    ListenerMode listenerMode() const { return m_listenerMode; }
+
+    /** Drop updates whose component has no route (default: deliver them). */
+    void setDropUnrouted(bool drop) { m_dropUnrouted = drop; }
+    quint64 unroutedUpdates() const { return m_unrouted; }
+
+    /** Component a binary channel ID is routed to (empty if none). */
+    QString componentForChannel(int channel) const { return m_channelRoutes.value(channel); }
+
+    // ── Threaded ingest ───────────────────────────────────────────
+    /** Number of ingest worker threads (0 = parse on the GUI thread).
+     *  Returns false if handlers are already registered. */
+    bool setIngestThreadCount(int count);
+    int  ingestThreadCount() const { return m_workers.size(); }
+
+    /** Interval at which worker queues are drained on the GUI thread. */
+    void setDrainInterval(int ms);
+    int  drainInterval() const { return m_drainTimer->interval(); }
+
+    /** Total updates dropped because a worker queue overflowed. */
+    quint64 droppedUpdates() const;
+
+    // ── Instrumentation ───────────────────────────────────────────
+    /** Per-feed counters as of the last sample (rates over that interval). */
+    QList<IngestStatsSnapshot> ingestStats() const { return m_lastSnapshots; }
+    /** Last sample plus server-wide counters, as written to the dump file. */
+    QJsonObject ingestStatsJson() const;
+    void resetIngestStats();
+
+    void setStatsInterval(int ms);
+    int  statsInterval() const { return m_statsTimer->interval(); }
+
+    /** Append one JSON line per sample to @p path (empty = stop dumping). */
+    bool setStatsDumpFile(const QString& path);
+    QString statsDumpFile() const { return m_statsDump.fileName(); }
+
+    // ── Capture / replay ──────────────────────────────────────────
+    bool startRecording(const QString& path) { return m_recorder.open(path); }
+    void stopRecording() { m_recorder.close(); }
+    bool isRecording() const { return m_recorder.isOpen(); }
+
+    /**
+     * Replay a capture file through the normal ingest path.
+     * speed: 1.0 = original timing, N = N× faster, 0 = as fast as possible.
+     * sources: only replay these source tags (empty = all).
+     */
+    bool startReplay(const QString& path, double speed = 1.0,
+                     const QStringList& sources = QStringList());
+    void stopReplay();
+    bool isReplaying() const;
+
+    /** Run one raw frame through parse → route → signals as if the global
+     *  handler had received it, on the calling (GUI) thread. Tools and
+     *  benchmarks use this to drive the pipeline without a socket. */
+    void injectFrame(const QByteArray& data);
+
 signals:
     void messageReceived(const QString& componentId, const QString& color, qreal size);
     void subsystemHealthReceived(const QString& componentId, const QString& subsystemName,
                                  const QString& color, qreal health);
     void telemetryReceived(const QString& componentId, const QJsonObject& telemetry);
-    void trmDataReceived(const QString& componentId, const QJsonArray& trmArray);
+    void trmDataReceived(const QString& componentId, const TrmRecordList& trms);
     void clientConnected();
     void clientDisconnected();
+    /** A new stats sample is available via ingestStats(). */
+    void ingestStatsUpdated();
+    void replayFinished(const ReplayReport& report);
 
 private slots:
-    void onHandlerData(const QByteArray& data);
     void onHandlerConnected();
     void onHandlerDisconnected();
+    void drainWorkers();
+    void sampleStats();
+    void onReplayFinished(const ReplayReport& report);
 
 private:
-    void parseAndEmitMessage(const QByteArray& data);
+    void parseAndEmitMessage(IngestStats* stats, const QByteArray& data);
+    IngestStats* statsFor(const QString& key);
+    void emitUpdate(const HealthUpdate& update);
     void attachHandler(const QString& componentId, ProtocolHandler* handler);
 
     struct HandlerEntry {
         ProtocolType type;
         ProtocolHandler* handler;
+        IngestWorker* worker = nullptr;   // null → handler lives on GUI thread
+    };
+
+    void destroyHandler(const HandlerEntry& entry);
+
+    struct Route {
+        ProtocolType type = ProtocolType::TCP;
+        int channel = -1;               // binary channel ID, -1 = none
+        bool shared = false;            // served by a shared listener
     };
 
+    bool ensureSharedListener(ProtocolType type, const QVariantMap& config);
+    void setRoute(const QString& componentId, ProtocolType type,
+                  const QVariantMap& config, bool shared);
+    void rebuildChannelRoutes();
+    static bool isGlobalKey(const QString& key);
+
     // "global" key "" holds the legacy shared handlers
     QMap<QString, HandlerEntry> m_handlers;
-};
 
-#include <QJsonArray>
+    HealthMessageParser m_parser;   // GUI-thread parser (direct ingest mode)
+
+    // Routing table, rebuilt on every (un)registration
+    ListenerMode           m_listenerMode = ListenerMode::PerComponent;
+    QHash<QString, Route>  m_routes;          // componentId → route
+    QHash<int, QString>    m_channelRoutes;   // channel ID → componentId
+    bool    m_dropUnrouted = false;
+    quint64 m_unrouted = 0;
+
+    QList<IngestWorker*> m_workers;
+    int      m_nextWorker = 0;
+    QTimer*  m_drainTimer;
+
+    // Instrumentation: one block per handler key, never freed before ~MessageServer
+    // (queued HealthUpdates may still point at the block of a removed handler)
+    QHash<QString, IngestStats*> m_stats;
+    QHash<QString, IngestStatsSnapshot> m_prevSnapshots;
+    QList<IngestStatsSnapshot> m_lastSnapshots;
+    QTimer* m_statsTimer;
+    qint64  m_lastSampleNs = 0;
+    QFile   m_statsDump;
+
+    FrameCaptureWriter m_recorder;          // written from handler threads
+    quint64 m_replayDropBaseline = 0;       // droppedUpdates() at replay start
+};
 
 #endif // MESSAGESERVER_H
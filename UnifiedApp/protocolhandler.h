@@ -6,6 +6,8 @@
 #include <QString>
 #include <QVariantMap>
 
+class IngestStats;
+
 /**
  * ProtocolType - Enumeration of supported communication protocols.
  * Each subsystem can independently use any protocol.
@@ -33,6 +35,11 @@ enum class ProtocolType {
  *   - stop()   : close it cleanly
  *   - isRunning() const
  *   - protocolName() const : human-readable tag for logs
+ *
+ * MessageServer attaches an IngestStats block (setStats) before start();
+ * handlers only report transport-level events there (e.g. oversized or
+ * truncated frames) – frame, byte and parse counters are kept by the
+ * parsing pipeline.
  */
 class ProtocolHandler : public QObject
 {
@@ -57,6 +64,10 @@ public:
     void setConfig(const QVariantMap& cfg) { m_config = cfg; }
     QVariantMap config() const { return m_config; }
 
+    /** Ingest counters for this handler (owned by MessageServer, may be null). */
+    void setStats(IngestStats* stats) { m_stats = stats; }
+    IngestStats* stats() const { return m_stats; }
+
     /** Utility: parse a ProtocolType from a string (case-insensitive). */
     static ProtocolType fromString(const QString& s);
     static QString toString(ProtocolType t);
@@ -68,6 +79,7 @@ signals:
 
 protected:
     QVariantMap m_config;
+    IngestStats* m_stats = nullptr;
 };
 
 #endif // PROTOCOLHANDLER_H
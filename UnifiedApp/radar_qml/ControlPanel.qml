@@ -9,6 +9,7 @@ import QtQuick.Layouts 1.15
  * Properties supplied by main.qml:
  *   dark, globalId, quadrant, localElem, cluster, localIdx
  *   cmdSender – CommandSender QObject*
+ *   receiver  – UdpReceiver QObject* (link quality; optional)
  * Signal: closeRequested()
  */
 Item {
@@ -22,6 +23,7 @@ Item {
     property int  localIdx:  0
     property var  cmdSender: null
     property var  model:     null     // RadarModel* passed from main.qml
+    property var  receiver:  null     // UdpReceiver* for the same antenna
 
     signal closeRequested()
 
@@ -68,6 +70,35 @@ Item {
     function fmtTmp(v) { return (!v || v <= -900) ? "—" : parseFloat(v).toFixed(1) + " °C"  }
     function fmtCur(v) { return (!v || v <= -900) ? "—" : parseFloat(v).toFixed(3) + " A"   }
 
+    // ── Link quality (bound to Q_PROPERTYs; only the age needs a clock) ──
+    property double now: Date.now()
+    Timer {
+        interval: 500; repeat: true; running: panel.visible
+        onTriggered: panel.now = Date.now()
+    }
+    function quadValue(list, fallback) {
+        return (list && quadrant < list.length) ? list[quadrant] : fallback
+    }
+    readonly property double quadUpdatedMs: model ? quadValue(model.quadrantUpdateTimes, 0) : 0
+    readonly property double quadAgeMs: quadUpdatedMs > 0 ? Math.max(0, now - quadUpdatedMs) : -1
+    readonly property double quadLoss:  receiver ? quadValue(receiver.quadrantLossPercent, 0) : 0
+    function fmtAge(ms) {
+        if (ms < 0)     return "never"
+        if (ms < 1000)  return Math.round(ms) + " ms"
+        return (ms / 1000).toFixed(1) + " s"
+    }
+    function ageCol(ms) {
+        var stale = model ? model.staleAfterMs : 0
+        if (ms < 0 || (stale > 0 && ms >= stale)) return critical
+        if (stale > 0 && ms >= stale / 2)         return warning2
+        return healthy
+    }
+    function lossCol(pct) {
+        if (pct >= 5) return critical
+        if (pct >= 1) return warning2
+        return healthy
+    }
+
     // ── Card ───────────────────────────────────────────────────────
     Rectangle {
         id: card
@@ -173,7 +204,7 @@ Item {
             ParamRow {
                 icon: "⚡"; label: "Forward Power"
                 value: panel.fmtPwr(panel.detail.power)
-                threshold: "threshold ≥ 43 dBm"
+                threshold: "threshold ≥ " + (panel.model ? panel.model.thresholds.powerWarn : 43) + " dBm"
                 statusColor: panel.stCol(panel.detail.powerStatus || 0)
                 width: parent.width
             }
@@ -182,7 +213,7 @@ Item {
             ParamRow {
                 icon: "🌡"; label: "Temperature"
                 value: panel.fmtTmp(panel.detail.temperature)
-                threshold: "threshold ≤ 50 °C"
+                threshold: "threshold ≤ " + (panel.model ? panel.model.thresholds.tempCrit : 50) + " °C"
                 statusColor: panel.stCol(panel.detail.tempStatus || 0)
                 width: parent.width
             }
@@ -191,7 +222,7 @@ Item {
             ParamRow {
                 icon: "⚡"; label: "Supply Current"
                 value: panel.fmtCur(panel.detail.current)
-                threshold: "threshold ≤ 2.0 A"
+                threshold: "threshold ≤ " + (panel.model ? panel.model.thresholds.currentCrit : 2.0).toFixed(1) + " A"
                 statusColor: panel.stCol(panel.detail.currStatus || 0)
                 width: parent.width
             }
@@ -200,6 +231,66 @@ Item {
             Rectangle { width: parent.width; height: 1; color: panel.border2; opacity: 0.6 }
             Item { height: 12 }
 
+            // ── Link quality ───────────────────────────────────────
+            Text {
+                text: "LINK QUALITY  ·  Q" + (panel.quadrant+1)
+                font { family: "Segoe UI"; pixelSize: 10; letterSpacing: 1.2 }
+                color: panel.dimCol
+            }
+            Item { height: 8 }
+
+            Row {
+                width: parent.width; spacing: 6
+                Repeater {
+                    model: [
+                        { label: "DATA AGE", value: panel.fmtAge(panel.quadAgeMs),
+                          color: panel.ageCol(panel.quadAgeMs) },
+                        { label: "LOSS",     value: panel.quadLoss.toFixed(2) + "%",
+                          color: panel.lossCol(panel.quadLoss) },
+                        { label: "REORDER",  value: "" + (panel.receiver ? panel.quadValue(panel.receiver.quadrantReordered, 0) : 0),
+                          color: panel.textCol },
+                        { label: "DUP",      value: "" + (panel.receiver ? panel.quadValue(panel.receiver.quadrantDuplicated, 0) : 0),
+                          color: panel.textCol }
+                    ]
+                    delegate: Rectangle {
+                        width: (parent.width - 18) / 4; height: 40; radius: 6
+                        color: panel.surface
+                        border { color: panel.border2; width: 1 }
+                        Column {
+                            anchors.centerIn: parent; spacing: 2
+                            Text {
+                                text: modelData.label
+                                font { family: "Segoe UI"; pixelSize: 9; letterSpacing: 0.8 }
+                                color: panel.dimCol
+                                anchors.horizontalCenter: parent.horizontalCenter
+                            }
+                            Text {
+                                text: modelData.value
+                                font { family: "Courier New"; pixelSize: 12; bold: true }
+                                color: modelData.color
+                                anchors.horizontalCenter: parent.horizontalCenter
+                            }
+                        }
+                    }
+                }
+            }
+            Item { height: 6 }
+            Text {
+                visible: panel.receiver !== null
+                text: panel.receiver
+                      ? "Antenna: loss " + panel.receiver.packetLossPercent.toFixed(2) + "%  ·  lost "
+                        + panel.receiver.packetsLost + "  ·  reordered " + panel.receiver.packetsReordered
+                        + "  ·  dup " + panel.receiver.packetsDuplicated
+                        + (panel.model ? "  ·  stale " + panel.model.staleDemotions : "")
+                      : ""
+                font { family: "Segoe UI"; pixelSize: 10 }
+                color: panel.dimCol
+            }
+
+            Item { height: 14 }
+            Rectangle { width: parent.width; height: 1; color: panel.border2; opacity: 0.6 }
+            Item { height: 12 }
+
             // ── Command buttons ────────────────────────────────────
             Text {
                 text: "SEND COMMAND"
@@ -2,6 +2,7 @@ import QtQuick 2.15
 import QtQuick.Window 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Vajra.Radar 1.0
 
 // Root item — embedded in QQuickWidget inside the Qt Widgets app.
 // All LCU / INU code has been removed; this shows Radar Antenna only.
@@ -36,10 +37,10 @@ Item {
 
     // ── Antenna selection ────────────────────────────────────────
     property int  currentAntenna: 0
-    property var  antennas:    [antenna0, antenna1]
-    property var  udpReceivers:[udpReceiver0, udpReceiver1]
-    property var  simulators:  [simulator0, simulator1]
-    property var  cmdSenders:  [cmdSender0, cmdSender1]
+    property var  antennas:    antennaModels
+    property var  udpReceivers:antennaReceivers
+    property var  simulators:  antennaSimulators
+    property var  cmdSenders:  antennaCmdSenders
     property var  model:       antennas[currentAntenna]
     property var  udpRecv:     udpReceivers[currentAntenna]
     property var  sim:         simulators[currentAntenna]
@@ -71,6 +72,7 @@ Item {
     property int  selCluster: -1
     property bool fullView:    false
     property bool analyticsOpen: false
+    property int  gridMetric:  ElementGrid.Status   // full-view cell colouring
 
     // ── Expand/Shrink state (LOD1 quadrant sizing) ───────────────
     property int  expandedQuad: -1
@@ -131,9 +133,12 @@ Item {
     function fmtPwr(v) { return (v === undefined || v <= -900) ? "—" : v.toFixed(1) + " dBm" }
     function fmtTmp(v) { return (v === undefined || v <= -900) ? "—" : v.toFixed(1) + " °C"  }
     function fmtCur(v) { return (v === undefined || v <= -900) ? "—" : v.toFixed(3) + " A"   }
-    function pwrStatus(v)  { if (v <= -900) return 0; if (v >= 43) return 1; if (v >= 40) return 2; return 3 }
-    function tmpStatus(v)  { if (v <= -900) return 0; if (v <= 45) return 1; if (v <= 50) return 2; return 3 }
-    function curStatus(v)  { if (v <= -900) return 0; if (v <= 1.8) return 1; if (v <= 2.0) return 2; return 3 }
+    // Status limits of the shown antenna (AntennaConfig thresholds)
+    property var  lim: model ? model.thresholds
+                             : ({ powerWarn:43, powerCrit:40, tempWarn:45, tempCrit:50, currentWarn:1.8, currentCrit:2.0 })
+    function pwrStatus(v)  { if (v <= -900) return 0; if (v >= lim.powerWarn)   return 1; if (v >= lim.powerCrit)   return 2; return 3 }
+    function tmpStatus(v)  { if (v <= -900) return 0; if (v <= lim.tempWarn)    return 1; if (v <= lim.tempCrit)    return 2; return 3 }
+    function curStatus(v)  { if (v <= -900) return 0; if (v <= lim.currentWarn) return 1; if (v <= lim.currentCrit) return 2; return 3 }
     function healthPct(v)  { return v < 0 ? "—" : v + "%" }
 
     // ── Hover state ──────────────────────────────────────────────
@@ -243,35 +248,44 @@ Item {
                 }
             }
 
-            // Antenna A / B sub-tabs
-            Row {
-                spacing: 0
-                Repeater {
-                    model: antennaCount
-                    delegate: Rectangle {
-                        width: antTxt.implicitWidth + 24; height: 32; radius: 4
-                        color: root.currentAntenna===index ? Qt.rgba(1,1,1,0.15) : "transparent"
-                        border { color: root.currentAntenna===index ? th.accent : "transparent"; width: 1 }
-                        Column {
-                            anchors.centerIn: parent; spacing: 0
-                            Text {
-                                id: antTxt
-                                text: index===0 ? "Antenna A" : "Antenna B"
-                                font { family:"Segoe UI"; pixelSize:12; bold: root.currentAntenna===index }
-                                color: root.currentAntenna===index ? th.accent : Qt.rgba(1,1,1,0.5)
-                                anchors.horizontalCenter: parent.horizontalCenter
+            // One sub-tab per configured antenna; scrolls when they do not fit
+            Flickable {
+                Layout.preferredWidth: antTabs.width
+                Layout.maximumWidth: 640
+                Layout.preferredHeight: 32
+                contentWidth: antTabs.width; contentHeight: 32
+                clip: true; interactive: contentWidth > width
+                flickableDirection: Flickable.HorizontalFlick
+                Row {
+                    id: antTabs
+                    spacing: 0
+                    Repeater {
+                        model: root.antennas
+                        delegate: Rectangle {
+                            width: antTxt.implicitWidth + 24; height: 32; radius: 4
+                            color: root.currentAntenna===index ? Qt.rgba(1,1,1,0.15) : "transparent"
+                            border { color: root.currentAntenna===index ? th.accent : "transparent"; width: 1 }
+                            Column {
+                                anchors.centerIn: parent; spacing: 0
+                                Text {
+                                    id: antTxt
+                                    text: modelData.antennaName
+                                    font { family:"Segoe UI"; pixelSize:12; bold: root.currentAntenna===index }
+                                    color: root.currentAntenna===index ? th.accent : Qt.rgba(1,1,1,0.5)
+                                    anchors.horizontalCenter: parent.horizontalCenter
+                                }
+                                Text {
+                                    text: modelData.totalElements + " elem"
+                                    font { family:"Segoe UI"; pixelSize:9 }
+                                    color: Qt.rgba(1,1,1,0.30)
+                                    anchors.horizontalCenter: parent.horizontalCenter
+                                }
                             }
-                            Text {
-                                text: index===0 ? "1024 elem" : "2048 elem"
-                                font { family:"Segoe UI"; pixelSize:9 }
-                                color: Qt.rgba(1,1,1,0.30)
-                                anchors.horizontalCenter: parent.horizontalCenter
+                            MouseArea {
+                                anchors.fill: parent; cursorShape: Qt.PointingHandCursor
+                                onClicked: root.switchAntenna(index)
                             }
                         }
-                        MouseArea {
-                            anchors.fill: parent; cursorShape: Qt.PointingHandCursor
-                            onClicked: root.switchAntenna(index)
-                        }
                     }
                 }
             }
@@ -828,14 +842,14 @@ Item {
                         var COLS=Math.ceil(Math.sqrt(EPCl))
                         var ROWS=Math.ceil(EPCl/COLS)
                         var pad=12,cw=width/COLS,ch=height/ROWS,r2=10
-                        var data=root.model.clusterData(root.selQuad,root.selCluster)
+                        var st=new Uint8Array(root.model.statusBuffer)
                         var base=root.selCluster*EPCl
 
                         for (var e=0;e<EPCl;e++) {
                             var gc=e%COLS,gr=Math.floor(e/COLS)
                             var x=gc*cw+pad,y=gr*ch+pad,w=cw-pad*2,h=ch-pad*2
-                            var v=data[e]
                             var gid=root.selQuad*root.model.elementsPerQuadrant+base+e
+                            var v=st[gid]
                             var hov=(gid===lod3Hov.hovGid)
 
                             ctx.fillStyle=root.healthColor(v); ctx.globalAlpha=hov?0.32:0.16
@@ -886,8 +900,7 @@ Item {
                         var e=Math.min(Math.floor(mouse.y/ch2)*COLS+Math.floor(mouse.x/cw2),EPCl-1)
                         var gid=root.selQuad*root.model.elementsPerQuadrant+root.selCluster*EPCl+e
                         if (gid!==hovGid){hovGid=gid;lod3Canvas.requestPaint()}
-                        var data=root.model.clusterData(root.selQuad,root.selCluster)
-                        root.setHoverElement(gid,data[e],mouse.x,mouse.y)
+                        root.setHoverElement(gid,root.model.elementStatus(gid),mouse.x,mouse.y)
                     }
                     onExited: { hovGid=-1; root.clearHover(); lod3Canvas.requestPaint() }
                     onClicked: {
@@ -908,6 +921,48 @@ Item {
                 transformOrigin:Item.Center
                 Behavior on opacity { NumberAnimation{duration:230;easing.type:Easing.InOutCubic} }
                 Behavior on scale   { NumberAnimation{duration:230;easing.type:Easing.InOutCubic} }
+                ElementGrid {
+                    id:allGrid
+                    x:0; y:0; width:parent.width-152-10; height:parent.height
+                    model: root.model
+                    columns: 16
+                    metric: root.gridMetric
+                    opacity: 0.82
+                    noDataColor: th.unknown; healthyColor: th.healthy
+                    warningColor: th.warning; criticalColor: th.critical
+                }
+                // Element ids only depend on the layout: repainted on resize / antenna switch
+                Canvas {
+                    id:allLabels; anchors.fill:allGrid
+                    property var gridModel: root.model
+                    onGridModelChanged: requestPaint()
+                    onWidthChanged: requestPaint()
+                    onHeightChanged: requestPaint()
+                    onPaint: {
+                        var ctx=getContext("2d"); ctx.clearRect(0,0,width,height)
+                        if (!root.model) return
+                        var EPQ=root.model.elementsPerQuadrant, Q=root.model.quadrantCount
+                        if (width/(allGrid.columns*2)<=18) return
+                        var cellW=width/(allGrid.columns*2)
+                        ctx.fillStyle="rgba(0,0,0,0.5)"
+                        ctx.font="bold "+Math.max(6,Math.round(cellW*0.26))+"px 'Segoe UI'"
+                        ctx.textAlign="center"
+                        for (var gid=0;gid<Q*EPQ;gid++){
+                            var r=allGrid.cellRect(gid)
+                            ctx.fillText(String(gid),r.x+r.width/2,r.y+r.height*0.65)
+                        }
+                        ctx.textAlign="left"
+                    }
+                }
+                Rectangle {
+                    readonly property rect cell: allHov.hovGid>=0 && allGrid.width>0 && allGrid.height>0
+                                                 ? allGrid.cellRect(allHov.hovGid) : Qt.rect(0,0,0,0)
+                    visible: allHov.hovGid>=0
+                    x: cell.x-1; y: cell.y-1; width: cell.width+2; height: cell.height+2
+                    color: "transparent"; border { color:"#ffffff"; width:2 }
+                }
+                // Separators, quadrant labels, legend and hover detail; repainted
+                // on stats / hover changes, never per element
                 Canvas {
                     id:allCanvas; anchors.fill:parent
                     onPaint: {
@@ -920,28 +975,6 @@ Item {
                         var totalCols=elemCols*2, totalRows=elemRows*2
                         var cellW=gridW/totalCols, cellH=gridH/totalRows
 
-                        for (var q=0;q<Q;q++){
-                            var qdata=root.model.quadrantData(q)
-                            var qCO=(q%2)*elemCols, qRO=Math.floor(q/2)*elemRows
-                            for (var e=0;e<EPQ;e++){
-                                var eC=e%elemCols,eR=Math.floor(e/elemCols)
-                                var gc2=qCO+eC,gr2=qRO+eR
-                                var gap=Math.max(0.5,Math.min(cellW,cellH)*0.08)
-                                var px=gc2*cellW+gap,py=gr2*cellH+gap
-                                var pw=cellW-gap*2,ph=cellH-gap*2
-                                var v=qdata[e],gid=q*EPQ+e
-                                var hov=(gid===allHov.hovGid)
-                                ctx.fillStyle=root.healthColor(v)
-                                ctx.globalAlpha=hov?1.0:0.82; ctx.fillRect(px,py,pw,ph); ctx.globalAlpha=1.0
-                                if (cellW>18) {
-                                    ctx.fillStyle="rgba(0,0,0,0.5)"
-                                    ctx.font="bold "+Math.max(6,Math.round(cellW*0.26))+"px 'Segoe UI'"
-                                    ctx.textAlign="center"
-                                    ctx.fillText(String(gid),px+pw/2,py+ph*0.65)
-                                }
-                                if (hov){ctx.strokeStyle="#fff";ctx.lineWidth=2;ctx.strokeRect(px-1,py-1,pw+2,ph+2)}
-                            }
-                        }
                         ctx.strokeStyle=root.darkTheme?"rgba(26,180,240,0.10)":"rgba(0,80,160,0.10)"
                         ctx.lineWidth=0.5
                         for (var cc=4;cc<totalCols;cc+=4){if(cc===totalCols/2)continue;ctx.beginPath();ctx.moveTo(cc*cellW,0);ctx.lineTo(cc*cellW,gridH);ctx.stroke()}
@@ -959,7 +992,8 @@ Item {
                         var lx=gridW+10
                         ctx.fillStyle=th.surface2; ctx.fillRect(lx,0,legendW,gridH)
                         ctx.strokeStyle=th.border; ctx.lineWidth=1; ctx.strokeRect(lx+0.5,0.5,legendW-1,gridH-1)
-                        ctx.fillStyle=th.accent; ctx.font="bold 11px 'Segoe UI'"; ctx.textAlign="left"; ctx.fillText("STATUS",lx+10,18)
+                        ctx.fillStyle=th.accent; ctx.font="bold 11px 'Segoe UI'"; ctx.textAlign="left"
+                        ctx.fillText(["STATUS","POWER","TEMPERATURE","CURRENT"][root.gridMetric],lx+10,18)
                         var bx4=lx+10,by4=28,bw4=20,bh4=16,bGap=6
                         var swatches=[[th.healthy,"HEALTHY"],[th.warning,"WARNING"],[th.critical,"CRITICAL"],[th.unknown,"NO DATA"]]
                         for(var si=0;si<4;si++){
@@ -975,12 +1009,12 @@ Item {
                         sy+=6; ctx.strokeStyle=th.border;ctx.beginPath();ctx.moveTo(lx+6,sy);ctx.lineTo(lx+legendW-6,sy);ctx.stroke(); sy+=10
                         ctx.fillStyle=th.accent;ctx.font="bold 9px 'Segoe UI'";ctx.fillText("THRESHOLDS",bx4,sy); sy+=12
                         ctx.fillStyle=th.textDim;ctx.font="9px 'Segoe UI'"
-                        ctx.fillText("Pwr  >=43 dBm",bx4,sy);sy+=12
-                        ctx.fillText("Temp <=50 deg C",bx4,sy);sy+=12
-                        ctx.fillText("Curr <=2.0 A",bx4,sy)
+                        ctx.fillText("Pwr  >="+root.lim.powerWarn+" dBm",bx4,sy);sy+=12
+                        ctx.fillText("Temp <="+root.lim.tempCrit+" deg C",bx4,sy);sy+=12
+                        ctx.fillText("Curr <="+root.lim.currentCrit.toFixed(1)+" A",bx4,sy)
                         if(allHov.hovGid>=0){
                             var hq2=Math.floor(allHov.hovGid/EPQ),he2=allHov.hovGid%EPQ
-                            var hvSt=root.model.quadrantData(hq2)[he2]
+                            var hvSt=root.model.elementStatus(allHov.hovGid)
                             var det=root.model.elementDetail(hq2,he2)
                             var detY=gridH-150
                             ctx.fillStyle=root.darkTheme?"#0a1a2e":"#e0eef8"
@@ -1007,35 +1041,54 @@ Item {
                     cursorShape: Qt.PointingHandCursor
                     onPositionChanged: {
                         if(!root.model) return
-                        var legendW=152,gridW=parent.width-legendW-10
-                        if(mouse.x>=gridW){if(hovGid!==-1){hovGid=-1;allCanvas.requestPaint();root.clearHover()};return}
-                        var EPQ=root.model.elementsPerQuadrant
-                        var elemCols=16,elemRows=EPQ/16
-                        var totalCols=elemCols*2,totalRows=elemRows*2
-                        var cellW=gridW/totalCols,cellH=parent.height/totalRows
-                        var gc2=Math.min(Math.floor(mouse.x/cellW),totalCols-1)
-                        var gr2=Math.min(Math.floor(mouse.y/cellH),totalRows-1)
-                        var q2=Math.floor(gr2/elemRows)*2+Math.floor(gc2/elemCols)
-                        var e2=(gr2%elemRows)*elemCols+(gc2%elemCols)
-                        var gid2=q2*EPQ+e2
+                        var gid2=allGrid.elementAt(mouse.x,mouse.y)
+                        if(gid2<0){if(hovGid!==-1){hovGid=-1;allCanvas.requestPaint();root.clearHover()};return}
                         if(gid2!==hovGid){hovGid=gid2;allCanvas.requestPaint()}
-                        root.setHoverElement(gid2,root.model.quadrantData(q2)[e2],mouse.x,mouse.y)
+                        root.setHoverElement(gid2,root.model.elementStatus(gid2),mouse.x,mouse.y)
                     }
                     onExited: { hovGid=-1; root.clearHover(); allCanvas.requestPaint() }
                     onClicked: {
                         if(!root.model) return
-                        var legendW=152,gridW=parent.width-legendW-10
-                        if(mouse.x>=gridW) return
+                        var gid2=allGrid.elementAt(mouse.x,mouse.y)
+                        if(gid2<0) return
                         var EPQ=root.model.elementsPerQuadrant
-                        var elemCols=16,elemRows=EPQ/16
-                        var totalCols=elemCols*2,totalRows=elemRows*2
-                        var cellW=gridW/totalCols,cellH=parent.height/totalRows
-                        var gc2=Math.min(Math.floor(mouse.x/cellW),totalCols-1)
-                        var gr2=Math.min(Math.floor(mouse.y/cellH),totalRows-1)
-                        var q2=Math.floor(gr2/elemRows)*2+Math.floor(gc2/elemCols)
-                        var e2=(gr2%elemRows)*elemCols+(gc2%elemCols)
-                        var gid2=q2*EPQ+e2
-                        root.openControlPanel(gid2, q2, e2)
+                        root.openControlPanel(gid2, Math.floor(gid2/EPQ), gid2%EPQ)
+                    }
+                }
+                // Colour-by selector (legend column)
+                Column {
+                    x: parent.width-152+10; y: 278; spacing: 4
+                    Text {
+                        text: "COLOUR BY"
+                        font { family:"Segoe UI"; pixelSize:9; bold:true }
+                        color: th.accent
+                    }
+                    Row {
+                        spacing: 3
+                        Repeater {
+                            model: [
+                                { lbl:"STS", m:ElementGrid.Status },
+                                { lbl:"PWR", m:ElementGrid.Power },
+                                { lbl:"TMP", m:ElementGrid.Temperature },
+                                { lbl:"CUR", m:ElementGrid.Current }
+                            ]
+                            delegate: Rectangle {
+                                property bool sel: root.gridMetric===modelData.m
+                                width: 30; height: 18; radius: 3
+                                color: sel ? Qt.rgba(0.1,0.7,1,0.25) : "transparent"
+                                border { color: sel ? th.accent : th.border; width:1 }
+                                Text {
+                                    anchors.centerIn: parent
+                                    text: modelData.lbl
+                                    font { family:"Segoe UI"; pixelSize:9; bold:true }
+                                    color: parent.sel ? th.accent : th.textDim
+                                }
+                                MouseArea {
+                                    anchors.fill: parent; cursorShape: Qt.PointingHandCursor
+                                    onClicked: { root.gridMetric=modelData.m; allCanvas.requestPaint() }
+                                }
+                            }
+                        }
                     }
                 }
             }
@@ -1146,19 +1199,19 @@ Item {
                     Text { text:"Power"; font.family:"Segoe UI"; font.pixelSize:11; color:Qt.rgba(1,1,1,0.42); width:76 }
                     Text { text:root.fmtPwr(parent.parent.det.power||-999); font.family:"Segoe UI"; font.pixelSize:11; font.bold:true; color:root.healthColor(parent.parent.det.powerStatus||0) }
                 }
-                Text { text:"   threshold >= 43 dBm"; font.family:"Segoe UI"; font.pixelSize:9; font.italic:true; color:Qt.rgba(1,1,1,0.28) }
+                Text { text:"   threshold >= "+root.lim.powerWarn+" dBm"; font.family:"Segoe UI"; font.pixelSize:9; font.italic:true; color:Qt.rgba(1,1,1,0.28) }
                 Item { height:4 }
                 Row { width:parent.width;height:22;spacing:0
                     Text { text:"Temp"; font.family:"Segoe UI"; font.pixelSize:11; color:Qt.rgba(1,1,1,0.42); width:76 }
                     Text { text:root.fmtTmp(parent.parent.det.temperature||-999); font.family:"Segoe UI"; font.pixelSize:11; font.bold:true; color:root.healthColor(parent.parent.det.tempStatus||0) }
                 }
-                Text { text:"   threshold <= 50 deg C"; font.family:"Segoe UI"; font.pixelSize:9; font.italic:true; color:Qt.rgba(1,1,1,0.28) }
+                Text { text:"   threshold <= "+root.lim.tempCrit+" deg C"; font.family:"Segoe UI"; font.pixelSize:9; font.italic:true; color:Qt.rgba(1,1,1,0.28) }
                 Item { height:4 }
                 Row { width:parent.width;height:22;spacing:0
                     Text { text:"Current"; font.family:"Segoe UI"; font.pixelSize:11; color:Qt.rgba(1,1,1,0.42); width:76 }
                     Text { text:root.fmtCur(parent.parent.det.current||-999); font.family:"Segoe UI"; font.pixelSize:11; font.bold:true; color:root.healthColor(parent.parent.det.currStatus||0) }
                 }
-                Text { text:"   threshold <= 2.0 A"; font.family:"Segoe UI"; font.pixelSize:9; font.italic:true; color:Qt.rgba(1,1,1,0.28) }
+                Text { text:"   threshold <= "+root.lim.currentCrit.toFixed(1)+" A"; font.family:"Segoe UI"; font.pixelSize:9; font.italic:true; color:Qt.rgba(1,1,1,0.28) }
                 Item { height:10 }
                 Rectangle {
                     height:26;radius:13;width:ttPill.implicitWidth+28
@@ -1202,6 +1255,7 @@ Item {
         localIdx:   root.cpLocalIdx
         cmdSender:  root.cmdSender
         model:      root.model
+        receiver:   root.udpRecv
 
         visible: opacity > 0
         onCloseRequested: root.closeControlPanel()
@@ -1276,31 +1330,15 @@ Item {
 
     // ── Data connections ─────────────────────────────────────────
     Connections {
-        target: antenna0
-        function onQuadrantUpdated(q) {
-            if (root.currentAntenna!==0) return
-            if (root.fullView)                              allCanvas.requestPaint()
-            else if (root.lodLevel===1)                     lod1Canvas.requestPaint()
-            else if (root.lodLevel===2&&root.selQuad===q)   lod2Canvas.requestPaint()
-            else if (root.lodLevel===3&&root.selQuad===q)   lod3Canvas.requestPaint()
-        }
-        function onStatsChanged() {
-            if (root.currentAntenna!==0) return
-            if (root.fullView||root.lodLevel===1) lod1Canvas.requestPaint()
-        }
-    }
-    Connections {
-        target: antenna1
-        function onQuadrantUpdated(q) {
-            if (root.currentAntenna!==1) return
-            if (root.fullView)                              allCanvas.requestPaint()
-            else if (root.lodLevel===1)                     lod1Canvas.requestPaint()
-            else if (root.lodLevel===2&&root.selQuad===q)   lod2Canvas.requestPaint()
-            else if (root.lodLevel===3&&root.selQuad===q)   lod3Canvas.requestPaint()
-        }
-        function onStatsChanged() {
-            if (root.currentAntenna!==1) return
-            if (root.fullView||root.lodLevel===1) lod1Canvas.requestPaint()
+        target: root.model
+        // One call per coalesced model frame of the shown antenna; allGrid
+        // tracks its own quadrants
+        function onFrameUpdated(mask) {
+            var selDirty = root.selQuad>=0 && (mask & (1<<Math.min(root.selQuad,31)))!==0
+            if (root.fullView)                      allCanvas.requestPaint()
+            else if (root.lodLevel===1)             lod1Canvas.requestPaint()
+            else if (root.lodLevel===2&&selDirty)   lod2Canvas.requestPaint()
+            else if (root.lodLevel===3&&selDirty)   lod3Canvas.requestPaint()
         }
     }
 }
@@ -1,5 +1,7 @@
 #include "radarantennawidget.h"
+#include "ElementGridItem.h"
 #include <QQmlContext>
+#include <QQmlEngine>
 #include <QVBoxLayout>
 #include <QUrl>
 
@@ -10,54 +12,82 @@ RadarAntennaWidget::RadarAntennaWidget(QWidget *parent)
     setupQmlEngine();
 }
 
+RadarAntennaWidget::~RadarAntennaWidget()
+{
+    // The view reads the models; receivers and model write sides may live
+    // on the ingest threads and are torn down there before they stop
+    delete m_qmlView;
+    for (const Antenna &a : m_antennas) delete a.receiver;
+    for (const Antenna &a : m_antennas) delete a.model;
+    for (QThread *t : m_ingestThreads) t->quit();
+    for (QThread *t : m_ingestThreads) t->wait();
+}
+
 void RadarAntennaWidget::setupModels()
 {
-    // ── Antenna A: 1024 elements (4 × 256) ──────────────────────
-    m_cfgA.name                = "Antenna A";
-    m_cfgA.quadrants           = 4;
-    m_cfgA.elementsPerQuadrant = 256;
-    m_cfgA.elementsPerCluster  = 16;
-    m_cfgA.udpPort             = 5005;
-
-    // ── Antenna B: 2048 elements (4 × 512) ──────────────────────
-    m_cfgB.name                = "Antenna B";
-    m_cfgB.quadrants           = 4;
-    m_cfgB.elementsPerQuadrant = 512;
-    m_cfgB.elementsPerCluster  = 16;
-    m_cfgB.udpPort             = 5006;
-
-    m_modelA     = new RadarModel(m_cfgA, this);
-    m_modelB     = new RadarModel(m_cfgB, this);
-
-    m_recvA      = new UdpReceiver(m_modelA, this);
-    m_recvB      = new UdpReceiver(m_modelB, this);
-
-    m_simA       = new SimulatorEngine(m_modelA, m_cfgA.udpPort, this);
-    m_simB       = new SimulatorEngine(m_modelB, m_cfgB.udpPort, this);
-
-    m_cmdSenderA = new CommandSender(m_cfgA, this);
-    m_cmdSenderB = new CommandSender(m_cfgB, this);
-
-    m_recvA->startListening(m_cfgA.udpPort);
-    m_recvB->startListening(m_cfgB.udpPort);
+    const AntennaSiteConfig site = AntennaSiteConfig::load();
+
+    // Shared ingest pool: threaded antennas are dealt out round-robin
+    const int threads = site.ingestThreadCount();
+    for (int i = 0; i < threads; ++i) {
+        QThread *t = new QThread(this);
+        t->setObjectName(QString("antenna-ingest-%1").arg(i));
+        t->start();
+        m_ingestThreads.append(t);
+    }
+
+    int next = 0;
+    m_antennas.reserve(site.antennas.size());
+    for (const AntennaConfig &cfg : site.antennas) {
+        Antenna a;
+        a.cfg       = cfg;
+        a.model     = new RadarModel(cfg, this);
+        a.receiver  = new UdpReceiver(a.model, this);
+        a.simulator = new SimulatorEngine(a.model, cfg.udpPort, this);
+        a.simulator->setMaxDatagramSize(cfg.maxDatagramBytes);
+
+        // In-process shortcut for delta loss recovery (external senders rely
+        // on their periodic keyframes)
+        connect(a.receiver, &UdpReceiver::keyframeRequested,
+                a.simulator, &SimulatorEngine::requestKeyframe);
+
+        a.cmdSender = new CommandSender(cfg, this);
+
+        if (cfg.ingestThread && !m_ingestThreads.isEmpty())
+            a.receiver->setIngestThread(m_ingestThreads[next++ % m_ingestThreads.size()]);
+
+        a.receiver->setReceiveBufferSize(cfg.udpRcvBufBytes);
+        a.receiver->startListening(cfg.udpPort);
+        m_antennas.append(a);
+    }
 }
 
 void RadarAntennaWidget::setupQmlEngine()
 {
+    // C++ items used by RadarAntennaView.qml (registered once per process)
+    static bool typesRegistered = false;
+    if (!typesRegistered) {
+        qmlRegisterType<ElementGridItem>("Vajra.Radar", 1, 0, "ElementGrid");
+        typesRegistered = true;
+    }
+
     m_qmlView = new QQuickWidget(this);
     m_qmlView->setResizeMode(QQuickWidget::SizeRootObjectToView);
 
-    // Expose C++ objects to QML
+    // Expose C++ objects to QML, one list entry per antenna
+    QVariantList models, receivers, simulators, cmdSenders;
+    for (const Antenna &a : m_antennas) {
+        models.append(QVariant::fromValue<QObject*>(a.model));
+        receivers.append(QVariant::fromValue<QObject*>(a.receiver));
+        simulators.append(QVariant::fromValue<QObject*>(a.simulator));
+        cmdSenders.append(QVariant::fromValue<QObject*>(a.cmdSender));
+    }
     QQmlContext *ctx = m_qmlView->rootContext();
-    ctx->setContextProperty("antenna0",     m_modelA);
-    ctx->setContextProperty("antenna1",     m_modelB);
-    ctx->setContextProperty("udpReceiver0", m_recvA);
-    ctx->setContextProperty("udpReceiver1", m_recvB);
-    ctx->setContextProperty("simulator0",   m_simA);
-    ctx->setContextProperty("simulator1",   m_simB);
-    ctx->setContextProperty("cmdSender0",   m_cmdSenderA);
-    ctx->setContextProperty("cmdSender1",   m_cmdSenderB);
-    ctx->setContextProperty("antennaCount", 2);
+    ctx->setContextProperty("antennaModels",     models);
+    ctx->setContextProperty("antennaReceivers",  receivers);
+    ctx->setContextProperty("antennaSimulators", simulators);
+    ctx->setContextProperty("antennaCmdSenders", cmdSenders);
+    ctx->setContextProperty("antennaCount",      m_antennas.size());
 
     m_qmlView->setSource(QUrl("qrc:/radar_qml/RadarAntennaView.qml"));
 
@@ -69,17 +99,15 @@ void RadarAntennaWidget::setupQmlEngine()
 
 void RadarAntennaWidget::startSimulator()
 {
-    if (m_simA) m_simA->start();
-    if (m_simB) m_simB->start();
+    for (const Antenna &a : m_antennas) a.simulator->start();
 }
 
 void RadarAntennaWidget::stopSimulator()
 {
-    if (m_simA) m_simA->stop();
-    if (m_simB) m_simB->stop();
+    for (const Antenna &a : m_antennas) a.simulator->stop();
 }
 
 bool RadarAntennaWidget::isListening() const
 {
-    return m_recvA && m_recvA->listening();
+    return !m_antennas.isEmpty() && m_antennas.first().receiver->listening();
 }
@@ -4,6 +4,8 @@
 #include <QWidget>
 #include <QQuickWidget>
 #include <QVBoxLayout>
+#include <QThread>
+#include <QVector>
 #include "AntennaConfig.h"
 #include "RadarModel.h"
 #include "UdpReceiver.h"
@@ -15,48 +17,53 @@
  *
  * Hosts the radar antenna QML monitor UI inside a Qt Widgets container.
  *
- * Two antenna configurations are supported:
+ * The antennas come from antennas.json (see AntennaSiteConfig); the
+ * built-in copy defines
  *   Antenna A – 1024 elements (4 × 256), UDP 5005
  *   Antenna B – 2048 elements (4 × 512), UDP 5006
  *
  * Each antenna has its own RadarModel, UdpReceiver, SimulatorEngine
  * and CommandSender.  The QML view receives these objects via the
- * QQuickWidget root context.
+ * QQuickWidget root context as the lists antennaModels, antennaReceivers,
+ * antennaSimulators and antennaCmdSenders (index = antenna), plus
+ * antennaCount.
+ *
+ * Antennas with AntennaConfig::ingestThread set decode their datagrams and
+ * write their model on a small pool of ingest threads shared round-robin
+ * (AntennaSiteConfig::ingestThreads); the view reads the published
+ * snapshots (see RadarModel).
  */
 class RadarAntennaWidget : public QWidget
 {
     Q_OBJECT
 public:
     explicit RadarAntennaWidget(QWidget *parent = nullptr);
-    ~RadarAntennaWidget() override = default;
+    ~RadarAntennaWidget() override;
 
     /** Start/stop the built-in simulator for testing without live hardware. */
     void startSimulator();
     void stopSimulator();
 
-    /** Returns true if the UDP receiver for the currently selected antenna
-     *  is bound and listening. */
+    /** Returns true if the UDP receiver of the first antenna is bound
+     *  and listening. */
     bool isListening() const;
 
 private:
     void setupModels();
     void setupQmlEngine();
 
-    // ── Antenna A ─────────────────────────────────────────────────
-    AntennaConfig    m_cfgA;
-    RadarModel      *m_modelA      = nullptr;
-    UdpReceiver     *m_recvA       = nullptr;
-    SimulatorEngine *m_simA        = nullptr;
-    CommandSender   *m_cmdSenderA  = nullptr;
-
-    // ── Antenna B ─────────────────────────────────────────────────
-    AntennaConfig    m_cfgB;
-    RadarModel      *m_modelB      = nullptr;
-    UdpReceiver     *m_recvB       = nullptr;
-    SimulatorEngine *m_simB        = nullptr;
-    CommandSender   *m_cmdSenderB  = nullptr;
-
-    QQuickWidget    *m_qmlView     = nullptr;
+    // ── One monitored antenna ─────────────────────────────────────
+    struct Antenna {
+        AntennaConfig    cfg;
+        RadarModel      *model     = nullptr;
+        UdpReceiver     *receiver  = nullptr;
+        SimulatorEngine *simulator = nullptr;
+        CommandSender   *cmdSender = nullptr;
+    };
+
+    QVector<Antenna>    m_antennas;
+    QVector<QThread*>   m_ingestThreads;
+    QQuickWidget       *m_qmlView = nullptr;
 };
 
 #endif // RADARANTENNAWIDGET_H
@@ -0,0 +1,49 @@
+#include "replayprotocolhandler.h"
+#include <QDebug>
+
+ReplayProtocolHandler::ReplayProtocolHandler(QObject* parent)
+    : ProtocolHandler(parent)
+{}
+
+ReplayProtocolHandler::~ReplayProtocolHandler()
+{
+    stop();
+}
+
+bool ReplayProtocolHandler::start()
+{
+    if (m_replayer) return true;
+
+    // Created here so the replayer's timer lives on the handler's thread
+    m_replayer = new FrameReplayer(this);
+    if (!m_replayer->open(m_config.value("file").toString())) {
+        delete m_replayer;
+        m_replayer = nullptr;
+        return false;
+    }
+    m_replayer->setSpeed(m_config.value("speed", 1.0).toDouble());
+    m_replayer->setSourceFilter(m_config.value("sources").toStringList());
+    // frame views the mapped file, which stop() unmaps: receivers get a copy
+    m_replayer->setConsumer([this](int, const QByteArray& frame) {
+        emit dataReceived(QByteArray(frame.constData(), frame.size()));
+    });
+    connect(m_replayer, &FrameReplayer::finished, this, &ReplayProtocolHandler::finished);
+
+    emit connected();
+    m_replayer->start();
+    return true;
+}
+
+void ReplayProtocolHandler::stop()
+{
+    if (!m_replayer) return;
+    m_replayer->stop();
+    delete m_replayer;
+    m_replayer = nullptr;
+    emit disconnected();
+}
+
+bool ReplayProtocolHandler::isRunning() const
+{
+    return m_replayer && m_replayer->isRunning();
+}
@@ -0,0 +1,43 @@
+#ifndef REPLAYPROTOCOLHANDLER_H
+#define REPLAYPROTOCOLHANDLER_H
+
+#include "protocolhandler.h"
+#include "framecapture.h"
+
+/**
+ * ReplayProtocolHandler - Plays a frame capture (see framecapture.h) back
+ * through dataReceived(), so replayed frames take exactly the path live
+ * frames take: MessageServer attaches it like any other handler (on the GUI
+ * thread or an ingest worker) and parses whatever it emits.
+ *
+ * Config keys:
+ *   file    (string, required) – capture file written by FrameCaptureWriter
+ *   speed   (double, optional) – 1.0 = original timing (default), N = N× faster,
+ *                                0 = as fast as possible
+ *   sources (string list, optional) – only replay these source tags
+ *
+ * Frames are read from the memory-mapped capture and emitted as copies, like
+ * the TCP/UDP handlers' frames: stop() unmaps the file while queued or
+ * storing receivers may still hold them.
+ */
+class ReplayProtocolHandler : public ProtocolHandler
+{
+    Q_OBJECT
+public:
+    explicit ReplayProtocolHandler(QObject* parent = nullptr);
+    ~ReplayProtocolHandler() override;
+
+    bool start() override;
+    void stop() override;
+    bool isRunning() const override;
+    QString protocolName() const override { return "Replay"; }
+
+signals:
+    /** Playback ended (completed or stopped); emitted on the handler's thread. */
+    void finished(const ReplayReport& report);
+
+private:
+    FrameReplayer* m_replayer = nullptr;
+};
+
+#endif // REPLAYPROTOCOLHANDLER_H
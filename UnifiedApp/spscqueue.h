@@ -0,0 +1,86 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * SpscQueue – Bounded, lock-free single-producer / single-consumer ring.
+ *
+ * Used to hand decoded HealthUpdates from one ingest worker thread to the
+ * GUI thread. Exactly one thread may call push() and exactly one (other)
+ * thread may call pop(); no mutex is taken on either side.
+ *
+ * Capacity is rounded up to the next power of two. push() fails instead of
+ * blocking when the ring is full so a stalled consumer can never back up
+ * into the socket threads.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity = 4096)
+        : m_slots(roundUp(capacity))
+        , m_mask(m_slots.size() - 1)
+    {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return m_slots.size(); }
+
+    // ── Producer side ─────────────────────────────────────────────
+    bool push(T&& value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size())
+            return false;
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& value)
+    {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    // ── Consumer side ─────────────────────────────────────────────
+    bool pop(T& out)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+        out = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T();   // release implicitly-shared payloads now
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Number of queued items; exact only when called by the consumer. */
+    std::size_t sizeApprox() const
+    {
+        return m_tail.load(std::memory_order_acquire)
+             - m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    static std::size_t roundUp(std::size_t n)
+    {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::vector<T>    m_slots;
+    const std::size_t m_mask;
+
+    // Head (consumer) and tail (producer) on separate cache lines
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+#endif // SPSCQUEUE_H
@@ -1,6 +1,20 @@
 #include "tcpprotocolhandler.h"
 #include <QHostAddress>
 #include <QDebug>
+#include <cstring>
+#include "binaryhealthframe.h"
+#include "ingeststats.h"
+
+namespace {
+const int kLengthPrefixSize = 4;
+const int kInitialBufferSize = 64 * 1024;
+
+inline quint32 readU32(const char* p)
+{
+    const uchar* u = reinterpret_cast<const uchar*>(p);
+    return quint32(u[0]) | (quint32(u[1]) << 8) | (quint32(u[2]) << 16) | (quint32(u[3]) << 24);
+}
+}
 
 TcpProtocolHandler::TcpProtocolHandler(QObject* parent)
     : ProtocolHandler(parent)
@@ -24,12 +38,17 @@ bool TcpProtocolHandler::start()
 
     QHostAddress addr(host == "0.0.0.0" ? QHostAddress::Any : QHostAddress(host));
 
+    m_lengthPrefixed = m_config.value("framing", "line").toString().toLower() == "length_prefixed";
+    m_maxFrameBytes  = static_cast<quint32>(qMax(1, m_config.value("max_frame_bytes",
+                                                                    4 * 1024 * 1024).toInt()));
+
     if (!m_server->listen(addr, port)) {
         qWarning() << "[TCP] Failed to listen on" << host << ":" << port
                    << "-" << m_server->errorString();
         return false;
     }
-    qDebug() << "[TCP] Listening on port" << port;
+    qDebug() << "[TCP] Listening on port" << port
+             << (m_lengthPrefixed ? "(length-prefixed framing)" : "(line framing)");
     emit connected();
     return true;
 }
@@ -41,6 +60,7 @@ void TcpProtocolHandler::stop()
         s->deleteLater();
     }
     m_clients.clear();
+    m_buffers.clear();
 
     if (m_server->isListening()) {
         m_server->close();
@@ -67,10 +87,85 @@ void TcpProtocolHandler::onReadyRead()
 {
     QTcpSocket* client = qobject_cast<QTcpSocket*>(sender());
     if (!client) return;
-    while (client->canReadLine()) {
+    if (m_lengthPrefixed)
+        readLengthPrefixed(client);
+    else
+        readLines(client);
+}
+
+void TcpProtocolHandler::readLines(QTcpSocket* client)
+{
+    quint64 skipped = 0;
+    for (;;) {
+        // Binary health frames carry their own length; JSON is line-delimited
+        char head[BinaryHealthFrame::HeaderSize];
+        qint64 peeked = client->peek(head, sizeof(head));
+        if (peeked > 0 && static_cast<quint8>(head[0]) == BinaryHealthFrame::Magic) {
+            quint32 len = BinaryHealthFrame::frameLength(head, peeked);
+            if (peeked < BinaryHealthFrame::HeaderSize) break;
+            if (len < quint32(BinaryHealthFrame::HeaderSize)
+                    || len > BinaryHealthFrame::MaxFrameSize) {
+                client->read(1);   // corrupt header: resynchronise
+                ++skipped;
+                continue;
+            }
+            if (client->bytesAvailable() < len) break;
+            emit dataReceived(client->read(len));
+            continue;
+        }
+        if (!client->canReadLine()) break;
         QByteArray line = client->readLine().trimmed();
         if (!line.isEmpty()) emit dataReceived(line);
     }
+    if (skipped > 0 && m_stats) m_stats->addResyncBytes(skipped);
+}
+
+void TcpProtocolHandler::readLengthPrefixed(QTcpSocket* client)
+{
+    ClientBuffer& cb = m_buffers[client];
+    if (cb.data.isEmpty()) cb.data.resize(kInitialBufferSize);
+
+    while (client->bytesAvailable() > 0) {
+        // Read directly into the free tail of the reusable buffer
+        int room = cb.data.size() - cb.fill;
+        if (room == 0) {
+            cb.data.resize(cb.data.size() * 2);
+            room = cb.data.size() - cb.fill;
+        }
+        qint64 n = client->read(cb.data.data() + cb.fill, room);
+        if (n <= 0) break;
+        cb.fill += static_cast<int>(n);
+
+        // Emit every complete frame; the buffer is reused, so receivers get a copy
+        const char* base = cb.data.constData();
+        int off = 0;
+        while (cb.fill - off >= kLengthPrefixSize) {
+            quint32 len = readU32(base + off);
+            if (len > m_maxFrameBytes) {
+                qWarning() << "[TCP] Oversized frame (" << len << "bytes) from"
+                           << client->peerAddress().toString() << "- dropping client";
+                if (m_stats) m_stats->addOversized();
+                cb.fill = 0;
+                client->abort();
+                return;
+            }
+            if (quint32(cb.fill - off - kLengthPrefixSize) < len) break;
+            if (len > 0)
+                emit dataReceived(QByteArray(base + off + kLengthPrefixSize,
+                                             static_cast<int>(len)));
+            off += kLengthPrefixSize + static_cast<int>(len);
+        }
+
+        // Keep the partial tail at the front; make room for a large pending frame
+        if (off > 0) {
+            std::memmove(cb.data.data(), cb.data.constData() + off, cb.fill - off);
+            cb.fill -= off;
+        }
+        if (cb.fill >= kLengthPrefixSize) {
+            int needed = kLengthPrefixSize + static_cast<int>(readU32(cb.data.constData()));
+            if (needed > cb.data.size()) cb.data.resize(needed);
+        }
+    }
 }
 
 void TcpProtocolHandler::onDisconnected()
@@ -79,5 +174,6 @@ void TcpProtocolHandler::onDisconnected()
     if (!client) return;
     qDebug() << "[TCP] Client disconnected:" << client->peerAddress().toString();
     m_clients.removeAll(client);
+    m_buffers.remove(client);
     client->deleteLater();
 }
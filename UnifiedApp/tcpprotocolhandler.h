@@ -5,14 +5,28 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QList>
+#include <QHash>
 
 /**
  * TcpProtocolHandler - TCP server that accepts any number of client connections.
- * Each line-terminated JSON message emits dataReceived().
+ * Each line-terminated JSON message emits dataReceived(). Binary health
+ * frames (BinaryHealthFrame, magic 0xB5) are delimited by the length field
+ * in their header and may be interleaved with JSON lines on one connection.
  *
  * Config keys:
- *   port  (int, required) – TCP listen port
- *   host  (string, optional) – bind address, default "0.0.0.0"
+ *   port     (int, required) – TCP listen port
+ *   host     (string, optional) – bind address, default "0.0.0.0"
+ *   framing  (string, optional) – "line" (default) or "length_prefixed"
+ *   max_frame_bytes (int, optional) – largest accepted length-prefixed
+ *                                     frame, default 4 MiB
+ *
+ * Length-prefixed framing: every frame is a u32 little-endian payload
+ * length followed by the payload (JSON or a binary health frame). Bytes are
+ * read straight into a per-client buffer that is reused across reads, so
+ * there is no per-read allocation. dataReceived() is a public signal with
+ * queued and storing receivers (capture, cross-thread handlers), so each
+ * frame is emitted as its own copy of the payload, never as a view into
+ * that buffer.
  */
 class TcpProtocolHandler : public ProtocolHandler
 {
@@ -32,8 +46,19 @@ private slots:
     void onDisconnected();
 
 private:
+    void readLines(QTcpSocket* client);
+    void readLengthPrefixed(QTcpSocket* client);
+
+    struct ClientBuffer {
+        QByteArray data;    // reusable receive buffer; grows to the largest frame
+        int        fill = 0;
+    };
+
     QTcpServer* m_server;
     QList<QTcpSocket*> m_clients;
+    QHash<QTcpSocket*, ClientBuffer> m_buffers;   // length-prefixed mode only
+    bool    m_lengthPrefixed = false;
+    quint32 m_maxFrameBytes  = 4u * 1024u * 1024u;
 };
 
 #endif // TCPPROTOCOLHANDLER_H
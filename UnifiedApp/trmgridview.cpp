@@ -332,31 +332,24 @@ void TrmGridView::reset()
     updateStatusCounts();
 }
 
-void TrmGridView::updateTrmData(const QJsonArray& trmArray)
+void TrmGridView::updateTrmData(const TrmRecordList& trms)
 {
-    for (const QJsonValue& v : trmArray) {
-        QJsonObject obj = v.toObject();
-        int id = obj["id"].toInt(-1);
-        if (id < 0 || id >= m_cells.size()) continue;
-
-        TrmCell::TrmData d;
-        d.id = id;
-        d.health = obj["health"].toDouble(100.0);
-        d.color = obj["color"].toString("#00FF00");
-        d.status = obj["status"].toString("HEALTHY");
-        d.voltage = obj["voltage"].toDouble(0.0);
-        d.current = obj["current"].toDouble(0.0);
-        d.on = obj["on"].toBool(true);
-        d.trip = obj["trip"].toString("Normal");
-        d.bit = obj["bit"].toString("Normal");
-        d.quadrant = obj["quadrant"].toInt(-1);
-        d.channel = obj["channel"].toInt(-1);
-
-        m_cells[id]->setData(d);
+    for (const TrmRecord& d : trms) {
+        if (d.id < 0 || d.id >= m_cells.size()) continue;
+        m_cells[d.id]->setData(d);
     }
     updateStatusCounts();
 }
 
+void TrmGridView::updateTrmData(const QJsonArray& trmArray)
+{
+    TrmRecordList trms;
+    trms.reserve(trmArray.size());
+    for (const QJsonValue& v : trmArray)
+        trms.append(TrmRecord::fromJson(v.toObject()));
+    updateTrmData(trms);
+}
+
 void TrmGridView::updateTrm(int id, const TrmCell::TrmData& data)
 {
     if (id < 0 || id >= m_cells.size()) return;
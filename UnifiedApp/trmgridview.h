@@ -15,6 +15,7 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QToolTip>
+#include "trmrecord.h"
 
 /**
  * TrmCell – A single TRM element cell in the grid.
@@ -31,19 +32,7 @@ class TrmCell : public QWidget
 {
     Q_OBJECT
 public:
-    struct TrmData {
-        int id = 0;
-        double health = 100.0;
-        QString color = "#00FF00";
-        QString status = "HEALTHY";
-        double voltage = 0.0;
-        double current = 0.0;
-        bool on = true;
-        QString trip = "Normal";
-        QString bit = "Normal";
-        int quadrant = -1;
-        int channel = -1;
-    };
+    typedef TrmRecord TrmData;
 
     explicit TrmCell(int trmId, QWidget* parent = nullptr);
 
@@ -119,7 +108,7 @@ private:
  * Usage:
  *   TrmGridView* grid = new TrmGridView(this);
  *   grid->setTrmCount(271, 16);  // 271 TRMs, 16 columns
- *   grid->updateTrmData(jsonArray);  // from trmDataReceived signal
+ *   grid->updateTrmData(trms);       // from trmDataReceived signal
  */
 class TrmGridView : public QWidget
 {
@@ -131,7 +120,10 @@ public:
     /** Configure grid dimensions. Must be called before first updateTrmData(). */
     void setTrmCount(int count, int columns = 16);
 
-    /** Update all TRM cells from a JSON array (from MessageServer::trmDataReceived). */
+    /** Update all TRM cells from decoded records (from MessageServer::trmDataReceived). */
+    void updateTrmData(const TrmRecordList& trms);
+
+    /** Update all TRM cells from a raw "trm_data" JSON array. */
     void updateTrmData(const QJsonArray& trmArray);
 
     /** Update a single TRM cell directly. */
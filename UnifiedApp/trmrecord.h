@@ -0,0 +1,53 @@
+#ifndef TRMRECORD_H
+#define TRMRECORD_H
+
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+#include <QMetaType>
+
+/**
+ * TrmRecord – Typed state of one Transmitter-Receiver Module.
+ *
+ * Produced directly by the health decoders (JSON and binary) and consumed by
+ * TrmGridView, so TRM grids no longer travel through the UI as QJsonArray.
+ * Field names and defaults match the "trm_data" entries of the JSON protocol.
+ */
+struct TrmRecord {
+    int     id = 0;
+    double  health = 100.0;
+    QString color = QStringLiteral("#00FF00");
+    QString status = QStringLiteral("HEALTHY");
+    double  voltage = 0.0;
+    double  current = 0.0;
+    bool    on = true;
+    QString trip = QStringLiteral("Normal");
+    QString bit = QStringLiteral("Normal");
+    int     quadrant = -1;
+    int     channel = -1;
+
+    /** Build from one "trm_data" JSON object; id is -1 if missing. */
+    static TrmRecord fromJson(const QJsonObject& obj)
+    {
+        TrmRecord d;
+        d.id       = obj["id"].toInt(-1);
+        d.health   = obj["health"].toDouble(100.0);
+        d.color    = obj["color"].toString(d.color);
+        d.status   = obj["status"].toString(d.status);
+        d.voltage  = obj["voltage"].toDouble(0.0);
+        d.current  = obj["current"].toDouble(0.0);
+        d.on       = obj["on"].toBool(true);
+        d.trip     = obj["trip"].toString(d.trip);
+        d.bit      = obj["bit"].toString(d.bit);
+        d.quadrant = obj["quadrant"].toInt(-1);
+        d.channel  = obj["channel"].toInt(-1);
+        return d;
+    }
+};
+
+typedef QVector<TrmRecord> TrmRecordList;
+
+Q_DECLARE_METATYPE(TrmRecord)
+Q_DECLARE_METATYPE(TrmRecordList)
+
+#endif // TRMRECORD_H
@@ -1,11 +1,15 @@
 #include "udpprotocolhandler.h"
 #include <QHostAddress>
-#include <QNetworkDatagram>
 #include <QDebug>
+#include <cctype>
+#include "binaryhealthframe.h"
+#include "datagrambatchreader.h"
+#include "ingeststats.h"
 
 UdpProtocolHandler::UdpProtocolHandler(QObject* parent)
     : ProtocolHandler(parent)
     , m_socket(nullptr)
+    , m_reader(nullptr)
 {}
 
 UdpProtocolHandler::~UdpProtocolHandler()
@@ -30,8 +34,16 @@ bool UdpProtocolHandler::start()
         m_socket = nullptr;
         return false;
     }
-    connect(m_socket, &QUdpSocket::readyRead, this, &UdpProtocolHandler::onReadyRead);
-    qDebug() << "[UDP] Bound on port" << port;
+
+    m_reader = new DatagramBatchReader(m_socket,
+                                       m_config.value("batch_size", 32).toInt(),
+                                       m_config.value("max_datagram", 65536).toInt(),
+                                       this);
+    m_reader->setReceiveBufferSize(m_config.value("rcvbuf_bytes", 0).toInt());
+    connect(m_reader, &DatagramBatchReader::readyRead, this, &UdpProtocolHandler::onReadyRead);
+    qDebug() << "[UDP] Bound on port" << port
+             << (m_reader->isBatched() ? "(batched)" : "")
+             << "rcvbuf" << m_reader->receiveBufferSize();
     emit connected();
     return true;
 }
@@ -39,6 +51,10 @@ bool UdpProtocolHandler::start()
 void UdpProtocolHandler::stop()
 {
     if (m_socket) {
+        delete m_reader;
+        m_reader = nullptr;
+        m_reportedTruncated = 0;
+        m_reportedDrops = 0;
         m_socket->close();
         delete m_socket;
         m_socket = nullptr;
@@ -53,9 +69,26 @@ bool UdpProtocolHandler::isRunning() const
 
 void UdpProtocolHandler::onReadyRead()
 {
-    while (m_socket && m_socket->hasPendingDatagrams()) {
-        QNetworkDatagram dg = m_socket->receiveDatagram();
-        QByteArray data = dg.data().trimmed();
-        if (!data.isEmpty()) emit dataReceived(data);
-    }
+    if (!m_reader) return;
+    m_reader->drain([this](const char* p, int len) {
+        // Binary frames are length-delimited; trimming could eat payload bytes
+        if (len > 0 && static_cast<quint8>(p[0]) != BinaryHealthFrame::Magic) {
+            while (len > 0 && isspace(static_cast<uchar>(p[0])))       { ++p; --len; }
+            while (len > 0 && isspace(static_cast<uchar>(p[len - 1]))) { --len; }
+        }
+        // The slot is reused by the next batch: receivers get their own copy
+        if (len > 0) emit dataReceived(QByteArray(p, len));
+    });
+
+    // Datagrams larger than max_datagram were discarded by the reader
+    quint64 truncated = m_reader->truncatedDatagrams();
+    if (m_stats && truncated > m_reportedTruncated)
+        m_stats->addOversized(truncated - m_reportedTruncated);
+    m_reportedTruncated = truncated;
+
+    // The reader's kernel drop count is cumulative for the socket
+    quint64 drops = m_reader->kernelDrops();
+    if (m_stats && drops > m_reportedDrops)
+        m_stats->addKernelDrops(drops - m_reportedDrops);
+    m_reportedDrops = drops;
 }
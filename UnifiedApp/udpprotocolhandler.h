@@ -4,13 +4,26 @@
 #include "protocolhandler.h"
 #include <QUdpSocket>
 
+class DatagramBatchReader;
+
 /**
  * UdpProtocolHandler - UDP datagram receiver.
- * Each received datagram is emitted as dataReceived().
+ * Each received datagram is emitted as dataReceived(); JSON datagrams are
+ * whitespace-trimmed, binary health frames are passed through untouched.
+ *
+ * Datagrams are drained in batches through DatagramBatchReader (recvmmsg on
+ * Linux) into a reused slab; each datagram is copied out of its slot when
+ * emitted, since dataReceived() receivers may queue or keep the bytes.
  *
  * Config keys:
- *   port  (int, required) – UDP bind port
- *   host  (string, optional) – bind address, default "0.0.0.0"
+ *   port          (int, required) – UDP bind port
+ *   host          (string, optional) – bind address, default "0.0.0.0"
+ *   batch_size    (int, optional) – datagrams per recvmmsg call, default 32
+ *   max_datagram  (int, optional) – slab slot size in bytes, default 65536
+ *   rcvbuf_bytes  (int, optional) – requested SO_RCVBUF, default kernel default
+ *
+ * Datagrams the kernel dropped on the socket (receive buffer full, where the
+ * platform reports it) are added to the handler's IngestStats kernel drops.
  */
 class UdpProtocolHandler : public ProtocolHandler
 {
@@ -28,7 +41,10 @@ private slots:
     void onReadyRead();
 
 private:
-    QUdpSocket* m_socket;
+    QUdpSocket*          m_socket;
+    DatagramBatchReader* m_reader;
+    quint64              m_reportedTruncated = 0;   // already added to m_stats
+    quint64              m_reportedDrops = 0;       // kernel drops already added to m_stats
 };
 
 #endif // UDPPROTOCOLHANDLER_H
@@ -0,0 +1,351 @@
+#include "benchharness.h"
+#include "RadarModel.h"
+#include "UdpReceiver.h"
+
+/*
+ * Radar antenna hot paths at 271, 2048 and 65536 elements:
+ *   antenna_decode  UdpReceiver decode of 0x10 / 0x11 / 0x12 packets, of
+ *                   a 0x13 delta touching ~1% of the elements and of a
+ *                   full frame as MTU-sized 0x15 chunks, into the model
+ *                   (includes the model update it triggers)
+ *   radar_model     status classification, setAllQuadrants, setElement,
+ *                   worstElements(By), the per-quadrant / per-cluster metric
+ *                   and stats queries QML polls, and recording / querying
+ *                   the per-element history (120 samples deep)
+ *
+ * Element values are spread over all three health bands so classification
+ * and the worst-element sort see a realistic mix.
+ */
+
+namespace {
+
+struct Geometry { const char* label; int quadrants; int epq; };
+
+const Geometry kGeometries[] = {
+    { "271",   1, 271   },
+    { "2048",  4, 512   },
+    { "65536", 4, 16384 },
+};
+
+struct Lcg {
+    quint32 state = 2024;
+    quint32 next() { state = state * 1664525u + 1013904223u; return state >> 8; }
+    quint16 range(quint16 lo, quint16 hi) { return quint16(lo + next() % quint32(hi - lo + 1)); }
+};
+
+// Wire encoding as in UdpReceiver.h; ~90% healthy, ~7% warning, ~3% critical
+void writeElement(Lcg& rng, uchar* p)
+{
+    const quint32 roll = rng.next() % 100;
+    quint16 pwr, tmp, cur;
+    if (roll < 90)      { pwr = rng.range(5300, 6000); tmp = rng.range(300, 440); cur = rng.range(1200, 1750); }
+    else if (roll < 97) { pwr = rng.range(5000, 5290); tmp = rng.range(460, 495); cur = rng.range(1810, 1990); }
+    else                { pwr = rng.range(3000, 4900); tmp = rng.range(510, 700); cur = rng.range(2010, 2500); }
+    p[0] = uchar(pwr); p[1] = uchar(pwr >> 8);
+    p[2] = uchar(tmp); p[3] = uchar(tmp >> 8);
+    p[4] = uchar(cur); p[5] = uchar(cur >> 8);
+}
+
+QByteArray elementPacket(Lcg& rng, int quad, int elem)
+{
+    QByteArray b(10, '\0');
+    uchar* p = reinterpret_cast<uchar*>(b.data());
+    p[0] = 0x10; p[1] = uchar(quad); p[2] = uchar(elem); p[3] = uchar(elem >> 8);
+    writeElement(rng, p + 4);
+    return b;
+}
+
+QByteArray quadrantPacket(Lcg& rng, int quad, int epq)
+{
+    QByteArray b(2 + epq * 6, '\0');
+    uchar* p = reinterpret_cast<uchar*>(b.data());
+    p[0] = 0x11; p[1] = uchar(quad);
+    for (int i = 0; i < epq; ++i) writeElement(rng, p + 2 + i * 6);
+    return b;
+}
+
+QByteArray snapshotPacket(Lcg& rng, int quadrants, int epq)
+{
+    QByteArray b(1 + quadrants * epq * 6, '\0');
+    uchar* p = reinterpret_cast<uchar*>(b.data());
+    p[0] = 0x12;
+    for (int i = 0; i < quadrants * epq; ++i) writeElement(rng, p + 1 + i * 6);
+    return b;
+}
+
+void putU32(uchar* p, quint32 v)
+{
+    p[0] = uchar(v); p[1] = uchar(v >> 8); p[2] = uchar(v >> 16); p[3] = uchar(v >> 24);
+}
+
+QByteArray keyframePacket(const QByteArray& snapshot, quint32 seq)
+{
+    QByteArray b = snapshot;
+    b[0] = char(0x14);
+    b.insert(1, QByteArray(4, '\0'));
+    putU32(reinterpret_cast<uchar*>(b.data()) + 1, seq);
+    return b;
+}
+
+// Runs of 1-4 elements spread evenly, ~1% of the array; seq is patched per feed
+QByteArray deltaPacket(Lcg& rng, int total, quint32 baseSeq)
+{
+    QByteArray b(11, '\0');
+    int runs = 0;
+    const int stride = 300;
+    for (int start = int(rng.next() % stride); start < total; start += stride) {
+        const int count = qMin(total - start, 1 + int(rng.next() % 4));
+        QByteArray run(6 + count * 6, '\0');
+        uchar* r = reinterpret_cast<uchar*>(run.data());
+        putU32(r, quint32(start));
+        r[4] = uchar(count); r[5] = uchar(count >> 8);
+        for (int i = 0; i < count; ++i) writeElement(rng, r + 6 + i * 6);
+        b += run;
+        ++runs;
+    }
+    uchar* p = reinterpret_cast<uchar*>(b.data());
+    p[0] = 0x13;
+    putU32(p + 5, baseSeq);
+    p[9] = uchar(runs); p[10] = uchar(runs >> 8);
+    return b;
+}
+
+// 1472-byte chunks as SimulatorEngine sends them; frame id patched per feed
+QVector<QByteArray> chunkPackets(const QByteArray& snapshot)
+{
+    const int total    = (snapshot.size() - 1) / 6;
+    const int perChunk = (1472 - 15) / 6;
+    const int chunks   = (total + perChunk - 1) / perChunk;
+    QVector<QByteArray> out;
+    for (int c = 0; c < chunks; ++c) {
+        const int offset = c * perChunk, n = qMin(perChunk, total - offset);
+        QByteArray b(15, '\0');
+        uchar* p = reinterpret_cast<uchar*>(b.data());
+        p[0] = 0x15;
+        p[5] = uchar(c); p[6] = uchar(c >> 8);
+        p[7] = uchar(chunks); p[8] = uchar(chunks >> 8);
+        putU32(p + 9, quint32(offset));
+        p[13] = uchar(n); p[14] = uchar(n >> 8);
+        b.append(snapshot.constData() + 1 + offset * 6, n * 6);
+        out.append(b);
+    }
+    return out;
+}
+
+} // namespace
+
+bool runAntennaBenchmarks(QList<BenchResult>& results)
+{
+    bool ok = true;
+    for (const Geometry& g : kGeometries) {
+        AntennaConfig cfg;
+        cfg.name = QString("bench_%1").arg(g.label);
+        cfg.quadrants = g.quadrants;
+        cfg.elementsPerQuadrant = g.epq;
+        cfg.historyDepth = 120;
+        RadarModel model(cfg);
+        UdpReceiver receiver(&model);
+        const QString size = g.label;
+        Lcg rng;
+
+        // ── antenna_decode ────────────────────────────────────────
+        QVector<QByteArray> singles;
+        for (int i = 0; i < 64; ++i)
+            singles.append(elementPacket(rng, i % g.quadrants, int(rng.next() % quint32(g.epq))));
+        const QByteArray quad = quadrantPacket(rng, 0, g.epq);
+        const QByteArray snap = snapshotPacket(rng, g.quadrants, g.epq);
+
+        auto feed = [&receiver](const QByteArray& b) {
+            return receiver.handleDatagram(reinterpret_cast<const uchar*>(b.constData()), b.size()) ? 1 : 0;
+        };
+        if (!feed(singles[0]) || !feed(quad) || !feed(snap)) {
+            QTextStream(stderr) << "DECODE FAILED: antenna packets rejected at " << size << " elements\n";
+            ok = false;
+        }
+
+        int next = 0;
+        results.append(Bench::run("antenna_decode", "0x10_element/" + size, 10, [&]() {
+            next = (next + 1) & 63;
+            return feed(singles[next]);
+        }));
+        results.append(Bench::run("antenna_decode", "0x11_quadrant/" + size, quad.size(), [&]() {
+            return feed(quad);
+        }));
+        results.append(Bench::run("antenna_decode", "0x12_snapshot/" + size, snap.size(), [&]() {
+            return feed(snap);
+        }));
+
+        quint32 seq = 1;
+        QByteArray delta = deltaPacket(rng, g.quadrants * g.epq, seq);
+        if (!feed(keyframePacket(snap, seq))) {
+            QTextStream(stderr) << "DECODE FAILED: 0x14 keyframe rejected at " << size << " elements\n";
+            ok = false;
+        }
+        results.append(Bench::run("antenna_decode", "0x13_delta_1pct/" + size, delta.size(), [&]() {
+            putU32(reinterpret_cast<uchar*>(delta.data()) + 1, ++seq);
+            return feed(delta);
+        }));
+        receiver.refreshStats();
+        if (!receiver.deltaSynced()) {
+            QTextStream(stderr) << "DECODE FAILED: receiver lost delta sync at " << size << " elements\n";
+            ok = false;
+        }
+
+        QVector<QByteArray> chunks = chunkPackets(snap);
+        const int completeBefore = receiver.chunkFramesComplete();
+        results.append(Bench::run("antenna_decode", "0x15_chunked_frame/" + size, snap.size() + chunks.size() * 14, [&]() {
+            const quint32 frame = seq + 1;          // chunk i takes seq frame + i
+            seq += quint32(chunks.size());
+            int n = 0;
+            for (QByteArray& c : chunks) {
+                putU32(reinterpret_cast<uchar*>(c.data()) + 1, frame);
+                n += feed(c);
+            }
+            return n;
+        }));
+        receiver.refreshStats();
+        if (receiver.chunkFramesComplete() == completeBefore || receiver.chunkFramesPartial() != 0) {
+            QTextStream(stderr) << "DECODE FAILED: 0x15 frames not reassembled at " << size << " elements\n";
+            ok = false;
+        }
+
+        // ── radar_model ───────────────────────────────────────────
+        QVector<QVector<float>> powers(g.quadrants), temps(g.quadrants), currents(g.quadrants);
+        const uchar* sp = reinterpret_cast<const uchar*>(snap.constData()) + 1;
+        for (int q = 0; q < g.quadrants; ++q) {
+            for (int i = 0; i < g.epq; ++i, sp += 6) {
+                powers[q].append((quint16(sp[0]) | quint16(sp[1]) << 8) / 100.0f - 10.0f);
+                temps[q].append((quint16(sp[2]) | quint16(sp[3]) << 8) / 10.0f);
+                currents[q].append((quint16(sp[4]) | quint16(sp[5]) << 8) / 1000.0f);
+            }
+        }
+
+        // Alternate with a perturbed copy so every pass changes every value and
+        // moves every 8th element across the power thresholds: the change path
+        // of the incremental aggregates, not the no-change one
+        QVector<QVector<float>> powersAlt = powers, tempsAlt = temps, currentsAlt = currents;
+        for (int q = 0; q < g.quadrants; ++q) {
+            for (int i = 0; i < g.epq; ++i) {
+                powersAlt[q][i]   += (i % 8 == 0) ? -6.0f : 0.1f;
+                tempsAlt[q][i]    += 0.5f;
+                currentsAlt[q][i] += 0.01f;
+            }
+        }
+        bool alt = false;
+        results.append(Bench::run("radar_model", "set_all_quadrants/" + size, 0, [&]() {
+            alt = !alt;
+            if (alt) model.setAllQuadrants(powersAlt, tempsAlt, currentsAlt);
+            else     model.setAllQuadrants(powers, temps, currents);
+            return model.healthyCount();
+        }));
+        // A 0x12 write plus building and swapping in its snapshot
+        results.append(Bench::run("radar_model", "snapshot_0x12_publish/" + size, snap.size(), [&]() {
+            model.setAllQuadrantsRaw(reinterpret_cast<const uchar*>(snap.constData()) + 1, snap.size() - 1);
+            QMetaObject::invokeMethod(&model, "publishFrame");
+            return model.healthyCount();
+        }));
+        QVector<float> flatP, flatT, flatC;
+        for (int q = 0; q < g.quadrants; ++q) { flatP += powers[q]; flatT += temps[q]; flatC += currents[q]; }
+        QVector<quint8> status(flatP.size());
+        results.append(Bench::run("radar_model", "classify/" + size, flatP.size() * 12, [&]() {
+            RadarModel::classify(flatP.constData(), flatT.constData(), flatC.constData(),
+                                 status.data(), status.size());
+            return int(status[next % status.size()]);
+        }));
+        results.append(Bench::run("radar_model", "set_element/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            model.setElement(0, next, powers[0][next], temps[0][next], currents[0][next]);
+            return model.warningCount();
+        }));
+        // A burst of 0x10 updates folded into one published frame
+        results.append(Bench::run("radar_model", "set_element_x64_one_frame/" + size, 0, [&]() {
+            for (int i = 0; i < 64; ++i) {
+                next = (next + 1) % g.epq;
+                model.setElement(0, next, powers[0][next], temps[0][next], currents[0][next]);
+            }
+            QMetaObject::invokeMethod(&model, "publishFrame");
+            return model.suppressedNotifications();
+        }));
+        // One ingest batch, its published frame, then the LOD queries of a repaint
+        results.append(Bench::run("radar_model", "set_element_then_lod_queries/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            model.setElement(0, next, powers[0][next] - 5.0f, temps[0][next], currents[0][next]);
+            QMetaObject::invokeMethod(&model, "publishFrame");
+            int n = model.antennaHealth();
+            for (int q = 0; q < g.quadrants; ++q)
+                n += model.quadrantMetrics(q).size() + model.quadrantHealth(q);
+            for (int c = 0; c < model.clustersPerQuadrant(); ++c)
+                n += model.clusterStats(0, c).size();
+            return n;
+        }));
+        ElementHistory history;
+        history.configure(flatP.size(), cfg.historyDepth);
+        results.append(Bench::run("radar_model", "history_record/" + size, flatP.size() * 6, [&]() {
+            history.record(0, flatP.constData(), flatT.constData(), flatC.constData());
+            return history.size();
+        }));
+        for (int i = 0; i < cfg.historyDepth; ++i)
+            QMetaObject::invokeMethod(&model, "sampleElementHistory");
+        results.append(Bench::run("radar_model", "element_history_120/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            return model.elementHistory(0, next).size() + model.elementEnvelope(0, next).size();
+        }));
+        results.append(Bench::run("radar_model", "cluster_history_120/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            return model.clusterHistory(0, next / cfg.elementsPerCluster).size();
+        }));
+        results.append(Bench::run("radar_model", "worst_elements_8/" + size, 0, [&]() {
+            return model.worstElements(8).size();
+        }));
+        results.append(Bench::run("radar_model", "worst_by_temp_8/" + size, 0, [&]() {
+            return model.worstElementsBy(QStringLiteral("temp"), 8).size();
+        }));
+        // A status change per iteration keeps the index and cluster cache moving
+        results.append(Bench::run("radar_model", "set_element_then_worst_8/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            model.setElement(0, next, powers[0][next] - ((next & 1) ? 5.0f : 0.0f), temps[0][next], currents[0][next]);
+            QMetaObject::invokeMethod(&model, "publishFrame");
+            return model.worstElements(8).size() + model.worstElementsBy(QStringLiteral("power"), 8).size();
+        }));
+        // One element's status per hover event, and the QML buffer after a write
+        results.append(Bench::run("radar_model", "hover_quadrant_data/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            return model.quadrantData(0)[next].toInt();
+        }));
+        results.append(Bench::run("radar_model", "hover_element_status/" + size, 0, [&]() {
+            next = (next + 1) % g.epq;
+            return model.elementStatus(next);
+        }));
+        results.append(Bench::run("radar_model", "set_element_then_status_buffer/" + size, flatP.size(), [&]() {
+            next = (next + 1) % g.epq;
+            model.setElement(0, next, powers[0][next], temps[0][next], currents[0][next]);
+            QMetaObject::invokeMethod(&model, "publishFrame");
+            return int(model.statusBuffer().at(next));
+        }));
+        results.append(Bench::run("radar_model", "quadrant_metrics_all/" + size, 0, [&]() {
+            int n = 0;
+            for (int q = 0; q < g.quadrants; ++q) n += model.quadrantMetrics(q).size();
+            return n;
+        }));
+        results.append(Bench::run("radar_model", "quadrant_stats_all/" + size, 0, [&]() {
+            int n = 0;
+            for (int q = 0; q < g.quadrants; ++q) n += model.quadrantStats(q).size() + model.quadrantHealth(q);
+            return n;
+        }));
+        results.append(Bench::run("radar_model", "cluster_metrics_all/" + size, 0, [&]() {
+            int n = 0;
+            for (int q = 0; q < g.quadrants; ++q)
+                for (int c = 0; c < model.clustersPerQuadrant(); ++c)
+                    n += model.clusterMetrics(q, c).size();
+            return n;
+        }));
+        results.append(Bench::run("radar_model", "cluster_stats_all/" + size, 0, [&]() {
+            int n = 0;
+            for (int q = 0; q < g.quadrants; ++q)
+                for (int c = 0; c < model.clustersPerQuadrant(); ++c)
+                    n += model.clusterStats(q, c).size() + model.clusterHealth(q, c);
+            return n;
+        }));
+    }
+    return ok;
+}
@@ -0,0 +1,76 @@
+#include "benchharness.h"
+#include "healthmessageparser.h"
+#include "fasthealthjson.h"
+#include "benchpayloads.h"
+#include <QSet>
+
+/*
+ * Health message decoding: QJsonDocument reference path
+ * (HealthMessageParser::parseJson) vs FastHealthJsonDecoder, on every
+ * documented message shape (benchpayloads.h).
+ */
+
+namespace {
+
+using namespace BenchPayloads;
+
+// Same updates from both paths? Subsystem order may differ (document vs sorted).
+bool sameUpdates(const QVector<HealthUpdate>& a, const QVector<HealthUpdate>& b)
+{
+    if (a.size() != b.size()) return false;
+    QSet<QString> sa, sb;
+    for (int i = 0; i < a.size(); ++i) {
+        const HealthUpdate& x = a[i];
+        const HealthUpdate& y = b[i];
+        if (x.kind != y.kind || x.componentId != y.componentId) return false;
+        if (x.kind == HealthUpdate::Subsystem) {
+            sa.insert(x.subsystem + '=' + x.color + QString::number(x.value));
+            sb.insert(y.subsystem + '=' + y.color + QString::number(y.value));
+        } else if (x.kind == HealthUpdate::Component) {
+            if (x.color != y.color || x.value != y.value) return false;
+        } else if (x.kind == HealthUpdate::Telemetry) {
+            if (x.telemetry != y.telemetry) return false;
+        } else if (x.kind == HealthUpdate::Trm) {
+            if (x.trms.size() != y.trms.size()) return false;
+            for (int t = 0; t < x.trms.size(); ++t) {
+                const TrmRecord& p = x.trms[t];
+                const TrmRecord& q = y.trms[t];
+                if (p.id != q.id || p.health != q.health || p.color != q.color
+                    || p.status != q.status || p.voltage != q.voltage || p.current != q.current
+                    || p.on != q.on || p.trip != q.trip || p.bit != q.bit
+                    || p.quadrant != q.quadrant || p.channel != q.channel)
+                    return false;
+            }
+        }
+    }
+    return sa == sb;
+}
+
+} // namespace
+
+bool runHealthDecodeBenchmarks(QList<BenchResult>& results)
+{
+    bool consistent = true;
+    for (const Payload& p : messageShapes()) {
+        QVector<HealthUpdate> ref, fast;
+        FastHealthJsonDecoder decoder;
+        HealthMessageParser::parseJson(p.data, ref);
+        if (decoder.decode(p.data, fast) != FastHealthJsonDecoder::Decoded || !sameUpdates(ref, fast)) {
+            QTextStream(stderr) << "MISMATCH: fast decoder disagrees with parseJson on " << p.name << "\n";
+            consistent = false;
+        }
+
+        QVector<HealthUpdate> out;
+        results.append(Bench::run("json_decode", p.name + "/qjsondocument", p.data.size(), [&]() {
+            out.clear();
+            HealthMessageParser::parseJson(p.data, out);
+            return out.size();
+        }));
+        results.append(Bench::run("json_decode", p.name + "/fast", p.data.size(), [&]() {
+            out.clear();
+            decoder.decode(p.data, out);
+            return out.size();
+        }));
+    }
+    return consistent;
+}
@@ -0,0 +1,37 @@
+#include "benchharness.h"
+#include "benchpayloads.h"
+#include "messageserver.h"
+
+/*
+ * MessageServer ingest: one frame through parseAndEmitMessage (decode,
+ * stats, routing, signal emission) for every documented message shape.
+ * A counting slot is connected to each signal so emission is not the
+ * no-receiver fast path.
+ */
+
+using namespace BenchPayloads;
+
+bool runIngestBenchmarks(QList<BenchResult>& results)
+{
+    MessageServer server;
+    int delivered = 0;
+    QObject::connect(&server, &MessageServer::messageReceived, [&delivered]() { ++delivered; });
+    QObject::connect(&server, &MessageServer::subsystemHealthReceived, [&delivered]() { ++delivered; });
+    QObject::connect(&server, &MessageServer::telemetryReceived, [&delivered]() { ++delivered; });
+    QObject::connect(&server, &MessageServer::trmDataReceived, [&delivered]() { ++delivered; });
+
+    bool ok = true;
+    for (const Payload& p : messageShapes()) {
+        delivered = 0;
+        server.injectFrame(p.data);
+        if (delivered == 0) {
+            QTextStream(stderr) << "NO UPDATES: parseAndEmitMessage dropped " << p.name << "\n";
+            ok = false;
+        }
+        results.append(Bench::run("ingest", "parse_and_emit/" + p.name, p.data.size(), [&]() {
+            server.injectFrame(p.data);
+            return delivered;
+        }));
+    }
+    return ok;
+}
@@ -0,0 +1,39 @@
+#include "benchharness.h"
+#include "benchpayloads.h"
+#include "trmgridview.h"
+
+/*
+ * TrmGridView::updateTrmData at 271, 2048 and 65536 TRMs: typed records
+ * (the trmDataReceived path) and the raw "trm_data" JSON array overload.
+ * The view is never shown, so this is the data/model side of an update
+ * (cell state, status counters, repaint scheduling), not painting.
+ */
+
+using namespace BenchPayloads;
+
+bool runTrmGridBenchmarks(QList<BenchResult>& results)
+{
+    const int sizes[] = { 271, 2048, 65536 };
+    for (int count : sizes) {
+        Lcg rng;
+        const QJsonArray json = trmData(rng, count);
+        TrmRecordList records;
+        records.reserve(count);
+        for (const QJsonValue& v : json)
+            records.append(TrmRecord::fromJson(v.toObject()));
+
+        TrmGridView view;
+        view.setTrmCount(count, count > 2048 ? 256 : 32);
+
+        const QString size = QString::number(count);
+        results.append(Bench::run("trm_grid", "update_records/" + size, 0, [&]() {
+            view.updateTrmData(records);
+            return view.trmCount();
+        }));
+        results.append(Bench::run("trm_grid", "update_json/" + size, 0, [&]() {
+            view.updateTrmData(json);
+            return view.trmCount();
+        }));
+    }
+    return true;
+}
@@ -0,0 +1,134 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <QString>
+#include <QList>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <algorithm>
+#include <vector>
+
+/**
+ * Minimal benchmark harness.
+ *
+ * Bench::run() makes one untimed warm-up call, then doubles a batch size
+ * until one batch of fn() calls takes at least minMs / kSamples, and times
+ * kSamples such batches. The reported time per call is the median batch
+ * (min and max are kept to show the spread), which is far less sensitive to
+ * a stray scheduler hiccup than a single long mean. fn returns an int that
+ * is folded into a sink so the work cannot be optimised away.
+ *
+ * Bench::toJson() is the stable machine-readable form used to track
+ * regressions between releases: fixed key names, results in run order,
+ * numbers rounded to 0.1 ns. Bump kSchemaVersion when a key changes meaning.
+ */
+struct BenchResult {
+    QString group;
+    QString name;
+    qint64  iterations = 0;
+    double  nsPerOp = 0.0;       // median sample
+    double  nsMin = 0.0;
+    double  nsMax = 0.0;
+    qint64  bytesPerOp = 0;      // 0 = no throughput figure
+
+    double mbPerSec() const
+    {
+        return (bytesPerOp > 0 && nsPerOp > 0) ? (bytesPerOp / nsPerOp) * 1e9 / (1024.0 * 1024.0) : 0.0;
+    }
+};
+
+namespace Bench {
+
+extern volatile int g_sink;
+
+const int kSamples = 5;
+const int kSchemaVersion = 1;
+
+template <typename Fn>
+BenchResult run(const QString& group, const QString& name, qint64 bytesPerOp, Fn fn, int minMs = 300)
+{
+    g_sink += fn();
+
+    QElapsedTimer timer;
+    auto timeBatch = [&](qint64 batch) {
+        timer.start();
+        for (qint64 i = 0; i < batch; ++i)
+            g_sink += fn();
+        return timer.nsecsElapsed();
+    };
+
+    // Calibrate: smallest power-of-two batch that fills one sample slot
+    const qint64 slotNs = qint64(minMs) * 1000000 / kSamples;
+    qint64 batch = 1;
+    qint64 iterations = 0;
+    for (;;) {
+        const qint64 ns = timeBatch(batch);
+        iterations += batch;
+        if (ns >= slotNs) break;
+        batch *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int s = 0; s < kSamples; ++s) {
+        samples.push_back(double(timeBatch(batch)) / double(batch));
+        iterations += batch;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult r;
+    r.group = group;
+    r.name = name;
+    r.iterations = iterations;
+    r.nsPerOp = samples[samples.size() / 2];
+    r.nsMin = samples.front();
+    r.nsMax = samples.back();
+    r.bytesPerOp = bytesPerOp;
+    return r;
+}
+
+inline void print(QTextStream& out, const BenchResult& r)
+{
+    out << r.group.leftJustified(14)
+        << r.name.leftJustified(36)
+        << QString::number(r.nsPerOp, 'f', 1).rightJustified(14) << " ns/op";
+    if (r.bytesPerOp > 0)
+        out << "   " << QString::number(r.mbPerSec(), 'f', 1) << " MB/s";
+    out << "   (" << r.iterations << " iters)\n";
+    out.flush();
+}
+
+inline double round1(double v) { return qRound64(v * 10.0) / 10.0; }
+
+inline QJsonObject toJson(const BenchResult& r)
+{
+    QJsonObject o;
+    o["group"] = r.group;
+    o["name"] = r.name;
+    o["iterations"] = r.iterations;
+    o["ns_per_op"] = round1(r.nsPerOp);
+    o["ns_min"] = round1(r.nsMin);
+    o["ns_max"] = round1(r.nsMax);
+    o["bytes_per_op"] = r.bytesPerOp;
+    o["mb_per_s"] = round1(r.mbPerSec());
+    return o;
+}
+
+/** Whole run: { schema, qt, samples, results: [ ... ] } */
+inline QJsonObject toJson(const QList<BenchResult>& results)
+{
+    QJsonArray list;
+    for (const BenchResult& r : results)
+        list.append(toJson(r));
+    QJsonObject o;
+    o["schema"] = kSchemaVersion;
+    o["qt"] = QString(qVersion());
+    o["samples"] = kSamples;
+    o["results"] = list;
+    return o;
+}
+
+} // namespace Bench
+
+#endif // BENCHHARNESS_H
@@ -0,0 +1,82 @@
+# Micro-benchmarks for UnifiedApp hot paths (console; widgets only for the
+# TrmGridView group, which runs on the offscreen platform without a display).
+#   qmake && make && ./vajra_bench [--json results.json] [group-filter]
+
+QT += core gui widgets network
+
+# Same optional transports as UnifiedApp.pro – MessageServer links them all
+qtHaveModule(serialport) {
+    QT += serialport
+    DEFINES += QT_SERIALPORT_LIB
+}
+qtHaveModule(serialbus) {
+    QT += serialbus
+    DEFINES += QT_SERIALBUS_LIB
+}
+
+TARGET = vajra_bench
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+APP_DIR = ../UnifiedApp
+INCLUDEPATH += $$APP_DIR
+
+SOURCES += \
+    main.cpp \
+    benchpayloads.cpp \
+    bench_healthdecode.cpp \
+    bench_ingest.cpp \
+    bench_antenna.cpp \
+    bench_trmgrid.cpp \
+    $$APP_DIR/healthmessageparser.cpp \
+    $$APP_DIR/fasthealthjson.cpp \
+    $$APP_DIR/binaryhealthframe.cpp \
+    $$APP_DIR/messageserver.cpp \
+    $$APP_DIR/ingestworker.cpp \
+    $$APP_DIR/ingeststats.cpp \
+    $$APP_DIR/framecapture.cpp \
+    $$APP_DIR/replayprotocolhandler.cpp \
+    $$APP_DIR/datagrambatchreader.cpp \
+    $$APP_DIR/protocolhandler.cpp \
+    $$APP_DIR/tcpprotocolhandler.cpp \
+    $$APP_DIR/udpprotocolhandler.cpp \
+    $$APP_DIR/serialprotocolhandler.cpp \
+    $$APP_DIR/modbusprotocolhandler.cpp \
+    $$APP_DIR/canprotocolhandler.cpp \
+    $$APP_DIR/protocolhandlerfactory.cpp \
+    $$APP_DIR/RadarModel.cpp \
+    $$APP_DIR/ElementHistory.cpp \
+    $$APP_DIR/UdpReceiver.cpp \
+    $$APP_DIR/trmgridview.cpp \
+    $$APP_DIR/thememanager.cpp
+
+HEADERS += \
+    benchharness.h \
+    benchpayloads.h \
+    $$APP_DIR/healthupdate.h \
+    $$APP_DIR/trmrecord.h \
+    $$APP_DIR/healthmessageparser.h \
+    $$APP_DIR/fasthealthjson.h \
+    $$APP_DIR/binaryhealthframe.h \
+    $$APP_DIR/messageserver.h \
+    $$APP_DIR/spscqueue.h \
+    $$APP_DIR/ingestworker.h \
+    $$APP_DIR/ingeststats.h \
+    $$APP_DIR/framecapture.h \
+    $$APP_DIR/replayprotocolhandler.h \
+    $$APP_DIR/datagrambatchreader.h \
+    $$APP_DIR/protocolhandler.h \
+    $$APP_DIR/tcpprotocolhandler.h \
+    $$APP_DIR/udpprotocolhandler.h \
+    $$APP_DIR/serialprotocolhandler.h \
+    $$APP_DIR/modbusprotocolhandler.h \
+    $$APP_DIR/canprotocolhandler.h \
+    $$APP_DIR/protocolhandlerfactory.h \
+    $$APP_DIR/AntennaConfig.h \
+    $$APP_DIR/RadarModel.h \
+    $$APP_DIR/ElementHistory.h \
+    $$APP_DIR/UdpReceiver.h \
+    $$APP_DIR/SeqTracker.h \
+    $$APP_DIR/trmgridview.h \
+    $$APP_DIR/thememanager.h
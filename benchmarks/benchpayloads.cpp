@@ -0,0 +1,127 @@
+#include "benchpayloads.h"
+#include <QJsonDocument>
+
+namespace BenchPayloads {
+
+namespace {
+
+const char* const kColors[] = { "#00FF00", "#FFFF00", "#FFA500", "#FF0000", "#808080" };
+
+QString colorFor(double h)
+{
+    if (h >= 90) return kColors[0];
+    if (h >= 70) return kColors[1];
+    if (h >= 40) return kColors[2];
+    if (h >= 10) return kColors[3];
+    return kColors[4];
+}
+
+QString statusFor(double h)
+{
+    if (h >= 90) return "HEALTHY";
+    if (h >= 70) return "WARNING";
+    if (h >= 40) return "DEGRADED";
+    if (h >= 10) return "CRITICAL";
+    return "OFFLINE";
+}
+
+double round1(double v) { return qRound(v * 10.0) / 10.0; }
+
+} // namespace
+
+QJsonObject subsystemHealth(Lcg& rng)
+{
+    static const char* const names[] = {
+        "APCU Controller", "Temperature Monitoring", "Board Data", "Board Status",
+        "Quadrant 0 (CB)", "Quadrant 1 (CF)", "Quadrant 2 (CD)", "Quadrant 3 (CE)",
+        "QTRMs", "AQC"
+    };
+    QJsonObject o;
+    for (const char* n : names) o[n] = round1(rng.range(60, 100));
+    return o;
+}
+
+QJsonArray trmData(Lcg& rng, int count)
+{
+    QJsonArray arr;
+    for (int i = 0; i < count; ++i) {
+        double h = round1(rng.range(30, 100));
+        QJsonObject t;
+        t["id"] = i;
+        t["quadrant"] = i % 4;
+        t["channel"] = i / 4 % 64;
+        t["health"] = h;
+        t["color"] = colorFor(h);
+        t["status"] = statusFor(h);
+        t["on"] = rng.next() > 0.02;
+        t["trip"] = rng.next() > 0.01 ? "Normal" : "Tripped";
+        t["bit"] = rng.next() > 0.01 ? "Normal" : "Fault";
+        t["voltage"] = qRound(rng.range(27.0, 29.0) * 100) / 100.0;
+        t["current"] = qRound(rng.range(1.2, 1.9) * 1000) / 1000.0;
+        arr.append(t);
+    }
+    return arr;
+}
+
+QJsonObject telemetry(Lcg& rng)
+{
+    QJsonObject temp;
+    temp["sensor_a"] = rng.range(35, 60);
+    temp["sensor_b"] = rng.range(35, 60);
+    temp["sensor_c"] = rng.range(35, 60);
+    temp["status"] = "Normal";
+    QJsonObject links;
+    for (int i = 0; i < 4; ++i) links[QString("Q%1").arg(i)] = true;
+    QJsonObject t;
+    t["version"] = "2.0.0";
+    t["unit"] = "Antenna Subsystem (271 TRMs)";
+    t["trm_count"] = 271;
+    t["link_status"] = links;
+    t["sequence_on"] = true;
+    t["array_voltage"] = rng.range(27, 29);
+    t["array_current"] = rng.range(300, 400);
+    t["temperature"] = temp;
+    return t;
+}
+
+QByteArray compact(const QJsonObject& o)
+{
+    return QJsonDocument(o).toJson(QJsonDocument::Compact);
+}
+
+QList<Payload> messageShapes()
+{
+    Lcg rng;
+    QList<Payload> list;
+
+    QJsonObject basic;
+    basic["component_id"] = "antenna_1";
+    basic["color"] = "#00FF00";
+    basic["size"] = 95.5;
+    list.append({ "basic", compact(basic) });
+
+    QJsonObject single = basic;
+    single["subsystem"] = "APCU Controller";
+    list.append({ "single_subsystem", compact(single) });
+
+    QJsonObject bulk = basic;
+    bulk["subsystem_health"] = subsystemHealth(rng);
+    list.append({ "subsystem_health", compact(bulk) });
+
+    QJsonObject apcu = basic;
+    apcu["apcu_telemetry"] = telemetry(rng);
+    list.append({ "apcu_telemetry", compact(apcu) });
+
+    QJsonObject trm = basic;
+    trm["trm_data"] = trmData(rng, 271);
+    list.append({ "trm_data_271", compact(trm) });
+
+    QJsonObject full = bulk;
+    full["trm_data"] = trmData(rng, 271);
+    full["apcu_telemetry"] = telemetry(rng);
+    list.append({ "full_271_trm", compact(full) });
+
+    return list;
+}
+
+} // namespace BenchPayloads
@@ -0,0 +1,36 @@
+#ifndef BENCHPAYLOADS_H
+#define BENCHPAYLOADS_H
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+/*
+ * Deterministic health payloads shaped like the ones
+ * antenna_subsystem_simulator.py and apcu_simulator.py send (same keys,
+ * value ranges and TRM layout), shared by the decode and ingest groups.
+ */
+namespace BenchPayloads {
+
+// Deterministic generator so every run works on identical data
+struct Lcg {
+    quint32 state = 12345;
+    double next() { state = state * 1664525u + 1013904223u; return (state >> 8) / double(1 << 24); }
+    double range(double lo, double hi) { return lo + (hi - lo) * next(); }
+};
+
+QJsonObject subsystemHealth(Lcg& rng);
+QJsonArray  trmData(Lcg& rng, int count);
+QJsonObject telemetry(Lcg& rng);
+QByteArray  compact(const QJsonObject& o);
+
+struct Payload { QString name; QByteArray data; };
+
+/** One payload per documented MessageServer message shape. */
+QList<Payload> messageShapes();
+
+} // namespace BenchPayloads
+
+#endif // BENCHPAYLOADS_H
@@ -0,0 +1,80 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QStringList>
+#include <QTextStream>
+#include "benchharness.h"
+
+volatile int Bench::g_sink = 0;
+
+bool runHealthDecodeBenchmarks(QList<BenchResult>& results);
+bool runIngestBenchmarks(QList<BenchResult>& results);
+bool runAntennaBenchmarks(QList<BenchResult>& results);
+bool runTrmGridBenchmarks(QList<BenchResult>& results);
+
+/*
+ * vajra_bench – micro-benchmarks for the UnifiedApp hot paths.
+ *
+ *   vajra_bench [--json <file|->] [group-filter]
+ *
+ * Groups: json_decode, ingest, antenna_decode, radar_model, trm_grid.
+ * With a filter, only groups whose name contains it are run. --json writes
+ * the results in the stable format of Bench::toJson() ("-" = stdout, in
+ * which case the table is not printed).
+ *
+ * trm_grid needs QWidgets; without a display the offscreen platform is
+ * selected automatically.
+ */
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") && qEnvironmentVariableIsEmpty("DISPLAY")
+            && qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("json", "Write results as JSON (\"-\" = stdout).", "file"));
+    parser.addPositionalArgument("filter", "Only run groups whose name contains this.");
+    parser.process(app);
+
+    const QString filter = parser.positionalArguments().value(0);
+    auto enabled = [&filter](const char* group) {
+        return filter.isEmpty() || QString(group).contains(filter);
+    };
+
+    QList<BenchResult> results;
+    bool ok = true;
+    if (enabled("json_decode")) ok &= runHealthDecodeBenchmarks(results);
+    if (enabled("ingest"))      ok &= runIngestBenchmarks(results);
+    if (enabled("antenna_decode") || enabled("radar_model")) ok &= runAntennaBenchmarks(results);
+    if (enabled("trm_grid"))    ok &= runTrmGridBenchmarks(results);
+
+    // Some runners cover several groups; keep only the requested ones
+    for (int i = results.size() - 1; i >= 0; --i) {
+        if (!enabled(results[i].group.toLatin1().constData())) results.removeAt(i);
+    }
+
+    const QString jsonPath = parser.value("json");
+    if (jsonPath != "-") {
+        QTextStream out(stdout);
+        for (const BenchResult& r : results)
+            Bench::print(out, r);
+    }
+
+    if (!jsonPath.isEmpty()) {
+        const QByteArray json = QJsonDocument(Bench::toJson(results)).toJson(QJsonDocument::Indented);
+        QFile f(jsonPath);
+        const bool opened = jsonPath == "-" ? f.open(stdout, QIODevice::WriteOnly)
+                                            : f.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        if (!opened) {
+            QTextStream(stderr) << "cannot write " << jsonPath << ": " << f.errorString() << "\n";
+            return 1;
+        }
+        f.write(json);
+    }
+
+    return ok ? 0 : 1;
+}
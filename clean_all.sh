@@ -13,4 +13,24 @@ if [ -d "UnifiedApp" ]; then
     echo "✓ Unified Application cleaned"
 fi
 
+# Clean benchmarks
+if [ -d "benchmarks" ]; then
+    cd benchmarks
+    make clean 2>/dev/null
+    rm -f Makefile vajra_bench .qmake.stash
+    rm -rf moc_* *.o
+    cd ..
+    echo "✓ Benchmarks cleaned"
+fi
+
+# Clean load generator
+if [ -d "loadgen" ]; then
+    cd loadgen
+    make clean 2>/dev/null
+    rm -f Makefile vajra_loadgen .qmake.stash
+    rm -rf moc_* *.o
+    cd ..
+    echo "✓ Load generator cleaned"
+fi
+
 echo "Clean completed!"
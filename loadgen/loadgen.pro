@@ -0,0 +1,22 @@
+# Headless multi-protocol load generator for the UnifiedApp MessageServer
+# and the antenna UDP receivers (console, no GUI).
+#   qmake && make && ./vajra_loadgen --help
+
+QT += core network
+QT -= gui
+
+TARGET = vajra_loadgen
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+SOURCES += \
+    main.cpp \
+    loadpacer.cpp \
+    payloadfactory.cpp \
+    loadsenders.cpp
+
+HEADERS += \
+    loadpacer.h \
+    payloadfactory.h \
+    loadsenders.h
@@ -0,0 +1,60 @@
+#include "loadpacer.h"
+#include <QtGlobal>
+#include <cmath>
+
+bool LoadPattern::parseShape(const QString& s, Shape& shape)
+{
+    const QString lower = s.toLower();
+    if (lower == "steady") { shape = Steady; return true; }
+    if (lower == "burst")  { shape = Burst;  return true; }
+    if (lower == "ramp")   { shape = Ramp;   return true; }
+    return false;
+}
+
+LoadPacer::LoadPacer(double ratePerSec, const LoadPattern& pattern)
+    : m_rate(qMax(0.0, ratePerSec))
+    , m_pattern(pattern)
+{
+    m_pattern.burstOnMs  = qMax(1, m_pattern.burstOnMs);
+    m_pattern.burstOffMs = qMax(0, m_pattern.burstOffMs);
+    m_pattern.rampSecs   = qMax(1, m_pattern.rampSecs);
+}
+
+void LoadPacer::start(qint64 nowNs)
+{
+    m_start = nowNs;
+    m_last = nowNs;
+    m_credit = 0.0;
+}
+
+double LoadPacer::targetRate(qint64 elapsedNs) const
+{
+    switch (m_pattern.shape) {
+    case LoadPattern::Steady:
+        return m_rate;
+    case LoadPattern::Burst: {
+        const qint64 periodMs = m_pattern.burstOnMs + m_pattern.burstOffMs;
+        const qint64 phaseMs = (elapsedNs / 1000000) % periodMs;
+        if (phaseMs >= m_pattern.burstOnMs) return 0.0;
+        return m_rate * double(periodMs) / m_pattern.burstOnMs;
+    }
+    case LoadPattern::Ramp:
+        return m_rate * qMin(1.0, elapsedNs / (m_pattern.rampSecs * 1e9));
+    }
+    return m_rate;
+}
+
+int LoadPacer::due(qint64 nowNs)
+{
+    const qint64 dt = nowNs - m_last;
+    if (dt <= 0) return 0;
+    m_last = nowNs;
+
+    const double rate = targetRate(nowNs - m_start);
+    m_credit += rate * dt / 1e9;
+    m_credit = qMin(m_credit, qMax(1.0, rate * 0.25));
+
+    const double n = std::floor(m_credit);
+    m_credit -= n;
+    return static_cast<int>(n);
+}
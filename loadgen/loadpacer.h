@@ -0,0 +1,56 @@
+#ifndef LOADPACER_H
+#define LOADPACER_H
+
+#include <QString>
+
+/**
+ * LoadPattern – How a generator's send rate varies over time.
+ *
+ *   Steady : the configured rate all the time
+ *   Burst  : sends only during burstOnMs of every (burstOnMs + burstOffMs)
+ *            window, at a peak rate chosen so the average stays at the
+ *            configured rate
+ *   Ramp   : rises linearly from 0 to the configured rate over rampSecs,
+ *            then stays there
+ */
+struct LoadPattern {
+    enum Shape { Steady, Burst, Ramp };
+
+    Shape shape = Steady;
+    int   burstOnMs = 200;
+    int   burstOffMs = 800;
+    int   rampSecs = 30;
+
+    static bool parseShape(const QString& s, Shape& shape);
+};
+
+/**
+ * LoadPacer – Token bucket that turns a rate (messages/s) and a pattern
+ * into "send n messages now" decisions for a 1 ms driver tick.
+ *
+ * Credit accrues continuously, so the long-run rate is exact even when the
+ * driver timer runs late; it is capped at 250 ms worth of messages so a
+ * stalled process does not answer with one giant burst.
+ */
+class LoadPacer
+{
+public:
+    LoadPacer(double ratePerSec = 0.0, const LoadPattern& pattern = LoadPattern());
+
+    void start(qint64 nowNs);
+    /** Messages due at @p nowNs (monotonic ns, same clock as start()). */
+    int due(qint64 nowNs);
+
+    double rate() const { return m_rate; }
+    /** Instantaneous target rate @p elapsedNs after start(). */
+    double targetRate(qint64 elapsedNs) const;
+
+private:
+    double      m_rate;
+    LoadPattern m_pattern;
+    qint64      m_start = 0;
+    qint64      m_last = 0;
+    double      m_credit = 0.0;
+};
+
+#endif // LOADPACER_H
@@ -0,0 +1,337 @@
+#include "loadsenders.h"
+#include <QTcpSocket>
+#include <QTcpServer>
+#include <QUdpSocket>
+#include <QTimer>
+#include <QTextStream>
+
+static QHostAddress resolve(const QString& host)
+{
+    if (host == "localhost") return QHostAddress(QHostAddress::LocalHost);
+    return QHostAddress(host);
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  LoadSender
+// ────────────────────────────────────────────────────────────────────────────
+
+LoadSender::LoadSender(const QString& name, const LoadPacer& pacer, QObject* parent)
+    : QObject(parent)
+    , m_name(name)
+    , m_pacer(pacer)
+{}
+
+void LoadSender::pump(qint64 nowNs)
+{
+    const int n = m_pacer.due(nowNs);
+    if (n > 0) send(n);
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  TCP
+// ────────────────────────────────────────────────────────────────────────────
+
+TcpLoadSender::TcpLoadSender(const QString& host, quint16 port, int connections,
+                             bool lengthPrefixed, HealthPayloadFactory* payloads,
+                             const LoadPacer& pacer, QObject* parent)
+    : LoadSender("tcp", pacer, parent)
+    , m_host(host)
+    , m_port(port)
+    , m_lengthPrefixed(lengthPrefixed)
+    , m_payloads(payloads)
+    , m_reconnectTimer(new QTimer(this))
+{
+    for (int i = 0; i < qMax(1, connections); ++i) {
+        QTcpSocket* s = new QTcpSocket(this);
+        s->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(s, &QAbstractSocket::errorOccurred, this, [this]() { ++m_errors; });
+        m_sockets.append(s);
+    }
+    m_reconnectTimer->setInterval(1000);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &TcpLoadSender::reconnect);
+}
+
+bool TcpLoadSender::start()
+{
+    reconnect();
+    m_reconnectTimer->start();
+    return true;
+}
+
+void TcpLoadSender::reconnect()
+{
+    for (QTcpSocket* s : m_sockets) {
+        if (s->state() == QAbstractSocket::UnconnectedState)
+            s->connectToHost(m_host, m_port);
+    }
+}
+
+void TcpLoadSender::send(int count)
+{
+    const int subsystems = m_payloads->subsystemCount();
+    for (int i = 0; i < count; ++i) {
+        const int sub = m_nextSubsystem;
+        m_nextSubsystem = (m_nextSubsystem + 1) % subsystems;
+
+        // Each virtual subsystem is pinned to one connection
+        QTcpSocket* s = m_sockets[sub % m_sockets.size()];
+        if (s->state() != QAbstractSocket::ConnectedState
+                || s->bytesToWrite() > kHighWaterBytes) {
+            ++m_deferred;
+            continue;
+        }
+
+        const QByteArray msg = m_payloads->next(sub);
+        if (m_lengthPrefixed) {
+            const quint32 len = static_cast<quint32>(msg.size());
+            const char prefix[4] = { char(len), char(len >> 8), char(len >> 16), char(len >> 24) };
+            s->write(prefix, 4);
+            s->write(msg);
+            m_bytes += 4 + msg.size();
+        } else {
+            s->write(msg);
+            s->write("\n", 1);
+            m_bytes += msg.size() + 1;
+        }
+        ++m_sent;
+    }
+}
+
+QString TcpLoadSender::details() const
+{
+    int up = 0;
+    qint64 backlog = 0;
+    for (QTcpSocket* s : m_sockets) {
+        if (s->state() == QAbstractSocket::ConnectedState) ++up;
+        backlog += s->bytesToWrite();
+    }
+    return QString("conn %1/%2  backlog %3 KB").arg(up).arg(m_sockets.size()).arg(backlog / 1024);
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  UDP (JSON)
+// ────────────────────────────────────────────────────────────────────────────
+
+UdpLoadSender::UdpLoadSender(const QString& host, quint16 port, HealthPayloadFactory* payloads,
+                             const LoadPacer& pacer, QObject* parent)
+    : LoadSender("udp", pacer, parent)
+    , m_addr(resolve(host))
+    , m_host(host)
+    , m_port(port)
+    , m_payloads(payloads)
+{}
+
+bool UdpLoadSender::start()
+{
+    if (m_addr.isNull()) {
+        QTextStream(stderr) << "udp: cannot parse host address " << m_host << "\n";
+        return false;
+    }
+    m_socket = new QUdpSocket(this);
+    m_socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, 4 * 1024 * 1024);
+    return true;
+}
+
+void UdpLoadSender::send(int count)
+{
+    const int subsystems = m_payloads->subsystemCount();
+    for (int i = 0; i < count; ++i) {
+        const QByteArray msg = m_payloads->next(m_nextSubsystem);
+        m_nextSubsystem = (m_nextSubsystem + 1) % subsystems;
+        if (m_socket->writeDatagram(msg, m_addr, m_port) < 0) {
+            ++m_errors;
+            continue;
+        }
+        ++m_sent;
+        m_bytes += msg.size();
+    }
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Antenna UDP (0x10 / 0x11 / 0x12)
+// ────────────────────────────────────────────────────────────────────────────
+
+AntennaLoadSender::AntennaLoadSender(const QString& host, quint16 port,
+                                     AntennaPayloadFactory* payloads,
+                                     const LoadPacer& pacer, QObject* parent)
+    : LoadSender("antenna", pacer, parent)
+    , m_addr(resolve(host))
+    , m_host(host)
+    , m_port(port)
+    , m_payloads(payloads)
+{}
+
+bool AntennaLoadSender::start()
+{
+    if (m_addr.isNull()) {
+        QTextStream(stderr) << "antenna: cannot parse host address " << m_host << "\n";
+        return false;
+    }
+    m_socket = new QUdpSocket(this);
+    m_socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, 4 * 1024 * 1024);
+    return true;
+}
+
+void AntennaLoadSender::send(int count)
+{
+    for (int i = 0; i < count; ++i) {
+        m_payloads->next(m_packet);
+        if (m_socket->writeDatagram(m_packet, m_addr, m_port) < 0) {
+            ++m_errors;
+            continue;
+        }
+        ++m_sent;
+        m_bytes += m_packet.size();
+    }
+}
+
+QString AntennaLoadSender::details() const
+{
+    return QString("0x10 %1  0x11 %2  0x12 %3")
+        .arg(m_payloads->produced(0x10))
+        .arg(m_payloads->produced(0x11))
+        .arg(m_payloads->produced(0x12));
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  Modbus-TCP slaves
+// ────────────────────────────────────────────────────────────────────────────
+
+ModbusLoadServer::ModbusLoadServer(quint16 firstPort, int units, int subsystemRegisters,
+                                   const LoadPacer& pacer, QObject* parent)
+    : LoadSender("modbus", pacer, parent)
+    , m_firstPort(firstPort)
+{
+    m_units.resize(qMax(1, units));
+    for (int i = 0; i < m_units.size(); ++i) {
+        m_units[i].fill(0, 3 + qMax(0, subsystemRegisters));
+        m_units[i][0] = quint16(i + 1);
+        refreshUnit(i);
+    }
+    m_refreshes = 0;
+}
+
+bool ModbusLoadServer::start()
+{
+    for (int p = 0; p < portCount(); ++p) {
+        QTcpServer* server = new QTcpServer(this);
+        const quint16 port = quint16(m_firstPort + p);
+        if (!server->listen(QHostAddress::Any, port)) {
+            QTextStream(stderr) << "modbus: cannot listen on port " << port << ": "
+                                << server->errorString() << "\n";
+            return false;
+        }
+        connect(server, &QTcpServer::newConnection, this, [this, server, p]() {
+            while (QTcpSocket* client = server->nextPendingConnection()) {
+                m_buffers.insert(client, QByteArray());
+                connect(client, &QTcpSocket::readyRead, this,
+                        [this, client, p]() { onReadyRead(client, p); });
+                connect(client, &QTcpSocket::disconnected, this, [this, client]() {
+                    m_buffers.remove(client);
+                    client->deleteLater();
+                });
+            }
+        });
+        m_servers.append(server);
+    }
+    return true;
+}
+
+void ModbusLoadServer::refreshUnit(int index)
+{
+    QVector<quint16>& regs = m_units[index];
+    int worst = 1000;
+    for (int r = 3; r < regs.size(); ++r) {
+        regs[r] = quint16(550 + (m_rng = m_rng * 1664525u + 1013904223u) % 451);
+        worst = qMin(worst, int(regs[r]));
+    }
+    const int health = regs.size() > 3 ? worst : int(550 + m_rng % 451);
+    regs[1] = quint16(health);
+    regs[2] = health >= 900 ? 0 : health >= 700 ? 1 : health >= 400 ? 2 : health >= 100 ? 3 : 4;
+    ++m_refreshes;
+}
+
+void ModbusLoadServer::send(int count)
+{
+    for (int i = 0; i < count; ++i) {
+        refreshUnit(m_nextUnit);
+        m_nextUnit = (m_nextUnit + 1) % m_units.size();
+    }
+}
+
+void ModbusLoadServer::onReadyRead(QTcpSocket* client, int portIndex)
+{
+    QByteArray& buf = m_buffers[client];
+    buf += client->readAll();
+
+    // MBAP header: transaction(2) protocol(2) length(2) unit(1), big-endian
+    int off = 0;
+    while (buf.size() - off >= 8) {
+        const uchar* h = reinterpret_cast<const uchar*>(buf.constData() + off);
+        const int length = (h[4] << 8) | h[5];
+        if (length < 2 || length > 260) {
+            ++m_errors;
+            client->abort();
+            return;
+        }
+        if (buf.size() - off < 6 + length) break;
+
+        const QByteArray pdu = respond(portIndex, h + 7, length - 1, h[6]);
+        QByteArray reply;
+        reply.reserve(7 + pdu.size());
+        reply.append(reinterpret_cast<const char*>(h), 4);          // transaction + protocol
+        reply.append(char((pdu.size() + 1) >> 8));
+        reply.append(char((pdu.size() + 1) & 0xFF));
+        reply.append(char(h[6]));
+        reply.append(pdu);
+        client->write(reply);
+
+        ++m_sent;
+        m_bytes += reply.size();
+        off += 6 + length;
+    }
+    buf.remove(0, off);
+}
+
+QByteArray ModbusLoadServer::respond(int portIndex, const uchar* pdu, int len, quint8 unit)
+{
+    const quint8 function = pdu[0];
+    auto exception = [function](quint8 code) {
+        QByteArray e;
+        e.append(char(function | 0x80));
+        e.append(char(code));
+        return e;
+    };
+
+    const int index = portIndex * kUnitsPerPort + int(unit) - 1;
+    if (unit < 1 || unit > kUnitsPerPort || index >= m_units.size())
+        return exception(0x0B);                  // gateway target failed to respond
+    if (function != 0x03 || len < 5)
+        return exception(0x01);                  // illegal function
+
+    const int start = (pdu[1] << 8) | pdu[2];
+    const int count = (pdu[3] << 8) | pdu[4];
+    const QVector<quint16>& regs = m_units[index];
+    if (count < 1 || count > 125 || start + count > regs.size())
+        return exception(0x02);                  // illegal data address
+
+    QByteArray out;
+    out.reserve(2 + count * 2);
+    out.append(char(0x03));
+    out.append(char(count * 2));
+    for (int r = start; r < start + count; ++r) {
+        out.append(char(regs[r] >> 8));
+        out.append(char(regs[r] & 0xFF));
+    }
+    return out;
+}
+
+QString ModbusLoadServer::details() const
+{
+    return QString("units %1 on ports %2-%3  clients %4  refreshes %5")
+        .arg(m_units.size())
+        .arg(m_firstPort)
+        .arg(m_firstPort + portCount() - 1)
+        .arg(m_buffers.size())
+        .arg(m_refreshes);
+}
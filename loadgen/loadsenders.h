@@ -0,0 +1,176 @@
+#ifndef LOADSENDERS_H
+#define LOADSENDERS_H
+
+#include <QObject>
+#include <QHostAddress>
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include "loadpacer.h"
+#include "payloadfactory.h"
+
+class QTcpSocket;
+class QTcpServer;
+class QUdpSocket;
+class QTimer;
+
+/**
+ * LoadSender – One traffic stream of the load generator.
+ *
+ * The driver calls pump(nowNs) every millisecond; the sender asks its
+ * LoadPacer how many messages are due and emits them. Counters are plain
+ * integers – everything runs on the main thread.
+ *
+ *   sent      messages handed to the socket
+ *   bytes     payload bytes handed to the socket
+ *   deferred  messages skipped because the peer could not keep up (TCP
+ *             send backlog above the high-water mark, no connection yet)
+ *   errors    socket errors (refused connections, failed datagram sends)
+ */
+class LoadSender : public QObject
+{
+    Q_OBJECT
+public:
+    LoadSender(const QString& name, const LoadPacer& pacer, QObject* parent = nullptr);
+
+    QString name() const { return m_name; }
+    virtual bool start() = 0;
+    void pump(qint64 nowNs);
+    virtual QString details() const { return QString(); }
+
+    quint64 sent() const { return m_sent; }
+    quint64 bytes() const { return m_bytes; }
+    quint64 deferred() const { return m_deferred; }
+    quint64 errors() const { return m_errors; }
+    LoadPacer& pacer() { return m_pacer; }
+
+protected:
+    virtual void send(int count) = 0;
+
+    QString   m_name;
+    LoadPacer m_pacer;
+    quint64   m_sent = 0;
+    quint64   m_bytes = 0;
+    quint64   m_deferred = 0;
+    quint64   m_errors = 0;
+};
+
+/**
+ * TcpLoadSender – N virtual subsystems multiplexed over C client
+ * connections to a TCP handler. Framing "line" appends '\n', "length"
+ * prefixes a u32 little-endian length (TcpProtocolHandler framing modes).
+ * Lost connections are re-established every second.
+ */
+class TcpLoadSender : public LoadSender
+{
+    Q_OBJECT
+public:
+    TcpLoadSender(const QString& host, quint16 port, int connections, bool lengthPrefixed,
+                  HealthPayloadFactory* payloads, const LoadPacer& pacer,
+                  QObject* parent = nullptr);
+
+    bool start() override;
+    QString details() const override;
+
+protected:
+    void send(int count) override;
+
+private:
+    void reconnect();
+
+    QString m_host;
+    quint16 m_port;
+    bool    m_lengthPrefixed;
+    HealthPayloadFactory* m_payloads;
+    QVector<QTcpSocket*>  m_sockets;
+    QTimer* m_reconnectTimer;
+    int     m_nextSubsystem = 0;
+    static const qint64 kHighWaterBytes = 8 * 1024 * 1024;
+};
+
+/** UdpLoadSender – N virtual subsystems, one JSON datagram per message. */
+class UdpLoadSender : public LoadSender
+{
+    Q_OBJECT
+public:
+    UdpLoadSender(const QString& host, quint16 port, HealthPayloadFactory* payloads,
+                  const LoadPacer& pacer, QObject* parent = nullptr);
+
+    bool start() override;
+
+protected:
+    void send(int count) override;
+
+private:
+    QHostAddress m_addr;
+    QString      m_host;
+    quint16      m_port;
+    HealthPayloadFactory* m_payloads;
+    QUdpSocket*  m_socket = nullptr;
+    int          m_nextSubsystem = 0;
+};
+
+/** AntennaLoadSender – 0x10/0x11/0x12 antenna packets to a UdpReceiver port. */
+class AntennaLoadSender : public LoadSender
+{
+    Q_OBJECT
+public:
+    AntennaLoadSender(const QString& host, quint16 port, AntennaPayloadFactory* payloads,
+                      const LoadPacer& pacer, QObject* parent = nullptr);
+
+    bool start() override;
+    QString details() const override;
+
+protected:
+    void send(int count) override;
+
+private:
+    QHostAddress m_addr;
+    QString      m_host;
+    quint16      m_port;
+    AntennaPayloadFactory* m_payloads;
+    QUdpSocket*  m_socket = nullptr;
+    QByteArray   m_packet;
+};
+
+/**
+ * ModbusLoadServer – Modbus-TCP slaves for ModbusProtocolHandler to poll.
+ *
+ * The app is the Modbus client, so the load here is served rather than
+ * pushed: N virtual units (unit IDs 1..247 per port, further units on the
+ * following ports) each hold the register layout ModbusProtocolHandler
+ * expects (1: health×10, 2: status code, 3..: subsystem health×10). The
+ * pacer sets how many unit register banks are refreshed per second;
+ * "sent" counts answered read requests (function 0x03).
+ */
+class ModbusLoadServer : public LoadSender
+{
+    Q_OBJECT
+public:
+    ModbusLoadServer(quint16 firstPort, int units, int subsystemRegisters,
+                     const LoadPacer& pacer, QObject* parent = nullptr);
+
+    bool start() override;
+    QString details() const override;
+    int  portCount() const { return (m_units.size() + kUnitsPerPort - 1) / kUnitsPerPort; }
+
+protected:
+    void send(int count) override;   // refreshes register banks
+
+private:
+    void onReadyRead(QTcpSocket* client, int portIndex);
+    QByteArray respond(int portIndex, const uchar* pdu, int len, quint8 unit);
+    void refreshUnit(int index);
+
+    static const int kUnitsPerPort = 247;
+
+    quint16 m_firstPort;
+    QList<QTcpServer*> m_servers;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+    QVector<QVector<quint16>> m_units;
+    int     m_nextUnit = 0;
+    quint32 m_rng = 99;
+    quint64 m_refreshes = 0;
+};
+
+#endif // LOADSENDERS_H
@@ -0,0 +1,219 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QTimer>
+#include <atomic>
+#include <csignal>
+#include "loadsenders.h"
+
+static std::atomic<bool> g_interrupted(false);
+
+static void onSignal(int)
+{
+    g_interrupted.store(true);
+}
+
+/*
+ * vajra_loadgen – headless load generator for the UnifiedApp ingest paths.
+ *
+ * Emulates thousands of virtual subsystems from one process:
+ *   --tcp N      JSON health messages to the TCP MessageServer (line or
+ *                length framing, multiplexed over --tcp-connections sockets)
+ *   --udp N      JSON health datagrams to the UDP MessageServer
+ *   --modbus N   Modbus-TCP slave units for ModbusProtocolHandler to poll
+ *   --antenna-rate R   0x10/0x11/0x12 packets to a radar antenna UdpReceiver
+ *
+ * --rate is per virtual subsystem; the stream rate is rate × N. Every
+ * --report-ms a line per stream shows the achieved send rate next to the
+ * target, and a summary is printed on exit (--duration or Ctrl+C).
+ */
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("vajra_loadgen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Multi-protocol load generator for UnifiedApp");
+    parser.addHelpOption();
+
+    auto opt = [&parser](const QString& name, const QString& help,
+                         const QString& value, const QString& def) {
+        parser.addOption(QCommandLineOption(name, help, value, def));
+    };
+    opt("host",              "Target host.",                                   "addr",  "127.0.0.1");
+    opt("rate",              "Messages/s per virtual subsystem.",              "n",     "1");
+    opt("mix",               "Health payload mix, e.g. basic:50,trm_data:10.", "mix",   "basic:60,subsystem_health:25,trm_data:5,apcu_telemetry:10");
+    opt("trm-count",         "TRM entries per trm_data message.",              "n",     "271");
+    opt("id-prefix",         "Virtual subsystem id prefix.",                   "text",  "load_");
+    opt("tcp",               "Virtual subsystems over TCP.",                   "n",     "0");
+    opt("tcp-port",          "TCP MessageServer port.",                        "port",  "12345");
+    opt("tcp-connections",   "TCP client connections to spread them over.",    "n",     "8");
+    opt("tcp-framing",       "TCP framing: line or length.",                   "mode",  "line");
+    opt("udp",               "Virtual subsystems over UDP.",                   "n",     "0");
+    opt("udp-port",          "UDP MessageServer port.",                        "port",  "12346");
+    opt("modbus",            "Modbus-TCP slave units to serve.",               "n",     "0");
+    opt("modbus-port",       "First Modbus-TCP listen port (247 units each).", "port",  "1502");
+    opt("modbus-subsystems", "Subsystem health registers per unit.",           "n",     "4");
+    opt("antenna-rate",      "Antenna packets/s (0 disables).",                "n",     "0");
+    opt("antenna-port",      "Antenna UdpReceiver port.",                      "port",  "5005");
+    opt("antenna-mix",       "Antenna packet mix, e.g. 0x10:80,0x11:15,0x12:5.", "mix", "0x10:80,0x11:15,0x12:5");
+    opt("antenna-quadrants", "Antenna quadrants.",                             "n",     "4");
+    opt("antenna-epq",       "Antenna elements per quadrant.",                 "n",     "256");
+    opt("pattern",           "Rate pattern: steady, burst or ramp.",           "shape", "steady");
+    opt("burst-on-ms",       "Burst pattern: sending window.",                 "ms",    "200");
+    opt("burst-off-ms",      "Burst pattern: quiet window.",                   "ms",    "800");
+    opt("ramp-secs",         "Ramp pattern: seconds to reach full rate.",      "s",     "30");
+    opt("duration",          "Stop after this many seconds (0 = until Ctrl+C).", "s",   "0");
+    opt("report-ms",         "Report interval.",                               "ms",    "1000");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    auto fail = [&err](const QString& msg) {
+        err << "vajra_loadgen: " << msg << "\n";
+        return 2;
+    };
+
+    LoadPattern pattern;
+    if (!LoadPattern::parseShape(parser.value("pattern"), pattern.shape))
+        return fail(QString("unknown pattern '%1'").arg(parser.value("pattern")));
+    pattern.burstOnMs  = parser.value("burst-on-ms").toInt();
+    pattern.burstOffMs = parser.value("burst-off-ms").toInt();
+    pattern.rampSecs   = parser.value("ramp-secs").toInt();
+
+    const QString host = parser.value("host");
+    const double rate  = parser.value("rate").toDouble();
+    const int tcpCount = parser.value("tcp").toInt();
+    const int udpCount = parser.value("udp").toInt();
+    const int modbusCount = parser.value("modbus").toInt();
+    const double antennaRate = parser.value("antenna-rate").toDouble();
+
+    const QString framing = parser.value("tcp-framing");
+    if (framing != "line" && framing != "length")
+        return fail(QString("unknown tcp framing '%1'").arg(framing));
+
+    QString error;
+    QList<LoadSender*> senders;
+
+    HealthPayloadFactory tcpPayloads(parser.value("id-prefix") + "tcp_", tcpCount,
+                                     parser.value("trm-count").toInt());
+    HealthPayloadFactory udpPayloads(parser.value("id-prefix") + "udp_", udpCount,
+                                     parser.value("trm-count").toInt());
+    if (!tcpPayloads.setMix(parser.value("mix"), &error) || !udpPayloads.setMix(parser.value("mix"), &error))
+        return fail(error);
+
+    AntennaPayloadFactory antennaPayloads(parser.value("antenna-quadrants").toInt(),
+                                          parser.value("antenna-epq").toInt());
+    if (!antennaPayloads.setMix(parser.value("antenna-mix"), &error))
+        return fail(error);
+
+    if (tcpCount > 0) {
+        senders.append(new TcpLoadSender(host, quint16(parser.value("tcp-port").toUInt()),
+                                         parser.value("tcp-connections").toInt(),
+                                         framing == "length", &tcpPayloads,
+                                         LoadPacer(rate * tcpCount, pattern), &app));
+    }
+    if (udpCount > 0) {
+        senders.append(new UdpLoadSender(host, quint16(parser.value("udp-port").toUInt()),
+                                         &udpPayloads, LoadPacer(rate * udpCount, pattern), &app));
+    }
+    if (modbusCount > 0) {
+        senders.append(new ModbusLoadServer(quint16(parser.value("modbus-port").toUInt()),
+                                            modbusCount, parser.value("modbus-subsystems").toInt(),
+                                            LoadPacer(rate * modbusCount, pattern), &app));
+    }
+    if (antennaRate > 0) {
+        senders.append(new AntennaLoadSender(host, quint16(parser.value("antenna-port").toUInt()),
+                                             &antennaPayloads, LoadPacer(antennaRate, pattern), &app));
+    }
+    if (senders.isEmpty())
+        return fail("nothing to do – give at least one of --tcp, --udp, --modbus, --antenna-rate");
+
+    for (LoadSender* s : senders) {
+        if (!s->start()) return fail(QString("%1 sender failed to start").arg(s->name()));
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    QElapsedTimer clock;
+    clock.start();
+    for (LoadSender* s : senders) s->pacer().start(clock.nsecsElapsed());
+
+    // 1 ms driver: every sender takes whatever its pacer says is due
+    QTimer driver;
+    driver.setTimerType(Qt::PreciseTimer);
+    driver.setInterval(1);
+    QObject::connect(&driver, &QTimer::timeout, [&]() {
+        const qint64 now = clock.nsecsElapsed();
+        for (LoadSender* s : senders) s->pump(now);
+    });
+
+    // Periodic report: achieved vs. target rate per stream
+    struct Prev { quint64 sent = 0; quint64 bytes = 0; };
+    QVector<Prev> prev(senders.size());
+    qint64 lastReportNs = 0;
+    auto report = [&]() {
+        const qint64 now = clock.nsecsElapsed();
+        const double dt = qMax<qint64>(1, now - lastReportNs) / 1e9;
+        lastReportNs = now;
+        for (int i = 0; i < senders.size(); ++i) {
+            LoadSender* s = senders[i];
+            const double msgRate = (s->sent() - prev[i].sent) / dt;
+            const double mbRate  = (s->bytes() - prev[i].bytes) / dt / (1024.0 * 1024.0);
+            prev[i].sent = s->sent();
+            prev[i].bytes = s->bytes();
+            out << QString("[%1s] %2 %3 msg/s (target %4)  %5 MB/s  total %6  deferred %7  errors %8  %9\n")
+                       .arg(now / 1e9, 6, 'f', 1)
+                       .arg(s->name(), -8)
+                       .arg(msgRate, 10, 'f', 0)
+                       .arg(s->pacer().targetRate(now), 0, 'f', 0)
+                       .arg(mbRate, 0, 'f', 2)
+                       .arg(s->sent())
+                       .arg(s->deferred())
+                       .arg(s->errors())
+                       .arg(s->details());
+        }
+        out.flush();
+    };
+
+    QTimer reporter;
+    reporter.setInterval(qMax(100, parser.value("report-ms").toInt()));
+    QObject::connect(&reporter, &QTimer::timeout, report);
+
+    const qint64 durationNs = qint64(parser.value("duration").toDouble() * 1e9);
+    QTimer watchdog;
+    watchdog.setInterval(50);
+    QObject::connect(&watchdog, &QTimer::timeout, [&]() {
+        if (g_interrupted.load() || (durationNs > 0 && clock.nsecsElapsed() >= durationNs))
+            app.quit();
+    });
+
+    driver.start();
+    reporter.start();
+    watchdog.start();
+    app.exec();
+
+    const double elapsed = clock.nsecsElapsed() / 1e9;
+    out << QString("\nSummary after %1 s\n").arg(elapsed, 0, 'f', 1);
+    for (LoadSender* s : senders) {
+        out << QString("  %1 sent %2 (%3 msg/s avg, %4 MB)  deferred %5  errors %6\n")
+                   .arg(s->name(), -8)
+                   .arg(s->sent())
+                   .arg(s->sent() / qMax(1e-9, elapsed), 0, 'f', 0)
+                   .arg(s->bytes() / (1024.0 * 1024.0), 0, 'f', 1)
+                   .arg(s->deferred())
+                   .arg(s->errors());
+    }
+    if (tcpCount > 0 || udpCount > 0) {
+        out << "  payload mix:";
+        for (int k = 0; k < HealthPayloadFactory::KindCount; ++k) {
+            const auto kind = HealthPayloadFactory::Kind(k);
+            const quint64 n = tcpPayloads.produced(kind) + udpPayloads.produced(kind);
+            if (n) out << " " << HealthPayloadFactory::kindName(kind) << "=" << n;
+        }
+        out << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+#include "payloadfactory.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QStringList>
+#include <QPair>
+#include <algorithm>
+
+namespace {
+
+const int kVariants = 8;
+const int kWheelSize = 100;
+
+const char* const kSubsystems[] = {
+    "APCU Controller", "Temperature Monitoring", "Board Data", "Board Status",
+    "Quadrant 0 (CB)", "Quadrant 1 (CF)", "Quadrant 2 (CD)", "Quadrant 3 (CE)",
+    "QTRMs", "AQC"
+};
+
+const char* colorFor(double h)
+{
+    if (h >= 90) return "#00FF00";
+    if (h >= 70) return "#FFFF00";
+    if (h >= 40) return "#FFA500";
+    if (h >= 10) return "#FF0000";
+    return "#808080";
+}
+
+const char* statusFor(double h)
+{
+    if (h >= 90) return "HEALTHY";
+    if (h >= 70) return "WARNING";
+    if (h >= 40) return "DEGRADED";
+    if (h >= 10) return "CRITICAL";
+    return "OFFLINE";
+}
+
+quint32 step(quint32& s) { s = s * 1664525u + 1013904223u; return s >> 8; }
+double unit(quint32& s) { return step(s) / double(1 << 24); }
+double range(quint32& s, double lo, double hi) { return lo + (hi - lo) * unit(s); }
+double round1(double v) { return qRound(v * 10.0) / 10.0; }
+
+QByteArray compact(const QJsonObject& o) { return QJsonDocument(o).toJson(QJsonDocument::Compact); }
+QByteArray compact(const QJsonArray& a)  { return QJsonDocument(a).toJson(QJsonDocument::Compact); }
+
+/**
+ * "a:3,b:1" → weighted wheel of kWheelSize entries, interleaved so a short
+ * window already has roughly the right proportions.
+ */
+template <typename T, typename Lookup>
+bool buildWheel(const QString& mix, Lookup lookup, QVector<T>& wheel, QString* error)
+{
+    QList<QPair<T, int>> parts;
+    int total = 0;
+    for (const QString& item : mix.split(',', Qt::SkipEmptyParts)) {
+        const QStringList kv = item.trimmed().split(':');
+        T kind;
+        if (!lookup(kv.value(0).trimmed(), kind)) {
+            if (error) *error = QString("unknown payload kind '%1'").arg(kv.value(0));
+            return false;
+        }
+        const int weight = kv.size() > 1 ? kv[1].toInt() : 1;
+        if (weight <= 0) continue;
+        parts.append(qMakePair(kind, weight));
+        total += weight;
+    }
+    if (total == 0) {
+        if (error) *error = QString("empty payload mix '%1'").arg(mix);
+        return false;
+    }
+
+    // Deal slots proportionally: each slot goes to the kind furthest behind its share
+    wheel.clear();
+    QVector<int> dealt(parts.size(), 0);
+    for (int slot = 0; slot < kWheelSize; ++slot) {
+        int best = 0;
+        double bestDeficit = -1e9;
+        for (int i = 0; i < parts.size(); ++i) {
+            double deficit = double(parts[i].second) * (slot + 1) / total - dealt[i];
+            if (deficit > bestDeficit) { bestDeficit = deficit; best = i; }
+        }
+        ++dealt[best];
+        wheel.append(parts[best].first);
+    }
+    return true;
+}
+
+} // namespace
+
+// ────────────────────────────────────────────────────────────────────────────
+//  HealthPayloadFactory
+// ────────────────────────────────────────────────────────────────────────────
+
+HealthPayloadFactory::HealthPayloadFactory(const QString& idPrefix, int subsystems, int trmCount)
+{
+    for (int i = 0; i < qMax(1, subsystems); ++i)
+        m_ids.append(QString("%1%2").arg(idPrefix).arg(i + 1).toUtf8());
+
+    quint32 rng = 4242;
+    for (int v = 0; v < kVariants; ++v) {
+        QJsonObject sub;
+        for (const char* n : kSubsystems) sub[n] = round1(range(rng, 60, 100));
+        m_subsystemBodies.append(compact(sub));
+
+        QJsonArray trms;
+        for (int i = 0; i < trmCount; ++i) {
+            const double h = round1(range(rng, 30, 100));
+            QJsonObject t;
+            t["id"] = i;
+            t["quadrant"] = i % 4;
+            t["channel"] = i / 4 % 64;
+            t["health"] = h;
+            t["color"] = colorFor(h);
+            t["status"] = statusFor(h);
+            t["on"] = unit(rng) > 0.02;
+            t["trip"] = unit(rng) > 0.01 ? "Normal" : "Tripped";
+            t["bit"] = unit(rng) > 0.01 ? "Normal" : "Fault";
+            t["voltage"] = qRound(range(rng, 27.0, 29.0) * 100) / 100.0;
+            t["current"] = qRound(range(rng, 1.2, 1.9) * 1000) / 1000.0;
+            trms.append(t);
+        }
+        m_trmBodies.append(compact(trms));
+
+        QJsonObject temp;
+        temp["sensor_a"] = round1(range(rng, 35, 60));
+        temp["sensor_b"] = round1(range(rng, 35, 60));
+        temp["sensor_c"] = round1(range(rng, 35, 60));
+        temp["status"] = "Normal";
+        QJsonObject links;
+        for (int q = 0; q < 4; ++q) links[QString("Q%1").arg(q)] = unit(rng) > 0.05;
+        QJsonObject tel;
+        tel["version"] = "1.0.0";
+        tel["unit"] = "APCU (load generator)";
+        tel["link_status"] = links;
+        tel["sequence_on"] = true;
+        tel["array_voltage"] = round1(range(rng, 27, 29));
+        tel["array_current"] = round1(range(rng, 300, 400));
+        tel["temperature"] = temp;
+        m_telemetryBodies.append(compact(tel));
+    }
+
+    setMix("basic");
+}
+
+const char* HealthPayloadFactory::kindName(Kind k)
+{
+    switch (k) {
+    case Basic:           return "basic";
+    case Subsystem:       return "subsystem";
+    case SubsystemHealth: return "subsystem_health";
+    case TrmData:         return "trm_data";
+    case ApcuTelemetry:   return "apcu_telemetry";
+    case KindCount:       break;
+    }
+    return "?";
+}
+
+bool HealthPayloadFactory::setMix(const QString& mix, QString* error)
+{
+    QVector<Kind> wheel;
+    auto lookup = [](const QString& name, Kind& k) {
+        for (int i = 0; i < KindCount; ++i) {
+            if (name == QLatin1String(kindName(Kind(i)))) { k = Kind(i); return true; }
+        }
+        return false;
+    };
+    if (!buildWheel(mix, lookup, wheel, error)) return false;
+    m_wheel = wheel;
+    m_wheelPos = 0;
+    return true;
+}
+
+double HealthPayloadFactory::health()
+{
+    return round1(range(m_rng, 55, 100));
+}
+
+QByteArray HealthPayloadFactory::next(int index)
+{
+    const Kind kind = m_wheel[m_wheelPos];
+    m_wheelPos = (m_wheelPos + 1) % m_wheel.size();
+    const int variant = static_cast<int>(m_counter++ % kVariants);
+    ++m_produced[kind];
+
+    const QByteArray& id = m_ids[index % m_ids.size()];
+    const double h = health();
+
+    QByteArray msg;
+    msg.reserve(kind == TrmData ? m_trmBodies[variant].size() + 128 : 384);
+    msg += "{\"component_id\":\"";
+    msg += id;
+    msg += '"';
+
+    if (kind == ApcuTelemetry) {
+        msg += ",\"apcu_telemetry\":";
+        msg += m_telemetryBodies[variant];
+        msg += '}';
+        return msg;
+    }
+
+    if (kind == Subsystem) {
+        msg += ",\"subsystem\":\"";
+        msg += kSubsystems[variant % (sizeof(kSubsystems) / sizeof(kSubsystems[0]))];
+        msg += '"';
+    }
+    msg += ",\"color\":\"";
+    msg += colorFor(h);
+    msg += "\",\"size\":";
+    msg += QByteArray::number(h, 'f', 1);
+
+    if (kind == SubsystemHealth) {
+        msg += ",\"subsystem_health\":";
+        msg += m_subsystemBodies[variant];
+    } else if (kind == TrmData) {
+        msg += ",\"trm_data\":";
+        msg += m_trmBodies[variant];
+    }
+    msg += '}';
+    return msg;
+}
+
+// ────────────────────────────────────────────────────────────────────────────
+//  AntennaPayloadFactory
+// ────────────────────────────────────────────────────────────────────────────
+
+AntennaPayloadFactory::AntennaPayloadFactory(int quadrants, int elementsPerQuadrant)
+    : m_quadrants(qBound(1, quadrants, 255))
+    , m_epq(qBound(1, elementsPerQuadrant, 65535))
+{
+    for (int v = 0; v < kVariants; ++v) {
+        for (int q = 0; q < m_quadrants; ++q) {
+            QByteArray pkt(2 + m_epq * 6, '\0');
+            uchar* p = reinterpret_cast<uchar*>(pkt.data());
+            p[0] = 0x11;
+            p[1] = uchar(q);
+            for (int i = 0; i < m_epq; ++i) element(p + 2 + i * 6);
+            m_quadrantPackets.append(pkt);
+        }
+        QByteArray snap(1 + m_quadrants * m_epq * 6, '\0');
+        uchar* p = reinterpret_cast<uchar*>(snap.data());
+        p[0] = 0x12;
+        for (int i = 0; i < m_quadrants * m_epq; ++i) element(p + 1 + i * 6);
+        m_snapshotPackets.append(snap);
+    }
+    setMix("0x10");
+}
+
+quint16 AntennaPayloadFactory::rnd16(quint16 lo, quint16 hi)
+{
+    return quint16(lo + step(m_rng) % quint32(hi - lo + 1));
+}
+
+void AntennaPayloadFactory::element(uchar* p)
+{
+    // Same scaling as UdpReceiver: (dBm+10)*100, temp*10, amps*1000
+    const quint16 pwr = rnd16(2500, 4000);   // 15 .. 30 dBm
+    const quint16 tmp = rnd16(350, 700);     // 35 .. 70 °C
+    const quint16 cur = rnd16(1200, 2200);   // 1.2 .. 2.2 A
+    p[0] = uchar(pwr); p[1] = uchar(pwr >> 8);
+    p[2] = uchar(tmp); p[3] = uchar(tmp >> 8);
+    p[4] = uchar(cur); p[5] = uchar(cur >> 8);
+}
+
+bool AntennaPayloadFactory::setMix(const QString& mix, QString* error)
+{
+    QVector<int> wheel;
+    auto lookup = [](const QString& name, int& type) {
+        bool ok = false;
+        type = name.toInt(&ok, 0);
+        return ok && type >= 0x10 && type <= 0x12;
+    };
+    if (!buildWheel(mix, lookup, wheel, error)) return false;
+    m_wheel = wheel;
+    m_wheelPos = 0;
+    return true;
+}
+
+void AntennaPayloadFactory::next(QByteArray& out)
+{
+    const int type = m_wheel[m_wheelPos];
+    m_wheelPos = (m_wheelPos + 1) % m_wheel.size();
+    ++m_produced[type & 0x03];
+
+    if (type == 0x10) {
+        out.resize(10);
+        uchar* p = reinterpret_cast<uchar*>(out.data());
+        const quint16 elem = rnd16(0, quint16(m_epq - 1));
+        p[0] = 0x10;
+        p[1] = uchar(step(m_rng) % m_quadrants);
+        p[2] = uchar(elem);
+        p[3] = uchar(elem >> 8);
+        element(p + 4);
+    } else if (type == 0x11) {
+        out = m_quadrantPackets[step(m_rng) % m_quadrantPackets.size()];
+    } else {
+        out = m_snapshotPackets[step(m_rng) % m_snapshotPackets.size()];
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef PAYLOADFACTORY_H
+#define PAYLOADFACTORY_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * HealthPayloadFactory – Builds JSON health messages in the shapes the
+ * MessageServer accepts, for a set of virtual subsystems.
+ *
+ * Kinds (selected per message from a weighted mix, e.g.
+ * "basic:50,subsystem_health:30,trm_data:10,apcu_telemetry:10"):
+ *   basic             { component_id, color, size }
+ *   subsystem         { component_id, subsystem, color, size }
+ *   subsystem_health  { ..., subsystem_health: { 10 names } }
+ *   trm_data          { ..., trm_data: [ trmCount TRM objects ] }
+ *   apcu_telemetry    { component_id, apcu_telemetry: { ... } }
+ *
+ * The large bodies (subsystem map, TRM array, telemetry) are generated once
+ * in a handful of variants and spliced behind a per-message header, so a
+ * 271-TRM message costs a memcpy rather than a JSON serialisation and the
+ * generator is not the bottleneck.
+ */
+class HealthPayloadFactory
+{
+public:
+    enum Kind { Basic, Subsystem, SubsystemHealth, TrmData, ApcuTelemetry, KindCount };
+
+    HealthPayloadFactory(const QString& idPrefix, int subsystems, int trmCount);
+
+    /** Parse a "kind:weight,..." mix; returns false on an unknown kind. */
+    bool setMix(const QString& mix, QString* error = nullptr);
+    static const char* kindName(Kind k);
+
+    int subsystemCount() const { return m_ids.size(); }
+
+    /** Next message for virtual subsystem @p index (no trailing newline). */
+    QByteArray next(int index);
+
+    quint64 produced(Kind k) const { return m_produced[k]; }
+
+private:
+    double health();
+
+    QVector<QByteArray> m_ids;            // JSON-escaped component ids
+    QVector<Kind>       m_wheel;          // 100-slot weighted schedule
+    int                 m_wheelPos = 0;
+    QVector<QByteArray> m_subsystemBodies;
+    QVector<QByteArray> m_trmBodies;
+    QVector<QByteArray> m_telemetryBodies;
+    quint32             m_rng = 12345;
+    quint64             m_counter = 0;
+    quint64             m_produced[KindCount] = {};
+};
+
+/**
+ * AntennaPayloadFactory – Antenna UDP packets (see UnifiedApp/UdpReceiver.h):
+ *   0x10 single element (10 bytes), 0x11 full quadrant, 0x12 all quadrants.
+ * Mix syntax: "0x10:80,0x11:15,0x12:5".
+ */
+class AntennaPayloadFactory
+{
+public:
+    AntennaPayloadFactory(int quadrants, int elementsPerQuadrant);
+
+    bool setMix(const QString& mix, QString* error = nullptr);
+
+    /** Build the next packet into @p out (reused buffer). */
+    void next(QByteArray& out);
+
+    quint64 produced(int type) const { return m_produced[type & 0x03]; }
+
+private:
+    quint16 rnd16(quint16 lo, quint16 hi);
+    void element(uchar* p);
+
+    int   m_quadrants;
+    int   m_epq;
+    QVector<int> m_wheel;                 // packet types 0x10..0x12
+    int   m_wheelPos = 0;
+    QVector<QByteArray> m_quadrantPackets;
+    QVector<QByteArray> m_snapshotPackets;
+    quint32 m_rng = 777;
+    quint64 m_produced[3] = {};
+};
+
+#endif // PAYLOADFACTORY_H